@@ -1,4 +1,5 @@
 #include "builder.h"
+#include "../utils/archive_packer.h"
 
 #include <chrono>
 #include <ctime>
@@ -27,6 +28,8 @@ namespace snuffbox
 			MainWindow(parent),
 			status_(BuildStatus::kStopped),
 			build_thread_(this),
+			synced_(false),
+			repack_(true),
 			compiled_(0),
 			is_valid_(false),
 			to_compile_(0)
@@ -164,7 +167,16 @@ namespace snuffbox
 			button_start->Disable();
 			button_stop->Enable();
 
-			Sync();
+			if (synced_ == true)
+			{
+				Enqueue();
+				synced_ = false;
+			}
+			else
+			{
+				Sync();
+			}
+
 			build_thread_.Run();
 
 			SetStatusText("Build started..");
@@ -182,6 +194,15 @@ namespace snuffbox
 			build_thread_.Stop();
 			FinaliseBuild();
 
+			if (is_valid_ == true)
+			{
+				ArchivePacker::Remove(GetPath(DirectoryType::kBuild).ToStdString());
+			}
+
+			repack_ = true;
+			watch_.Stop();
+			synced_ = false;
+
 			SetStatusText("Stopped build");
 		}
 
@@ -192,24 +213,69 @@ namespace snuffbox
 
 			if (build_thread_.building_ == false)
 			{
+				ArchivePacker::Remove(GetPath(DirectoryType::kBuild).ToStdString());
+				repack_ = true;
+
 				wxCommandEvent evt(BUILDER_REBUILD);
 				evt.SetInt(1);
 				wxPostEvent(this, evt);
 				return;
 			}
 
+			if (changed_at_ != std::chrono::high_resolution_clock::time_point())
+			{
+				std::chrono::duration<double, std::milli> elapsed = std::chrono::high_resolution_clock::now() - changed_at_;
+				Log("Rebuilt changes " + std::to_string(elapsed.count()) + " ms after they were detected");
+
+				changed_at_ = std::chrono::high_resolution_clock::time_point();
+			}
+
+			bool pack = repack_;
+			repack_ = false;
+
 			idle_thread_ = std::thread([=]()
 			{
-				int count = 0;
-				while (status_ == BuildStatus::kIdle && count == 0)
+				if (pack == true)
 				{
-					count = Sync();
+					PackArchive();
+				}
+
+				std::string src_path = GetPath(DirectoryType::kSource).ToStdString();
+				bool watching = watch_.is_active();
+
+				std::vector<SourceWatch::Change> changes;
 
-					std::this_thread::sleep_for(std::chrono::milliseconds(IDLE_SLEEP_));
+				unsigned int count = 0;
+				while (status_ == BuildStatus::kIdle && count == 0)
+				{
+					if (watching == false)
+					{
+						watching = watch_.Start(src_path);
+						count = Sync();
+
+						if (watching == false)
+						{
+							std::this_thread::sleep_for(std::chrono::milliseconds(IDLE_SLEEP_));
+						}
+
+						continue;
+					}
+
+					if (watch_.Wait(IDLE_SLEEP_, &changes) == false)
+					{
+						watching = false;
+					}
+					else if (changes.empty() == false)
+					{
+						count = Sync(changes);
+					}
 				}
 
 				if (count > 0)
 				{
+					synced_ = true;
+					changed_at_ = std::chrono::high_resolution_clock::now();
+
 					wxCommandEvent evt(BUILDER_REBUILD);
 					evt.SetInt(0);
 					wxPostEvent(this, evt);
@@ -227,6 +293,28 @@ namespace snuffbox
 			compiled_ = graph_.Sync(src_path, build_path);
 			progress_mutex_.unlock();
 
+			return Enqueue();
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		unsigned int Builder::Sync(const std::vector<SourceWatch::Change>& changes)
+		{
+			std::string src_path = GetPath(DirectoryType::kSource).ToStdString();
+			std::string build_path = GetPath(DirectoryType::kBuild).ToStdString();
+
+			progress_mutex_.lock();
+			compiled_ = graph_.Apply(changes, src_path, build_path);
+			progress_mutex_.unlock();
+
+			return Enqueue();
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		unsigned int Builder::Enqueue()
+		{
+			std::string src_path = GetPath(DirectoryType::kSource).ToStdString();
+			std::string build_path = GetPath(DirectoryType::kBuild).ToStdString();
+
 			BuildGraph::CompileData c;
 
 			if (status_ == BuildStatus::kBuilding)
@@ -406,14 +494,66 @@ namespace snuffbox
 		//-----------------------------------------------------------------------------------------------
 		void Builder::OnCompiled(const std::string& src)
 		{
-			std::string relative = src.c_str() + GetPath(DirectoryType::kSource).size() + 1;
+			std::string src_path = GetPath(DirectoryType::kSource).ToStdString();
+			std::string relative = src.c_str() + src_path.size() + 1;
 			std::string bin = GetPath(DirectoryType::kBuild).ToStdString();
 
-			graph_.OnCompiled(relative, bin);
+			graph_.OnCompiled(relative, src_path, bin);
 
 			ProgressBy(1);
 		}
 
+		//-----------------------------------------------------------------------------------------------
+		void Builder::OnFileStarted(int worker, const std::string& path)
+		{
+			Log(std::to_string(worker + 1) + "> " + path);
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void Builder::OnFileCompiled(int worker, const std::string& path, const BuildReport::Job& job)
+		{
+			std::string sizes;
+
+			if (job.spirv_size > 0 && job.optimised_size != job.spirv_size)
+			{
+				sizes = " (" + std::to_string(job.spirv_size) + " -> " + std::to_string(job.optimised_size) + " bytes)";
+			}
+
+			Log(std::to_string(worker + 1) + "> -- Compiled " + path + sizes);
+			OnCompiled(path);
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void Builder::OnFileFailed(int worker, const std::string& path, const std::string& error)
+		{
+			Log(std::to_string(worker + 1) + "> -- [ERROR] " + path + ": " + error.c_str());
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void Builder::OnBuildFinished(unsigned int num_compiled, bool succeeded, const BuildReport& report)
+		{
+			Log(succeeded == true ? 
+				"Done compiling " + std::to_string(num_compiled) + " file(s)" : "Error occurred, aborting",
+				true,
+				succeeded == false);
+
+			if (num_compiled > 0)
+			{
+				repack_ = true;
+
+				std::vector<std::string> summary = report.Summary();
+
+				for (size_t i = 0; i < summary.size(); ++i)
+				{
+					Log(summary.at(i));
+				}
+
+				report.WriteTrace(GetPath(DirectoryType::kBuild).ToStdString() + '/' + BuildReport::TRACE_NAME);
+			}
+
+			SwitchStatus(BuildStatus::kIdle);
+		}
+
 		//-----------------------------------------------------------------------------------------------
 		void Builder::SaveGraph()
 		{
@@ -423,6 +563,39 @@ namespace snuffbox
 			}
 		}
 
+		//-----------------------------------------------------------------------------------------------
+		void Builder::PackArchive()
+		{
+			if (is_valid_ == false)
+			{
+				return;
+			}
+
+			std::vector<std::string> paths;
+
+			for (size_t i = 0; i < graph_.data_.size(); ++i)
+			{
+				const BuildGraph::BuildData& data = graph_.data_.at(i);
+
+				if (data.was_build == true)
+				{
+					paths.push_back(data.path);
+				}
+			}
+
+			std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+			std::string error;
+			if (ArchivePacker::Pack(GetPath(DirectoryType::kBuild).ToStdString(), paths, &error) == false)
+			{
+				Log("Could not pack the content archive: " + error, false, true);
+				return;
+			}
+
+			std::chrono::duration<double, std::milli> elapsed = std::chrono::high_resolution_clock::now() - start;
+			Log("Packed " + std::to_string(paths.size()) + " file(s) into '" + ArchivePacker::ARCHIVE_NAME + "' in " + std::to_string(elapsed.count()) + " ms");
+		}
+
 		//-----------------------------------------------------------------------------------------------
 		void Builder::JoinIdle()
 		{
@@ -4,6 +4,8 @@
 #include "../threads/build_thread.h"
 #include "../utils/build_graph.h"
 
+#include <chrono>
+
 namespace snuffbox
 {
 	namespace builder
@@ -11,11 +13,11 @@ namespace snuffbox
 		class BuilderApp;
 
 		/**
-		* @class snuffbox::builder::Builder : public snuffbox::MainWindow
+		* @class snuffbox::builder::Builder : public snuffbox::MainWindow, public snuffbox::builder::BuildListener
 		* @brief The main builder window that logs its status and in which you can specify the settings
 		* @author Daniel Konings
 		*/
-		class Builder : public MainWindow
+		class Builder : public MainWindow, public BuildListener
 		{
 
 			friend class BuilderApp;
@@ -94,6 +96,8 @@ namespace snuffbox
 
 			/**
 			* @brief Stop building but keep running
+			* @remarks While idle the source directory is watched for changes, or polled every 'IDLE_SLEEP_' milliseconds if it can't be watched.
+			* The content archive is packed on the idle thread first, but only if files were compiled since it was last packed
 			*/
 			void Idle();
 
@@ -103,6 +107,19 @@ namespace snuffbox
 			*/
 			unsigned int Sync();
 
+			/**
+			* @brief Synchronises the build graph with the changes collected by the source watch, without relisting any directories
+			* @param[in] changes (const std::vector<snuffbox::builder::SourceWatch::Change>&) The changed files
+			* @return (unsigned int) The number of unbuild items
+			*/
+			unsigned int Sync(const std::vector<SourceWatch::Change>& changes);
+
+			/**
+			* @brief Queues every unbuild item of the build graph if building, and updates the progress
+			* @return (unsigned int) The number of unbuild items
+			*/
+			unsigned int Enqueue();
+
 			/**
 			* @brief Rebuild when changes are detected
 			* @param[in] evt (const wxCommandEvent&) The event sent by wxWidgets
@@ -177,11 +194,37 @@ namespace snuffbox
 			*/
 			void OnCompiled(const std::string& src);
 
+			/**
+			* @see snuffbox::builder::BuildListener::OnFileStarted
+			*/
+			void OnFileStarted(int worker, const std::string& path) override;
+
+			/**
+			* @see snuffbox::builder::BuildListener::OnFileCompiled
+			*/
+			void OnFileCompiled(int worker, const std::string& path, const BuildReport::Job& job) override;
+
+			/**
+			* @see snuffbox::builder::BuildListener::OnFileFailed
+			*/
+			void OnFileFailed(int worker, const std::string& path, const std::string& error) override;
+
+			/**
+			* @see snuffbox::builder::BuildListener::OnBuildFinished
+			*/
+			void OnBuildFinished(unsigned int num_compiled, bool succeeded, const BuildReport& report) override;
+
 			/**
 			* @brief Saves the graph
 			*/
 			void SaveGraph();
 
+			/**
+			* @brief Packs every compiled file into the content archive of the build directory
+			* @remarks This should only be called after a build has finished without errors, from the idle thread so that the interface stays responsive
+			*/
+			void PackArchive();
+
 			/**
 			* @brief Joins the idle thread if possible
 			*/
@@ -220,6 +263,11 @@ namespace snuffbox
 
 			BuildGraph graph_; //!< The current build graph
 			BuildThread build_thread_; //!< The build thread
+			SourceWatch watch_; //!< The watch on the source directory, which is only accessed from the idle thread when it's running
+
+			bool synced_; //!< Was the build graph already synchronised by the idle thread before the build started?
+			bool repack_; //!< Were files compiled, or was the content archive removed, since the content archive was last packed?
+			std::chrono::high_resolution_clock::time_point changed_at_; //!< When the changes that started the current build were detected
 
 			bool is_valid_; //!< Is the current source directory valid?
 
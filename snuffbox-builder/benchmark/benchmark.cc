@@ -0,0 +1,96 @@
+#include "benchmark.h"
+
+#include <fstream>
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef SNUFF_WIN32
+	#include <Windows.h>
+#else
+	#include <sys/stat.h>
+#endif
+
+namespace snuffbox
+{
+	namespace builder
+	{
+		//-----------------------------------------------------------------------------------------------
+		Benchmark::Benchmark(const std::string& directory) :
+			src_(directory + "/src"),
+			bin_(directory + "/bin"),
+			directory_(directory)
+		{
+
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		bool Benchmark::Prepare() const
+		{
+			return MakeDirectory(directory_) == true && MakeDirectory(src_) == true && MakeDirectory(bin_) == true;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		bool Benchmark::WriteSource(const std::string& relative, const std::string& contents) const
+		{
+			size_t separator = relative.find_last_of('/');
+
+			if (separator != std::string::npos && MakeDirectory(src_ + '/' + relative.substr(0, separator)) == false)
+			{
+				return false;
+			}
+
+			std::ofstream fout(src_ + '/' + relative, std::ios::binary);
+
+			if (fout.is_open() == false)
+			{
+				return false;
+			}
+
+			fout.write(contents.c_str(), contents.size());
+			return fout.good();
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		double Benchmark::Time(const std::function<void()>& func)
+		{
+			std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+			func();
+
+			std::chrono::duration<double, std::milli> elapsed = std::chrono::high_resolution_clock::now() - start;
+			return elapsed.count();
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void Benchmark::Report(const std::string& phase, unsigned int count, double ms)
+		{
+			printf("%-32s %8u files %12.3fms %10.3fus/file\n", phase.c_str(), count, ms, count == 0 ? 0.0 : ms * 1000.0 / count);
+			fflush(stdout);
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		bool Benchmark::MakeDirectory(const std::string& path)
+		{
+#ifdef SNUFF_WIN32
+			return CreateDirectoryA(path.c_str(), NULL) != FALSE || GetLastError() == ERROR_ALREADY_EXISTS;
+#else
+			struct stat attributes;
+			return stat(path.c_str(), &attributes) == 0 || mkdir(path.c_str(), S_IRWXU | S_IRWXG | S_IRWXO) == 0;
+#endif
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		bool Benchmark::ParseCount(const char* value, unsigned int* count)
+		{
+			char* end = nullptr;
+			unsigned long parsed = strtoul(value, &end, 10);
+
+			if (end == value || *end != '\0' || parsed == 0)
+			{
+				return false;
+			}
+
+			*count = static_cast<unsigned int>(parsed);
+			return true;
+		}
+	}
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <string>
+#include <chrono>
+#include <functional>
+
+namespace snuffbox
+{
+	namespace builder
+	{
+		/**
+		* @class snuffbox::builder::Benchmark
+		* @brief The base of the builder benchmarks, which generate a source tree on disk and time parts of the build against it
+		* @remarks Results are written to stdout, one phase per line
+		* @author Daniel Konings
+		*/
+		class Benchmark
+		{
+
+		public:
+
+			/**
+			* @brief Parses a positive number from a command line argument
+			* @param[in] value (const char*) The argument
+			* @param[out] count (unsigned int*) The parsed number
+			* @return (bool) Was the argument a positive number?
+			*/
+			static bool ParseCount(const char* value, unsigned int* count);
+
+		protected:
+
+			/**
+			* @brief Construct by specifying the directory to generate the source tree in
+			* @param[in] directory (const std::string&) The directory, which will contain a 'src' and a 'bin' folder
+			*/
+			Benchmark(const std::string& directory);
+
+			/**
+			* @brief Creates the directory of the benchmark, with its source and build folders
+			* @return (bool) Were the directories created, or did they exist already?
+			*/
+			bool Prepare() const;
+
+			/**
+			* @brief Writes a file to the source folder, creating its directory if it does not exist yet
+			* @param[in] relative (const std::string&) The path of the file, relative to the source folder, with at most one directory
+			* @param[in] contents (const std::string&) The contents to write
+			* @return (bool) Was the file written?
+			*/
+			bool WriteSource(const std::string& relative, const std::string& contents) const;
+
+			/**
+			* @brief Runs a function and measures how long it took
+			* @param[in] func (const std::function<void()>&) The function to time
+			* @return (double) The time it took, in milliseconds
+			*/
+			static double Time(const std::function<void()>& func);
+
+			/**
+			* @brief Writes the timing of a phase to stdout
+			* @param[in] phase (const std::string&) The name of the phase
+			* @param[in] count (unsigned int) How many files the phase processed
+			* @param[in] ms (double) How long the phase took, in milliseconds
+			*/
+			static void Report(const std::string& phase, unsigned int count, double ms);
+
+			/**
+			* @brief Creates a directory if it does not exist yet
+			* @param[in] path (const std::string&) The path to the directory
+			* @return (bool) Does the directory exist now?
+			*/
+			static bool MakeDirectory(const std::string& path);
+
+			std::string src_; //!< The source folder of the benchmark
+			std::string bin_; //!< The build folder of the benchmark
+
+		private:
+
+			std::string directory_; //!< The directory of the benchmark
+		};
+	}
+}
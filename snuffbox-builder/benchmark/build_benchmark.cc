@@ -0,0 +1,349 @@
+#include "build_benchmark.h"
+
+#include <snuffbox-compilers/compilers/script_compiler.h>
+#include <snuffbox-compilers/compilers/shader_compiler.h>
+
+#include <fstream>
+#include <iterator>
+#include <atomic>
+#include <thread>
+#include <stdio.h>
+
+namespace snuffbox
+{
+	namespace builder
+	{
+		//-----------------------------------------------------------------------------------------------
+		const unsigned int BuildBenchmark::FILES_PER_DIRECTORY_ = 100;
+
+		//-----------------------------------------------------------------------------------------------
+		BuildBenchmark::BuildBenchmark(const std::string& directory, unsigned int num_scripts, unsigned int num_shaders) :
+			Benchmark(directory),
+			num_scripts_(num_scripts),
+			num_shaders_(num_shaders),
+			finished_(false),
+			succeeded_(false)
+		{
+
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		int BuildBenchmark::Run(const std::vector<unsigned int>& num_threads)
+		{
+			if (Prepare() == false || Generate() == false)
+			{
+				fprintf(stderr, "Could not generate the source tree\n");
+				return 1;
+			}
+
+			const std::vector<WorkerThread::BuildCommand>* sets[] = { &scripts_, &shaders_ };
+			const char* names[] = { "scripts", "shaders" };
+
+			bool succeeded = true;
+
+			for (int i = 0; i < 2; ++i)
+			{
+				const std::vector<WorkerThread::BuildCommand>& commands = *sets[i];
+				unsigned int count = static_cast<unsigned int>(commands.size());
+
+				if (count == 0)
+				{
+					continue;
+				}
+
+				succeeded = BuildPooled(commands, 1) == true && succeeded == true;
+
+				for (size_t j = 0; j < num_threads.size(); ++j)
+				{
+					unsigned int threads = num_threads.at(j);
+					std::string suffix = " -j " + std::to_string(threads);
+
+					bool pooled = true;
+					Report(std::string(names[i]) + " pool" + suffix, count, Time([this, &commands, threads, &pooled]()
+					{
+						pooled = BuildPooled(commands, threads);
+					}));
+
+					bool spawned = true;
+					Report(std::string(names[i]) + " spawn per file" + suffix, count, Time([this, &commands, threads, &spawned]()
+					{
+						spawned = BuildSpawned(commands, threads);
+					}));
+
+					succeeded = succeeded == true && pooled == true && spawned == true;
+				}
+			}
+
+			if (succeeded == false)
+			{
+				fprintf(stderr, "Not every file was built\n");
+				return 1;
+			}
+
+			return 0;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		bool BuildBenchmark::Generate()
+		{
+			scripts_.clear();
+			shaders_.clear();
+
+			for (unsigned int i = 0; i < num_scripts_; ++i)
+			{
+				std::string index = std::to_string(i);
+				std::string relative = "d" + std::to_string(i / FILES_PER_DIRECTORY_) + "/f" + index + ".js";
+
+				std::string contents =
+					"var Script" + index + " = function ()\n"
+					"{\n"
+					"\tthis.value = " + index + ";\n"
+					"};\n\n"
+					"Script" + index + ".prototype.update = function (dt)\n"
+					"{\n"
+					"\tthis.value += dt;\n"
+					"};\n";
+
+				if (WriteSource(relative, contents) == false || AddCommand(relative, BuildGraph::BuildData::FileType::kScript, &scripts_) == false)
+				{
+					return false;
+				}
+			}
+
+			for (unsigned int i = 0; i < num_shaders_; ++i)
+			{
+				std::string index = std::to_string(i);
+				std::string relative = "s" + std::to_string(i / FILES_PER_DIRECTORY_) + "/v" + index + ".vs";
+
+				std::string contents =
+					"cbuffer Constants : register(b0)\n"
+					"{\n"
+					"\tfloat4x4 World;\n"
+					"\tfloat4x4 ViewProjection;\n"
+					"\tfloat Time;\n"
+					"};\n\n"
+					"struct VSInput\n"
+					"{\n"
+					"\tfloat3 position : POSITION;\n"
+					"\tfloat3 normal : NORMAL;\n"
+					"\tfloat2 uv : TEXCOORD0;\n"
+					"};\n\n"
+					"struct VSOutput\n"
+					"{\n"
+					"\tfloat4 position : SV_POSITION;\n"
+					"\tfloat3 normal : NORMAL;\n"
+					"\tfloat2 uv : TEXCOORD0;\n"
+					"};\n\n"
+					"VSOutput main(VSInput input)\n"
+					"{\n"
+					"\tVSOutput output;\n"
+					"\tfloat4 world = mul(World, float4(input.position, 1.0f));\n"
+					"\tworld.y += sin(Time + world.x * " + index + ".0f) * 0.1f;\n"
+					"\toutput.position = mul(ViewProjection, world);\n"
+					"\toutput.normal = normalize(mul((float3x3)World, input.normal));\n"
+					"\toutput.uv = input.uv;\n"
+					"\treturn output;\n"
+					"}\n";
+
+				if (WriteSource(relative, contents) == false || AddCommand(relative, BuildGraph::BuildData::FileType::kShader, &shaders_) == false)
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		bool BuildBenchmark::AddCommand(const std::string& relative, BuildGraph::BuildData::FileType type, std::vector<WorkerThread::BuildCommand>* commands)
+		{
+			if (MakeDirectory(bin_ + '/' + relative.substr(0, relative.find_last_of('/'))) == false)
+			{
+				return false;
+			}
+
+			WorkerThread::BuildCommand cmd;
+			cmd.src_path = src_ + '/' + relative;
+			cmd.build_path = bin_ + '/' + relative;
+			cmd.file_type = type;
+			cmd.profile = compilers::ShaderCompiler::Profile::kDebug;
+			cmd.queued = 0.0;
+
+			commands->push_back(cmd);
+
+			return true;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		bool BuildBenchmark::BuildPooled(const std::vector<WorkerThread::BuildCommand>& commands, unsigned int num_threads)
+		{
+			BuildThread build_thread(this, num_threads);
+
+			finished_ = false;
+
+			for (size_t i = 0; i < commands.size(); ++i)
+			{
+				build_thread.Queue(commands.at(i));
+			}
+
+			build_thread.Run();
+
+			{
+				std::unique_lock<std::mutex> lock(finished_mutex_);
+				finished_condition_.wait(lock, [this]()
+				{
+					return finished_ == true;
+				});
+			}
+
+			build_thread.Stop();
+
+			return succeeded_;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		bool BuildBenchmark::BuildSpawned(const std::vector<WorkerThread::BuildCommand>& commands, unsigned int num_threads)
+		{
+			typedef BuildGraph::BuildData::FileType FileType;
+
+			struct Slot
+			{
+				std::thread thread;
+				std::atomic<bool> finished;
+				compilers::Compiler* compilers[static_cast<int>(FileType::kSkip)];
+			};
+
+			std::vector<Slot> slots(num_threads);
+
+			for (size_t i = 0; i < slots.size(); ++i)
+			{
+				Slot& slot = slots.at(i);
+				slot.finished = true;
+				slot.compilers[static_cast<int>(FileType::kScript)] = new compilers::ScriptCompiler();
+				slot.compilers[static_cast<int>(FileType::kShader)] = new compilers::ShaderCompiler();
+			}
+
+			std::atomic<bool> succeeded(true);
+			size_t next = 0;
+
+			while (next < commands.size())
+			{
+				for (size_t i = 0; i < slots.size() && next < commands.size(); ++i)
+				{
+					Slot& slot = slots.at(i);
+
+					if (slot.finished == false)
+					{
+						continue;
+					}
+
+					if (slot.thread.joinable() == true)
+					{
+						slot.thread.join();
+					}
+
+					slot.finished = false;
+
+					const WorkerThread::BuildCommand& cmd = commands.at(next++);
+
+					slot.thread = std::thread([&slot, &cmd, &succeeded]()
+					{
+						if (Compile(slot.compilers[static_cast<int>(cmd.file_type)], cmd) == false)
+						{
+							succeeded = false;
+						}
+
+						slot.finished = true;
+					});
+				}
+			}
+
+			for (size_t i = 0; i < slots.size(); ++i)
+			{
+				Slot& slot = slots.at(i);
+
+				if (slot.thread.joinable() == true)
+				{
+					slot.thread.join();
+				}
+
+				for (int j = 0; j < static_cast<int>(FileType::kSkip); ++j)
+				{
+					delete slot.compilers[j];
+				}
+			}
+
+			return succeeded;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		bool BuildBenchmark::Compile(compilers::Compiler* compiler, const WorkerThread::BuildCommand& cmd)
+		{
+			std::ifstream fin(cmd.src_path, std::ios::binary);
+
+			if (fin.is_open() == false)
+			{
+				return false;
+			}
+
+			std::string input((std::istreambuf_iterator<char>(fin)), std::istreambuf_iterator<char>());
+			fin.close();
+
+			const unsigned char* userdata = nullptr;
+
+			if (cmd.file_type == BuildGraph::BuildData::FileType::kShader)
+			{
+				userdata = reinterpret_cast<const unsigned char*>(cmd.src_path.c_str());
+				static_cast<compilers::ShaderCompiler*>(compiler)->set_profile(cmd.profile);
+			}
+
+			const unsigned char* output = nullptr;
+			size_t out_size = 0;
+
+			if (compiler->Compile(reinterpret_cast<const unsigned char*>(input.c_str()), input.size(), &out_size, &output, userdata) == false)
+			{
+				return false;
+			}
+
+			std::ofstream fout(cmd.build_path, std::ios::binary);
+
+			if (fout.is_open() == false)
+			{
+				return false;
+			}
+
+			fout.write(reinterpret_cast<const char*>(output), out_size);
+			return fout.good();
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void BuildBenchmark::OnFileStarted(int worker, const std::string& path)
+		{
+
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void BuildBenchmark::OnFileCompiled(int worker, const std::string& path, const BuildReport::Job& job)
+		{
+
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void BuildBenchmark::OnFileFailed(int worker, const std::string& path, const std::string& error)
+		{
+			fprintf(stderr, "%s: %s\n", path.c_str(), error.c_str());
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void BuildBenchmark::OnBuildFinished(unsigned int num_compiled, bool succeeded, const BuildReport& report)
+		{
+			{
+				std::lock_guard<std::mutex> lock(finished_mutex_);
+				finished_ = true;
+				succeeded_ = succeeded;
+			}
+
+			finished_condition_.notify_all();
+		}
+	}
+}
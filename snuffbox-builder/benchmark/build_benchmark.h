@@ -0,0 +1,122 @@
+#pragma once
+
+#include "benchmark.h"
+#include "../threads/build_thread.h"
+
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+
+namespace snuffbox
+{
+	namespace compilers
+	{
+		class Compiler;
+	}
+
+	namespace builder
+	{
+		/**
+		* @class snuffbox::builder::BuildBenchmark : public snuffbox::builder::Benchmark, public snuffbox::builder::BuildListener
+		* @brief Times building a source tree of small scripts and shaders on the worker pool, against spawning a thread for every file
+		* @remarks The spawning dispatch is how builds ran before the worker pool; one thread per slot, spinning until a slot is free
+		* @author Daniel Konings
+		*/
+		class BuildBenchmark : public Benchmark, public BuildListener
+		{
+
+		public:
+
+			/**
+			* @brief Construct by specifying where to generate the source tree and how large it should be
+			* @param[in] directory (const std::string&) The directory to generate the source tree in
+			* @param[in] num_scripts (unsigned int) The number of scripts to generate
+			* @param[in] num_shaders (unsigned int) The number of vertex shaders to generate
+			*/
+			BuildBenchmark(const std::string& directory, unsigned int num_scripts, unsigned int num_shaders);
+
+			/**
+			* @brief Generates the source tree and builds the scripts and the shaders once for every number of threads, with both dispatches
+			* @remarks Every set is built once before anything is timed, so every timed build finds its sources and outputs in the file cache
+			* @param[in] num_threads (const std::vector<unsigned int>&) The numbers of threads to build with
+			* @return (int) The exit code, 0 if every build succeeded
+			*/
+			int Run(const std::vector<unsigned int>& num_threads);
+
+			/**
+			* @see snuffbox::builder::BuildListener::OnFileStarted
+			*/
+			void OnFileStarted(int worker, const std::string& path) override;
+
+			/**
+			* @see snuffbox::builder::BuildListener::OnFileCompiled
+			*/
+			void OnFileCompiled(int worker, const std::string& path, const BuildReport::Job& job) override;
+
+			/**
+			* @see snuffbox::builder::BuildListener::OnFileFailed
+			*/
+			void OnFileFailed(int worker, const std::string& path, const std::string& error) override;
+
+			/**
+			* @see snuffbox::builder::BuildListener::OnBuildFinished
+			*/
+			void OnBuildFinished(unsigned int num_compiled, bool succeeded, const BuildReport& report) override;
+
+		protected:
+
+			/**
+			* @brief Writes every script and shader to the source folder and creates the build command for it
+			* @return (bool) Was every file written?
+			*/
+			bool Generate();
+
+			/**
+			* @brief Adds the build command for a generated file
+			* @param[in] relative (const std::string&) The path of the file, relative to the source folder
+			* @param[in] type (snuffbox::builder::BuildGraph::BuildData::FileType) The type of the file
+			* @param[out] commands (std::vector<snuffbox::builder::WorkerThread::BuildCommand>*) The commands to add to
+			* @return (bool) Could the output directory of the file be created?
+			*/
+			bool AddCommand(const std::string& relative, BuildGraph::BuildData::FileType type, std::vector<WorkerThread::BuildCommand>* commands);
+
+			/**
+			* @brief Builds a set of commands on the worker pool
+			* @param[in] commands (const std::vector<snuffbox::builder::WorkerThread::BuildCommand>&) The commands to build
+			* @param[in] num_threads (unsigned int) The number of worker threads
+			* @return (bool) Did the build succeed?
+			*/
+			bool BuildPooled(const std::vector<WorkerThread::BuildCommand>& commands, unsigned int num_threads);
+
+			/**
+			* @brief Builds a set of commands by spawning a new thread for each of them, as soon as one of the slots is free
+			* @param[in] commands (const std::vector<snuffbox::builder::WorkerThread::BuildCommand>&) The commands to build
+			* @param[in] num_threads (unsigned int) The number of slots
+			* @return (bool) Did the build succeed?
+			*/
+			bool BuildSpawned(const std::vector<WorkerThread::BuildCommand>& commands, unsigned int num_threads);
+
+			/**
+			* @brief Reads, compiles and writes a single file, like a worker thread does
+			* @param[in] compiler (snuffbox::compilers::Compiler*) The compiler for the file's type
+			* @param[in] cmd (const snuffbox::builder::WorkerThread::BuildCommand&) The command to execute
+			* @return (bool) Was the file compiled and written?
+			*/
+			static bool Compile(compilers::Compiler* compiler, const WorkerThread::BuildCommand& cmd);
+
+		private:
+
+			unsigned int num_scripts_; //!< The number of scripts in the source tree
+			unsigned int num_shaders_; //!< The number of shaders in the source tree
+			std::vector<WorkerThread::BuildCommand> scripts_; //!< The build command of every script in the source tree
+			std::vector<WorkerThread::BuildCommand> shaders_; //!< The build command of every shader in the source tree
+
+			bool finished_; //!< Did the current pooled build finish?
+			bool succeeded_; //!< Did the current pooled build succeed?
+			std::mutex finished_mutex_; //!< The mutex that guards the finished flag
+			std::condition_variable finished_condition_; //!< Signaled when the current pooled build finishes
+
+			static const unsigned int FILES_PER_DIRECTORY_; //!< The number of files that are put in a single directory
+		};
+	}
+}
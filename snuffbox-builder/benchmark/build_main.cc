@@ -0,0 +1,76 @@
+#include "build_benchmark.h"
+
+#include <snuffbox-compilers/utils/glslang_validator.h>
+
+#include <string>
+#include <vector>
+#include <stdio.h>
+
+int main(int argc, char** argv)
+{
+	std::string directory = "build_benchmark";
+	unsigned int num_scripts = 10000;
+	unsigned int num_shaders = 0;
+	std::vector<unsigned int> num_threads = { 1, 2, 4, 8 };
+
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string arg = argv[i];
+
+		bool valid = i + 1 < argc;
+
+		if (valid == true && arg == "--dir")
+		{
+			directory = argv[++i];
+		}
+		else if (valid == true && (arg == "--scripts" || arg == "--shaders"))
+		{
+			unsigned int* count = arg == "--scripts" ? &num_scripts : &num_shaders;
+			std::string value = argv[++i];
+
+			*count = 0;
+			valid = value == "0" || snuffbox::builder::Benchmark::ParseCount(value.c_str(), count) == true;
+		}
+		else if (valid == true && arg == "-j")
+		{
+			std::string list = argv[++i];
+			num_threads.clear();
+
+			size_t start = 0;
+			while (valid == true && start <= list.size())
+			{
+				size_t end = list.find(',', start);
+				end = end == std::string::npos ? list.size() : end;
+
+				unsigned int threads = 0;
+				valid = snuffbox::builder::Benchmark::ParseCount(list.substr(start, end - start).c_str(), &threads);
+
+				num_threads.push_back(threads);
+				start = end + 1;
+			}
+		}
+		else
+		{
+			valid = false;
+		}
+
+		if (valid == false)
+		{
+			fprintf(stderr, "Usage: snuffbox-build-benchmark [--dir <directory>] [--scripts <count>] [--shaders <count>] [-j <threads,...>]\n");
+			return 2;
+		}
+	}
+
+	snuffbox::compilers::GLSLangValidator::Initialise();
+
+	int result = 0;
+
+	{
+		snuffbox::builder::BuildBenchmark benchmark(directory, num_scripts, num_shaders);
+		result = benchmark.Run(num_threads);
+	}
+
+	snuffbox::compilers::GLSLangValidator::Shutdown();
+
+	return result;
+}
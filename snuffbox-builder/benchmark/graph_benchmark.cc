@@ -0,0 +1,122 @@
+#include "graph_benchmark.h"
+
+#include <fstream>
+#include <stdio.h>
+
+namespace snuffbox
+{
+	namespace builder
+	{
+		//-----------------------------------------------------------------------------------------------
+		const unsigned int GraphBenchmark::FILES_PER_DIRECTORY_ = 100;
+		const unsigned int GraphBenchmark::CHANGED_EVERY_ = 100;
+
+		//-----------------------------------------------------------------------------------------------
+		GraphBenchmark::GraphBenchmark(const std::string& directory, unsigned int num_files) :
+			Benchmark(directory),
+			num_files_(num_files)
+		{
+
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		int GraphBenchmark::Run()
+		{
+			if (Prepare() == false)
+			{
+				fprintf(stderr, "Could not create the benchmark directories\n");
+				return 1;
+			}
+
+			remove((bin_ + "/.build_graph").c_str());
+
+			if (Generate(0, 1) != num_files_)
+			{
+				fprintf(stderr, "Could not generate the source tree\n");
+				return 1;
+			}
+
+			unsigned int built = 0;
+			Report("sync (cold)", num_files_, Time([this, &built]()
+			{
+				built = graph_.Sync(src_, bin_);
+			}));
+
+			WriteOutputs();
+
+			const BuildGraph::Graph& data = graph_.data_;
+
+			Report("compile", static_cast<unsigned int>(data.size()), Time([this, &data]()
+			{
+				for (size_t i = 0; i < data.size(); ++i)
+				{
+					graph_.OnCompiled(data.at(i).path, src_, bin_);
+				}
+			}));
+
+			Report("save", static_cast<unsigned int>(data.size()), Time([this]()
+			{
+				graph_.Save(bin_);
+			}));
+
+			Report("sync (unchanged)", num_files_, Time([this, &built]()
+			{
+				built = graph_.Sync(src_, bin_);
+			}));
+
+			if (built != num_files_)
+			{
+				fprintf(stderr, "Only %u of %u files were built after the unchanged sync\n", built, num_files_);
+				return 1;
+			}
+
+			graph_.Save(bin_);
+			unsigned int changed = Generate(1, CHANGED_EVERY_);
+
+			Report("sync (" + std::to_string(changed) + " changed)", num_files_, Time([this, &built]()
+			{
+				built = graph_.Sync(src_, bin_);
+			}));
+
+			if (built != num_files_ - changed)
+			{
+				fprintf(stderr, "%u of %u files were built after the changed sync, expected %u\n", built, num_files_, num_files_ - changed);
+				return 1;
+			}
+
+			return 0;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		unsigned int GraphBenchmark::Generate(unsigned int revision, unsigned int every)
+		{
+			unsigned int written = 0;
+
+			for (unsigned int i = 0; i < num_files_; i += every)
+			{
+				std::string relative = "d" + std::to_string(i / FILES_PER_DIRECTORY_) + "/f" + std::to_string(i) + ".js";
+				std::string contents = "var value = " + std::to_string(i) + "; // revision " + std::to_string(revision) + "\n";
+
+				if (WriteSource(relative, contents) == false)
+				{
+					break;
+				}
+
+				++written;
+			}
+
+			return written;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void GraphBenchmark::WriteOutputs()
+		{
+			const BuildGraph::Graph& data = graph_.data_;
+
+			for (size_t i = 0; i < data.size(); ++i)
+			{
+				std::ofstream fout(bin_ + '/' + data.at(i).path, std::ios::binary);
+			}
+		}
+	}
+}
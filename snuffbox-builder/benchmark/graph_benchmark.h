@@ -0,0 +1,59 @@
+#pragma once
+
+#include "benchmark.h"
+#include "../utils/build_graph.h"
+
+namespace snuffbox
+{
+	namespace builder
+	{
+		/**
+		* @class snuffbox::builder::GraphBenchmark : public snuffbox::builder::Benchmark
+		* @brief Times synchronising the build graph with a large source tree, and marking every file in it as compiled
+		* @remarks The phases are a cold sync, compiling every file, a sync without changes and a sync after a small part of the tree changed
+		* @author Daniel Konings
+		*/
+		class GraphBenchmark : public Benchmark
+		{
+
+		public:
+
+			/**
+			* @brief Construct by specifying where to generate the source tree and how large it should be
+			* @param[in] directory (const std::string&) The directory to generate the source tree in
+			* @param[in] num_files (unsigned int) The number of scripts to generate
+			*/
+			GraphBenchmark(const std::string& directory, unsigned int num_files);
+
+			/**
+			* @brief Generates the source tree and times every phase
+			* @return (int) The exit code, 0 if the benchmark ran
+			*/
+			int Run();
+
+		protected:
+
+			/**
+			* @brief Writes every script to the source folder
+			* @param[in] revision (unsigned int) The revision to write into the scripts, to change their contents
+			* @param[in] every (unsigned int) Only every n-th script is written
+			* @return (unsigned int) The number of scripts that were written
+			*/
+			unsigned int Generate(unsigned int revision, unsigned int every);
+
+			/**
+			* @brief Writes an empty output for every file in the graph, as if the file was compiled
+			*/
+			void WriteOutputs();
+
+		private:
+
+			unsigned int num_files_; //!< The number of scripts in the source tree
+
+			BuildGraph graph_; //!< The build graph to time
+
+			static const unsigned int FILES_PER_DIRECTORY_; //!< The number of scripts that are put in a single directory
+			static const unsigned int CHANGED_EVERY_; //!< Every n-th script changes before the last sync
+		};
+	}
+}
@@ -0,0 +1,39 @@
+#include "graph_benchmark.h"
+
+#include <string>
+#include <stdio.h>
+
+int main(int argc, char** argv)
+{
+	std::string directory = "graph_benchmark";
+	unsigned int num_files = 50000;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string arg = argv[i];
+
+		bool valid = i + 1 < argc;
+
+		if (valid == true && arg == "--dir")
+		{
+			directory = argv[++i];
+		}
+		else if (valid == true && arg == "--files")
+		{
+			valid = snuffbox::builder::Benchmark::ParseCount(argv[++i], &num_files);
+		}
+		else
+		{
+			valid = false;
+		}
+
+		if (valid == false)
+		{
+			fprintf(stderr, "Usage: snuffbox-graph-benchmark [--dir <directory>] [--files <count>]\n");
+			return 2;
+		}
+	}
+
+	snuffbox::builder::GraphBenchmark benchmark(directory, num_files);
+	return benchmark.Run();
+}
@@ -0,0 +1,361 @@
+#include "headless_builder.h"
+#include "../utils/archive_packer.h"
+#include "../utils/source_watch.h"
+
+#include <snuffbox-compilers/utils/hash.h>
+
+#include <fstream>
+#include <chrono>
+#include <thread>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef SNUFF_WIN32
+	#include <direct.h>
+	#define mkdir(path) _mkdir(path)
+#else
+	#include <sys/stat.h>
+	#define mkdir(path) mkdir(path, S_IRWXU | S_IRWXG | S_IRWXO)
+#endif
+
+namespace snuffbox
+{
+	namespace builder
+	{
+		//-----------------------------------------------------------------------------------------------
+		bool HeadlessBuilder::Parse(int argc, char** argv, Options* options, std::string* error)
+		{
+			options->num_threads = 0;
+			options->watch = false;
+			options->release = false;
+
+			std::string arg;
+			for (int i = 1; i < argc; ++i)
+			{
+				arg = argv[i];
+
+				if (arg == "--watch" || arg == "--release")
+				{
+					(arg == "--watch" ? options->watch : options->release) = true;
+					continue;
+				}
+
+				if (arg != "--src" && arg != "--bin" && arg != "-j")
+				{
+					*error = "Unknown argument '" + arg + "'";
+					return false;
+				}
+
+				if (i + 1 >= argc)
+				{
+					*error = "Missing a value for '" + arg + "'";
+					return false;
+				}
+
+				std::string value = argv[++i];
+
+				if (arg == "-j")
+				{
+					char* end = nullptr;
+					unsigned long threads = strtoul(value.c_str(), &end, 10);
+
+					if (end == value.c_str() || *end != '\0' || threads == 0)
+					{
+						*error = "The number of threads should be a positive number, got '" + value + "'";
+						return false;
+					}
+
+					options->num_threads = static_cast<unsigned int>(threads);
+					continue;
+				}
+
+				for (size_t j = 0; j < value.size(); ++j)
+				{
+					value.at(j) = value.at(j) == '\\' ? '/' : value.at(j);
+				}
+
+				while (value.size() > 1 && value.back() == '/')
+				{
+					value.pop_back();
+				}
+
+				(arg == "--src" ? options->src : options->bin) = value;
+			}
+
+			if (options->src.empty() == true || options->bin.empty() == true)
+			{
+				*error = "Both '--src' and '--bin' should be specified";
+				return false;
+			}
+
+			return true;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		HeadlessBuilder::HeadlessBuilder(const Options& options) :
+			options_(options),
+			build_thread_(this, options.num_threads),
+			finished_(false),
+			succeeded_(false)
+		{
+			graph_.set_profile(options.release == true ? 
+				compilers::ShaderCompiler::Profile::kRelease : 
+				compilers::ShaderCompiler::Profile::kDebug);
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		int HeadlessBuilder::Run()
+		{
+			std::ifstream fin(options_.src + "/.snuff");
+
+			if (fin.is_open() == false)
+			{
+				fprintf(stderr, "'%s' is not a source directory, it should contain a '.snuff' file\n", options_.src.c_str());
+				return 1;
+			}
+
+			fin.close();
+
+			mkdir(options_.bin.c_str());
+
+			printf("{\"event\":\"start\",\"src\":%s,\"bin\":%s,\"threads\":%u,\"profile\":\"%s\"}\n",
+				BuildReport::Quote(options_.src).c_str(),
+				BuildReport::Quote(options_.bin).c_str(),
+				static_cast<unsigned int>(build_thread_.threads_.size()),
+				options_.release == true ? "release" : "debug");
+
+			std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+			unsigned int built = graph_.Sync(options_.src, options_.bin);
+			std::chrono::duration<double, std::milli> elapsed = std::chrono::high_resolution_clock::now() - start;
+
+			printf("{\"event\":\"sync\",\"files\":%u,\"built\":%u,\"ms\":%.3f}\n",
+				static_cast<unsigned int>(graph_.data_.size()),
+				built,
+				elapsed.count());
+
+			fflush(stdout);
+
+			bool succeeded = Build();
+
+			if (options_.watch == true)
+			{
+				Watch();
+			}
+
+			return succeeded == true ? 0 : 1;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		bool HeadlessBuilder::Build()
+		{
+			{
+				std::lock_guard<std::mutex> lock(finished_mutex_);
+				finished_ = false;
+			}
+
+			std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+			BuildGraph::CompileData c = graph_.FillQueue(&build_thread_, options_.src, options_.bin);
+			build_thread_.Run();
+
+			{
+				std::unique_lock<std::mutex> lock(finished_mutex_);
+				finished_condition_.wait(lock, [this]()
+				{
+					return finished_ == true;
+				});
+			}
+
+			build_thread_.Stop();
+
+			std::chrono::duration<double, std::milli> elapsed = std::chrono::high_resolution_clock::now() - start;
+
+			printf("{\"event\":\"finished\",\"files\":%u,\"succeeded\":%s,\"ms\":%.3f}\n",
+				c.not_build,
+				succeeded_ == true ? "true" : "false",
+				elapsed.count());
+
+			fflush(stdout);
+
+			graph_.Save(options_.bin);
+
+			if (succeeded_ == true)
+			{
+				Pack();
+			}
+			else
+			{
+				ArchivePacker::Remove(options_.bin);
+			}
+
+			return succeeded_;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void HeadlessBuilder::Watch()
+		{
+			SourceWatch watch;
+			std::vector<SourceWatch::Change> changes;
+
+			const unsigned int wait = 500;
+			bool watching = false;
+
+			uint64_t attempted = Pending();
+
+			while (true)
+			{
+				if (watching == false)
+				{
+					watching = watch.Start(options_.src);
+					graph_.Sync(options_.src, options_.bin);
+				}
+				else if (watch.Wait(wait, &changes) == false)
+				{
+					watching = false;
+					continue;
+				}
+				else if (changes.empty() == false)
+				{
+					printf("{\"event\":\"changes\",\"files\":%u}\n", static_cast<unsigned int>(changes.size()));
+					fflush(stdout);
+
+					graph_.Apply(changes, options_.src, options_.bin);
+				}
+
+				uint64_t pending = Pending();
+
+				if (pending != 0 && pending != attempted)
+				{
+					Build();
+					attempted = Pending();
+				}
+				else if (watching == false)
+				{
+					std::this_thread::sleep_for(std::chrono::milliseconds(wait));
+				}
+			}
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		uint64_t HeadlessBuilder::Pending() const
+		{
+			uint64_t hash = compilers::Hash::SEED;
+			bool any = false;
+
+			for (size_t i = 0; i < graph_.data_.size(); ++i)
+			{
+				const BuildGraph::BuildData& data = graph_.data_.at(i);
+
+				if (data.was_build == true)
+				{
+					continue;
+				}
+
+				hash = compilers::Hash::FNV1a(data.path.c_str(), data.path.size() + 1, hash);
+				hash = compilers::Hash::FNV1a(&data.content_hash, sizeof(uint64_t), hash);
+
+				if (BuildGraph::GetFileType(data.path.c_str() + data.path.find_last_of('.')) == BuildGraph::BuildData::FileType::kShader)
+				{
+					uint64_t includes = BuildGraph::HashShaderIncludes(options_.src, data.path);
+					hash = compilers::Hash::FNV1a(&includes, sizeof(uint64_t), hash);
+				}
+
+				any = true;
+			}
+
+			return any == true ? hash : 0;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void HeadlessBuilder::Pack()
+		{
+			std::vector<std::string> paths;
+
+			for (size_t i = 0; i < graph_.data_.size(); ++i)
+			{
+				const BuildGraph::BuildData& data = graph_.data_.at(i);
+
+				if (data.was_build == true)
+				{
+					paths.push_back(data.path);
+				}
+			}
+
+			std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+			std::string error;
+			if (ArchivePacker::Pack(options_.bin, paths, &error) == false)
+			{
+				fprintf(stderr, "Could not pack the content archive: %s\n", error.c_str());
+				printf("{\"event\":\"error\",\"message\":%s}\n", BuildReport::Quote("Could not pack the content archive: " + error).c_str());
+				fflush(stdout);
+
+				return;
+			}
+
+			std::chrono::duration<double, std::milli> elapsed = std::chrono::high_resolution_clock::now() - start;
+
+			printf("{\"event\":\"packed\",\"files\":%u,\"ms\":%.3f}\n", static_cast<unsigned int>(paths.size()), elapsed.count());
+			fflush(stdout);
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void HeadlessBuilder::OnFileStarted(int worker, const std::string& path)
+		{
+			printf("{\"event\":\"started\",\"worker\":%d,\"path\":%s}\n", worker + 1, BuildReport::Quote(path).c_str());
+			fflush(stdout);
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void HeadlessBuilder::OnFileCompiled(int worker, const std::string& path, const BuildReport::Job& job)
+		{
+			graph_.OnCompiled(path.c_str() + options_.src.size() + 1, options_.src, options_.bin);
+
+			if (job.spirv_size > 0)
+			{
+				printf("{\"event\":\"compiled\",\"worker\":%d,\"path\":%s,\"ms\":%.3f,\"spirv_bytes\":%u,\"optimised_bytes\":%u}\n",
+					worker + 1,
+					BuildReport::Quote(path).c_str(),
+					job.written - job.started,
+					static_cast<unsigned int>(job.spirv_size),
+					static_cast<unsigned int>(job.optimised_size));
+			}
+			else
+			{
+				printf("{\"event\":\"compiled\",\"worker\":%d,\"path\":%s,\"ms\":%.3f}\n", worker + 1, BuildReport::Quote(path).c_str(), job.written - job.started);
+			}
+
+			fflush(stdout);
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void HeadlessBuilder::OnFileFailed(int worker, const std::string& path, const std::string& error)
+		{
+			fprintf(stderr, "%s: %s\n", path.c_str(), error.c_str());
+
+			printf("{\"event\":\"failed\",\"worker\":%d,\"path\":%s,\"error\":%s}\n", worker + 1, BuildReport::Quote(path).c_str(), BuildReport::Quote(error).c_str());
+			fflush(stdout);
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void HeadlessBuilder::OnBuildFinished(unsigned int num_compiled, bool succeeded, const BuildReport& report)
+		{
+			if (num_compiled > 0)
+			{
+				printf("{\"event\":\"report\",\"report\":%s}\n", report.ToJSON().c_str());
+				fflush(stdout);
+
+				report.WriteTrace(options_.bin + '/' + BuildReport::TRACE_NAME);
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(finished_mutex_);
+				finished_ = true;
+				succeeded_ = succeeded;
+			}
+
+			finished_condition_.notify_all();
+		}
+	}
+}
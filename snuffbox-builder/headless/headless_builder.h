@@ -0,0 +1,120 @@
+#pragma once
+
+#include "../threads/build_thread.h"
+#include "../utils/build_graph.h"
+
+#include <string>
+#include <mutex>
+#include <condition_variable>
+
+namespace snuffbox
+{
+	namespace builder
+	{
+		/**
+		* @class snuffbox::builder::HeadlessBuilder : public snuffbox::builder::BuildListener
+		* @brief Builds a source directory without a window, for build servers and scripted builds
+		* @remarks Progress is written to stdout as JSON, one event per line, errors are also written to stderr
+		* @author Daniel Konings
+		*/
+		class HeadlessBuilder : public BuildListener
+		{
+
+		public:
+
+			/**
+			* @struct snuffbox::builder::HeadlessBuilder::Options
+			* @brief The options the headless builder is started with
+			* @author Daniel Konings
+			*/
+			struct Options
+			{
+				std::string src; //!< The source directory, which should contain a '.snuff' file
+				std::string bin; //!< The build directory
+				unsigned int num_threads; //!< The number of worker threads, 0 for one per hardware thread
+				bool watch; //!< Should the builder keep running and rebuild changed files?
+				bool release; //!< Should shaders be built with the release profile, which optimises and strips them?
+			};
+
+			/**
+			* @brief Parses the command line arguments
+			* @param[in] argc (int) The number of arguments
+			* @param[in] argv (char**) The arguments; '--src <dir>', '--bin <dir>', '-j <threads>', '--watch' and '--release'
+			* @param[out] options (snuffbox::builder::HeadlessBuilder::Options*) The parsed options
+			* @param[out] error (std::string*) Why parsing failed, if it did
+			* @return (bool) Were the arguments valid?
+			*/
+			static bool Parse(int argc, char** argv, Options* options, std::string* error);
+
+			/**
+			* @brief Construct by specifying the options
+			* @param[in] options (const snuffbox::builder::HeadlessBuilder::Options&) The options to build with
+			*/
+			HeadlessBuilder(const Options& options);
+
+			/**
+			* @brief Builds the source directory, and keeps rebuilding changes when watching
+			* @return (int) The exit code, 0 if every file was built
+			*/
+			int Run();
+
+			/**
+			* @see snuffbox::builder::BuildListener::OnFileStarted
+			*/
+			void OnFileStarted(int worker, const std::string& path) override;
+
+			/**
+			* @see snuffbox::builder::BuildListener::OnFileCompiled
+			*/
+			void OnFileCompiled(int worker, const std::string& path, const BuildReport::Job& job) override;
+
+			/**
+			* @see snuffbox::builder::BuildListener::OnFileFailed
+			*/
+			void OnFileFailed(int worker, const std::string& path, const std::string& error) override;
+
+			/**
+			* @see snuffbox::builder::BuildListener::OnBuildFinished
+			*/
+			void OnBuildFinished(unsigned int num_compiled, bool succeeded, const BuildReport& report) override;
+
+		protected:
+
+			/**
+			* @brief Builds every file in the graph that is not built yet and waits for the build to finish
+			* @remarks The graph is saved and the content archive is packed after a succesful build
+			* @return (bool) Were all files built?
+			*/
+			bool Build();
+
+			/**
+			* @brief Watches the source directory and rebuilds changed files, until the process is ended
+			*/
+			void Watch();
+
+			/**
+			* @brief Hashes the paths and contents of every file that is not built yet
+			* @remarks Files that failed to build stay unbuilt, the watch only retries them when this changes
+			* @return (uint64_t) The hash, or 0 if every file is built
+			*/
+			uint64_t Pending() const;
+
+			/**
+			* @brief Packs every built file into the content archive
+			*/
+			void Pack();
+
+		private:
+
+			Options options_; //!< The options to build with
+
+			BuildGraph graph_; //!< The build graph
+			BuildThread build_thread_; //!< The build thread
+
+			bool finished_; //!< Did the current build finish?
+			bool succeeded_; //!< Did the current build succeed?
+			std::mutex finished_mutex_; //!< The mutex that guards the finished flag
+			std::condition_variable finished_condition_; //!< Signaled when the current build finishes
+		};
+	}
+}
@@ -0,0 +1,30 @@
+#include "headless_builder.h"
+
+#include <snuffbox-compilers/utils/glslang_validator.h>
+
+#include <stdio.h>
+
+int main(int argc, char** argv)
+{
+	snuffbox::builder::HeadlessBuilder::Options options;
+	std::string error;
+
+	if (snuffbox::builder::HeadlessBuilder::Parse(argc, argv, &options, &error) == false)
+	{
+		fprintf(stderr, "%s\nUsage: snuffbox-build --src <directory> --bin <directory> [-j <threads>] [--watch] [--release]\n", error.c_str());
+		return 2;
+	}
+
+	snuffbox::compilers::GLSLangValidator::Initialise();
+
+	int result = 0;
+
+	{
+		snuffbox::builder::HeadlessBuilder builder(options);
+		result = builder.Run();
+	}
+
+	snuffbox::compilers::GLSLangValidator::Shutdown();
+
+	return result;
+}
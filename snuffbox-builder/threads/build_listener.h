@@ -0,0 +1,59 @@
+#pragma once
+
+#include "../utils/build_report.h"
+
+#include <string>
+
+namespace snuffbox
+{
+	namespace builder
+	{
+		/**
+		* @class snuffbox::builder::BuildListener
+		* @brief The interface the build thread reports its progress to, implemented by the builder window and the headless builder
+		* @remarks All methods are called from worker threads or the build thread, but never concurrently
+		* @author Daniel Konings
+		*/
+		class BuildListener
+		{
+
+		public:
+
+			/**
+			* @brief Called when a worker thread starts compiling a file
+			* @param[in] worker (int) The ID of the worker thread
+			* @param[in] path (const std::string&) The path to the source file
+			*/
+			virtual void OnFileStarted(int worker, const std::string& path) = 0;
+
+			/**
+			* @brief Called when a worker thread has compiled a file and written its output
+			* @param[in] worker (int) The ID of the worker thread
+			* @param[in] path (const std::string&) The path to the source file
+			* @param[in] job (const snuffbox::builder::BuildReport::Job&) The timing of the job, and the size of the Spir-V for shaders
+			*/
+			virtual void OnFileCompiled(int worker, const std::string& path, const BuildReport::Job& job) = 0;
+
+			/**
+			* @brief Called when a worker thread failed to compile a file, which aborts the build
+			* @param[in] worker (int) The ID of the worker thread
+			* @param[in] path (const std::string&) The path to the source file
+			* @param[in] error (const std::string&) The error
+			*/
+			virtual void OnFileFailed(int worker, const std::string& path, const std::string& error) = 0;
+
+			/**
+			* @brief Called when every queued file was compiled, or skipped after an error
+			* @param[in] num_compiled (unsigned int) The number of files that were queued
+			* @param[in] succeeded (bool) Were all files compiled without errors?
+			* @param[in] report (const snuffbox::builder::BuildReport&) The timing report of the build
+			*/
+			virtual void OnBuildFinished(unsigned int num_compiled, bool succeeded, const BuildReport& report) = 0;
+
+			/**
+			* @brief Default destructor
+			*/
+			virtual ~BuildListener() {}
+		};
+	}
+}
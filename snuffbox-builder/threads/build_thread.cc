@@ -1,26 +1,30 @@
-#include "../application/builder.h"
+#include "build_thread.h"
 
 #include <assert.h>
+#include <algorithm>
 
 namespace snuffbox
 {
 	namespace builder
 	{
 		//-----------------------------------------------------------------------------------------------
-		const unsigned int BuildThread::MAX_THREADS_ = std::thread::hardware_concurrency();
+		const unsigned int BuildThread::MAX_THREADS_ = std::max(1u, std::thread::hardware_concurrency());
 
 		//-----------------------------------------------------------------------------------------------
-		BuildThread::BuildThread(Builder* builder) :
-			builder_(builder),
-			building_(false)
+		BuildThread::BuildThread(BuildListener* listener, unsigned int num_threads) :
+			listener_(listener),
+			building_(false),
+			queued_(0),
+			pending_(0),
+			shutdown_(false)
 		{
-			assert(builder != nullptr);
+			assert(listener != nullptr);
 
-			threads_.resize(MAX_THREADS_);
+			threads_.resize(num_threads == 0 ? MAX_THREADS_ : num_threads);
 
 			for (int i = 0; i < threads_.size(); ++i)
 			{
-				threads_.at(i) = new WorkerThread(this);
+				threads_.at(i) = new WorkerThread(this, i);
 			}
 		}
 
@@ -33,57 +37,36 @@ namespace snuffbox
 
 			build_thread_ = std::thread([=]()
 			{
-				unsigned int to_compile = static_cast<unsigned int>(queue_.size());
-				int current_thread = 0;
-				bool finished = false;
-
-				auto FindCurrent = [&]()
-				{
-					for (int i = 0; i < threads_.size(); ++i)
-					{
-						if (threads_.at(i)->finished() == true)
-						{
-							current_thread = i;
-							return;
-						}
-					}
-
-					current_thread = MAX_THREADS_;
-				};
-
 				queue_mutex_.lock();
 
-				while (queue_.empty() == false && building_ == true)
-				{
-					const WorkerThread::BuildCommand& front = queue_.front();
-
-					if (static_cast<unsigned int>(current_thread) < MAX_THREADS_)
-					{
-						builder_->Log(std::to_string(current_thread + 1) + "> " + front.src_path);
-						threads_.at(current_thread)->Run(current_thread, front);
-						FindCurrent();
+				unsigned int to_compile = static_cast<unsigned int>(queue_.size());
+				pending_ = to_compile;
 
-						queue_.pop();
+				report_.Begin(static_cast<unsigned int>(threads_.size()));
 
-						continue;
-					}
+				for (unsigned int i = 0; queue_.empty() == false; ++i)
+				{
+					queue_.front().queued = report_.Elapsed();
 
-					FindCurrent();
+					threads_.at(i % threads_.size())->Push(queue_.front());
+					queue_.pop();
 				}
 
-				if (building_ == false && queue_.size() > 0)
+				queue_mutex_.unlock();
+
 				{
-					while (queue_.empty() == false)
-					{
-						queue_.pop();
-					}
+					std::lock_guard<std::mutex> lock(work_mutex_);
+					queued_ += to_compile;
 				}
 
-				queue_mutex_.unlock();
+				work_condition_.notify_all();
 
-				for (int i = 0; i < threads_.size(); ++i)
 				{
-					threads_.at(i)->Join();
+					std::unique_lock<std::mutex> lock(done_mutex_);
+					done_condition_.wait(lock, [this]()
+					{
+						return pending_ == 0;
+					});
 				}
 
 				OnFinished(to_compile);
@@ -107,34 +90,88 @@ namespace snuffbox
 			queue_.push(cmd);
 		}
 
+		//-----------------------------------------------------------------------------------------------
+		bool BuildThread::Take(WorkerThread* worker, WorkerThread::BuildCommand* cmd)
+		{
+			while (true)
+			{
+				if (queued_ > 0)
+				{
+					if (worker->Pop(cmd) == true)
+					{
+						--queued_;
+						return true;
+					}
+
+					for (size_t i = 1; i < threads_.size(); ++i)
+					{
+						WorkerThread* victim = threads_.at((worker->id() + i) % threads_.size());
+
+						if (victim->Steal(cmd) == true)
+						{
+							--queued_;
+							return true;
+						}
+					}
+				}
+
+				std::unique_lock<std::mutex> lock(work_mutex_);
+				work_condition_.wait(lock, [this]()
+				{
+					return shutdown_ == true || queued_ > 0;
+				});
+
+				if (shutdown_ == true)
+				{
+					return false;
+				}
+			}
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void BuildThread::OnJobDone()
+		{
+			if (--pending_ == 0)
+			{
+				std::lock_guard<std::mutex> lock(done_mutex_);
+				done_condition_.notify_all();
+			}
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void BuildThread::OnStarted(const WorkerThread* thread, const std::string& compiling)
+		{
+			std::lock_guard<std::mutex> lock(report_mutex_);
+			listener_->OnFileStarted(thread->id(), compiling);
+		}
+
 		//-----------------------------------------------------------------------------------------------
 		void BuildThread::OnCompiled(const WorkerThread* thread, const std::string& compiled)
 		{
+			std::lock_guard<std::mutex> lock(report_mutex_);
+
 			bool has_error = false;
 			const std::string& error = thread->GetError(&has_error);
-			std::string id = std::to_string(thread->id() + 1) + ">";
+			const BuildReport::Job& job = thread->job();
+
+			report_.Add(job);
 
 			if (has_error == true)
 			{
-				builder_->Log(id + " -- [ERROR] " + compiled + ": " + error.c_str());
+				listener_->OnFileFailed(thread->id(), compiled, error);
 				building_ = false;
 
 				return;
 			}
 
-			builder_->Log(id + " -- Compiled " + compiled);
-			builder_->OnCompiled(compiled);
+			listener_->OnFileCompiled(thread->id(), compiled, job);
 		}
 
 		//-----------------------------------------------------------------------------------------------
 		void BuildThread::OnFinished(unsigned int num_compiled)
 		{
-			builder_->Log(building_ == true ? 
-				"Done compiling " + std::to_string(num_compiled) + " file(s)" : "Error occurred, aborting",
-				true,
-				building_ == false);
-
-			builder_->SwitchStatus(Builder::BuildStatus::kIdle);
+			report_.End();
+			listener_->OnBuildFinished(num_compiled, building_ == true, report_);
 		}
 
 		//-----------------------------------------------------------------------------------------------
@@ -142,9 +179,15 @@ namespace snuffbox
 		{
 			Stop();
 
+			{
+				std::lock_guard<std::mutex> lock(work_mutex_);
+				shutdown_ = true;
+			}
+
+			work_condition_.notify_all();
+
 			for (int i = 0; i < threads_.size(); ++i)
 			{
-				threads_.at(i)->Join();
 				delete threads_.at(i);
 				threads_.at(i) = nullptr;
 			}
@@ -4,35 +4,42 @@
 #include <mutex>
 #include <condition_variable>
 #include <queue>
+#include <atomic>
 
 #include "worker_thread.h"
+#include "build_listener.h"
 
 namespace snuffbox
 {
 	namespace builder
 	{
 		class Builder;
+		class HeadlessBuilder;
 		class BuildGraph;
 
 		/**
 		* @class snuffbox::builder::BuildThread
-		* @brief The build thread that queues worker threads to do building
+		* @brief The build thread that hands the queued build commands to a pool of persistent worker threads
+		* @remarks Idle workers wait on a condition variable, the build thread itself sleeps until every job is done
 		* @author Daniel Konings
 		*/
 		class BuildThread
 		{
 
 			friend class Builder;
+			friend class HeadlessBuilder;
+			friend class BuildBenchmark;
 			friend class WorkerThread;
 			friend class BuildGraph;
 
 		protected:
 
 			/**
-			* @brief Construct through the builder
-			* @param[in] builder (snuffbox::builder::Builder*) The builder this build thread should run in
+			* @brief Construct by specifying where to report to and how many worker threads to start
+			* @param[in] listener (snuffbox::builder::BuildListener*) The listener that receives the progress of every build
+			* @param[in] num_threads (unsigned int) The number of worker threads, 0 for one per hardware thread, default = 0
 			*/
-			BuildThread(Builder* builder);
+			BuildThread(BuildListener* listener, unsigned int num_threads = 0);
 
 			/**
 			* @brief Runs the build thread
@@ -50,6 +57,27 @@ namespace snuffbox
 			*/
 			void Queue(const WorkerThread::BuildCommand& cmd);
 
+			/**
+			* @brief Takes the next job for a worker, from its own deque first and otherwise by stealing from the other workers
+			* @param[in] worker (snuffbox::builder::WorkerThread*) The worker that wants a job
+			* @param[out] cmd (snuffbox::builder::WorkerThread::BuildCommand*) The job to execute
+			* @return (bool) Was a job taken? False if the build thread is shutting down
+			* @remarks This blocks while there are no jobs
+			*/
+			bool Take(WorkerThread* worker, WorkerThread::BuildCommand* cmd);
+
+			/**
+			* @brief Called by a worker thread after it executed or skipped a job
+			*/
+			void OnJobDone();
+
+			/**
+			* @brief Called when a worker thread starts compiling a file
+			* @param[in] thread (const snuffbox::builder::WorkerThread*) The worker thread that started
+			* @param[in] compiling (const std::string&) The path to the file that is being compiled
+			*/
+			void OnStarted(const WorkerThread* thread, const std::string& compiling);
+
 			/**
 			* @brief Called when a worker thread has finished its work
 			* @param[in] thread (const snuffbox::builder::WorkerThread*) The worker thread that finished
@@ -66,22 +94,34 @@ namespace snuffbox
 		public:
 
 			/**
-			* @brief Default destructor, cleans up all threads
+			* @brief Default destructor, shuts the worker threads down and cleans them up
 			*/
 			~BuildThread();
 
 		private:
 
-			Builder* builder_; //!< The builder GUI
-			bool building_; //!< Is the build thread building?
+			BuildListener* listener_; //!< The listener that receives the progress of every build
+			std::atomic<bool> building_; //!< Is the build thread building? Workers skip their remaining jobs once this is false
 
 			std::thread build_thread_; //!< The actual build thread
-			std::vector<WorkerThread*> threads_; //!< All current worker threads
+			std::vector<WorkerThread*> threads_; //!< All worker threads, which live as long as the build thread
 
-			std::queue<WorkerThread::BuildCommand> queue_; //!< The current build commands
+			std::queue<WorkerThread::BuildCommand> queue_; //!< The build commands that are queued for the next build
 
 			std::mutex queue_mutex_; //!< The mutex for the build queue
 
+			std::atomic<unsigned int> queued_; //!< The number of jobs in the worker deques that were not taken yet
+			std::atomic<unsigned int> pending_; //!< The number of jobs of the current build that are not done yet
+			bool shutdown_; //!< Should the worker threads exit?
+
+			std::mutex work_mutex_; //!< The mutex idle workers wait on
+			std::condition_variable work_condition_; //!< Signaled when jobs are queued or the workers should exit
+			std::mutex done_mutex_; //!< The mutex the build thread waits on
+			std::condition_variable done_condition_; //!< Signaled when the last job of a build is done
+			std::mutex report_mutex_; //!< The mutex that serialises reports from the workers to the listener
+
+			BuildReport report_; //!< The timing report of the current build
+
 			static const unsigned int MAX_THREADS_; //!< The maximum number of threads
 		};
 	}
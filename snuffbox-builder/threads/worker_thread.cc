@@ -2,6 +2,7 @@
 #include "build_thread.h"
 
 #include <fstream>
+#include <algorithm>
 #include <assert.h>
 
 #include <snuffbox-compilers/compilers/script_compiler.h>
@@ -12,97 +13,180 @@ namespace snuffbox
 	namespace builder
 	{
 		//-----------------------------------------------------------------------------------------------
-		WorkerThread::WorkerThread(BuildThread* build_thread) :
+		WorkerThread::WorkerThread(BuildThread* build_thread, int id) :
 			build_thread_(build_thread),
 			has_error_(false),
 			error_(""),
-			id_(-1),
-			finished_(true)
+			id_(id)
 		{
 			assert(build_thread_ != nullptr);
 
 			compilers_[static_cast<int>(FileType::kScript)] = new compilers::ScriptCompiler();
 			compilers_[static_cast<int>(FileType::kShader)] = new compilers::ShaderCompiler();
+
+			thread_ = std::thread([=]()
+			{
+				Loop();
+			});
 		}
 
 		//-----------------------------------------------------------------------------------------------
 		void WorkerThread::Reset()
 		{
-			finished_ = false;
 			has_error_ = false;
 			error_ = "";
 		}
 
+		//-----------------------------------------------------------------------------------------------
+		void WorkerThread::Loop()
+		{
+			BuildCommand cmd;
+
+			while (build_thread_->Take(this, &cmd) == true)
+			{
+				if (build_thread_->building_ == true)
+				{
+					Execute(cmd);
+				}
+
+				build_thread_->OnJobDone();
+			}
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void WorkerThread::Push(const BuildCommand& cmd)
+		{
+			std::lock_guard<std::mutex> lock(jobs_mutex_);
+			jobs_.push_back(cmd);
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		bool WorkerThread::Pop(BuildCommand* cmd)
+		{
+			std::lock_guard<std::mutex> lock(jobs_mutex_);
+
+			if (jobs_.empty() == true)
+			{
+				return false;
+			}
+
+			*cmd = jobs_.back();
+			jobs_.pop_back();
+
+			return true;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		bool WorkerThread::Steal(BuildCommand* cmd)
+		{
+			std::lock_guard<std::mutex> lock(jobs_mutex_);
+
+			if (jobs_.empty() == true)
+			{
+				return false;
+			}
+
+			*cmd = jobs_.front();
+			jobs_.pop_front();
+
+			return true;
+		}
+
 		//-----------------------------------------------------------------------------------------------
 		void WorkerThread::SetError(const std::string& error, const std::string& compiling)
 		{
-			finished_ = true;
 			has_error_ = true;
 			error_ = error;
 
+			double now = build_thread_->report_.Elapsed();
+
+			job_.failed = true;
+			job_.read = std::max(job_.read, job_.started);
+			job_.compiled = std::max(job_.compiled, job_.read);
+			job_.written = now;
+
 			build_thread_->OnCompiled(this, compiling);
 		}
 
 		//-----------------------------------------------------------------------------------------------
-		void WorkerThread::Run(int id, const BuildCommand& cmd)
+		void WorkerThread::Execute(const BuildCommand& cmd)
 		{
-			assert(build_thread_ != nullptr);
+			Reset();
 
-			Join();
+			build_thread_->OnStarted(this, cmd.src_path);
 
-			id_ = id;
-			command_ = cmd;
-			
-			Reset();
+			BuildReport& report = build_thread_->report_;
 
-			thread_ = std::thread([=]()
+			job_.path = cmd.src_path;
+			job_.type = cmd.file_type;
+			job_.worker = id_;
+			job_.failed = false;
+			job_.queued = cmd.queued;
+			job_.started = report.Elapsed();
+			job_.read = job_.compiled = job_.written = 0.0;
+			job_.spirv_size = job_.optimised_size = 0;
+
+			size_t file_size;
+			size_t out_size;
+			unsigned char* input = OpenFile(cmd.src_path, &file_size);
+
+			if (input == nullptr)
 			{
-				size_t file_size;
-				size_t out_size;
-				unsigned char* input = OpenFile(command_.src_path, &file_size);
+				SetError("Could not open file", cmd.src_path);
+				return;
+			}
 
-				if (input == nullptr)
-				{
-					SetError("Could not open file", command_.src_path);
-					return;
-				}
+			job_.read = report.Elapsed();
 
-				const unsigned char* output = nullptr;
+			const unsigned char* output = nullptr;
 
-				bool compiled = false;
+			bool compiled = false;
 
-				const unsigned char* userdata = nullptr;
-				if (command_.file_type == BuildGraph::BuildData::FileType::kShader)
-				{
-					userdata = reinterpret_cast<const unsigned char*>(command_.src_path.c_str());
-				}
+			const unsigned char* userdata = nullptr;
+			compilers::Compiler* compiler = compilers_[static_cast<int>(cmd.file_type)];
+			compilers::ShaderCompiler* shader_compiler = nullptr;
 
-				compilers::Compiler* compiler = compilers_[static_cast<int>(command_.file_type)];
-				compiled = compiler->Compile(input, file_size, &out_size, &output, userdata);
-				
-				free(input);
+			if (cmd.file_type == BuildGraph::BuildData::FileType::kShader)
+			{
+				userdata = reinterpret_cast<const unsigned char*>(cmd.src_path.c_str());
 
-				if (compiled == false)
-				{
-					const char* error = compiler->GetError();
-					SetError(error != nullptr ? error : "Unknown error", command_.src_path);
-					return;
-				}
+				shader_compiler = static_cast<compilers::ShaderCompiler*>(compiler);
+				shader_compiler->set_profile(cmd.profile);
+			}
 
-				std::ofstream fout(command_.build_path, std::ios::binary);
+			compiled = compiler->Compile(input, file_size, &out_size, &output, userdata);
 
-				if (fout.is_open() == false)
-				{
-					SetError("Could not save", command_.src_path);
-					return;
-				}
+			if (compiled == true && shader_compiler != nullptr)
+			{
+				job_.spirv_size = shader_compiler->spirv_size();
+				job_.optimised_size = shader_compiler->optimised_size();
+			}
 
-				fout.write(reinterpret_cast<const char*>(output), out_size);
-				fout.close();
+			free(input);
 
-				build_thread_->OnCompiled(this, command_.src_path);
-				finished_ = true;
-			});
+			job_.compiled = report.Elapsed();
+
+			if (compiled == false)
+			{
+				const char* error = compiler->GetError();
+				SetError(error != nullptr ? error : "Unknown error", cmd.src_path);
+				return;
+			}
+
+			std::ofstream fout(cmd.build_path, std::ios::binary);
+
+			if (fout.is_open() == false)
+			{
+				SetError("Could not save", cmd.src_path);
+				return;
+			}
+
+			fout.write(reinterpret_cast<const char*>(output), out_size);
+			fout.close();
+
+			job_.written = report.Elapsed();
+
+			build_thread_->OnCompiled(this, cmd.src_path);
 		}
 
 		//-----------------------------------------------------------------------------------------------
@@ -161,14 +245,16 @@ namespace snuffbox
 		}
 
 		//-----------------------------------------------------------------------------------------------
-		const bool& WorkerThread::finished() const
+		const BuildReport::Job& WorkerThread::job() const
 		{
-			return finished_;
+			return job_;
 		}
 
 		//-----------------------------------------------------------------------------------------------
 		WorkerThread::~WorkerThread()
 		{
+			Join();
+
 			for (int i = 0; i < static_cast<int>(FileType::kSkip); ++i)
 			{
 				delete compilers_[i];
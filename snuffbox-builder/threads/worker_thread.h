@@ -2,8 +2,10 @@
 
 #include <thread>
 #include <mutex>
+#include <deque>
 
 #include "../utils/build_graph.h"
+#include "../utils/build_report.h"
 
 namespace snuffbox
 {
@@ -18,7 +20,8 @@ namespace snuffbox
 
 		/**
 		* @class snuffbox::builder::WorkerThread
-		* @brief A worker thread compiles a single file and stores it in the binary directory
+		* @brief A persistent worker thread that compiles files from its own job deque and stores them in the binary directory
+		* @remarks When its own deque is empty, a worker steals jobs from the other workers before it goes idle
 		* @author Daniel Konings
 		*/
 		class WorkerThread
@@ -26,6 +29,7 @@ namespace snuffbox
 
 			friend class BuildThread;
 			friend class BuildGraph;
+			friend class BuildBenchmark;
 
 		protected:
 
@@ -39,19 +43,47 @@ namespace snuffbox
 				std::string src_path; //!< The source path to build from
 				std::string build_path; //!< The build path to build to
 				BuildGraph::BuildData::FileType file_type; //!< The file type to build
+				compilers::ShaderCompiler::Profile profile; //!< The profile to compile shaders with
+				double queued; //!< When the command was handed to a worker, in milliseconds since the build started
 			};
 
 			/**
-			* @brief Initialises this worker thread with the current build thread
+			* @brief Initialises this worker thread with the current build thread and starts it
 			* @param[in] build_thread (snuffbox::builder::BuildThread*) The build thread
+			* @param[in] id (int) The ID of this worker thread
 			*/
-			WorkerThread(BuildThread* build_thread);
+			WorkerThread(BuildThread* build_thread, int id);
 
 			/**
-			* @brief Resets this thread for use
+			* @brief Resets this thread for a new job
 			*/
 			void Reset();
 
+			/**
+			* @brief The main loop of the worker, which executes jobs until the build thread shuts down
+			*/
+			void Loop();
+
+			/**
+			* @brief Pushes a job to the back of this worker's deque
+			* @param[in] cmd (const snuffbox::builder::WorkerThread::BuildCommand&) The command to push
+			*/
+			void Push(const BuildCommand& cmd);
+
+			/**
+			* @brief Pops a job from the back of this worker's deque, this should only be called by the worker itself
+			* @param[out] cmd (snuffbox::builder::WorkerThread::BuildCommand*) The popped command
+			* @return (bool) Was there a job to pop?
+			*/
+			bool Pop(BuildCommand* cmd);
+
+			/**
+			* @brief Steals a job from the front of this worker's deque, this is called by the other workers
+			* @param[out] cmd (snuffbox::builder::WorkerThread::BuildCommand*) The stolen command
+			* @return (bool) Was there a job to steal?
+			*/
+			bool Steal(BuildCommand* cmd);
+
 			/**
 			* @brief Sets an error message of this worker thread
 			* @param[in] error (const std::string&) The error message to set
@@ -61,11 +93,10 @@ namespace snuffbox
 			void SetError(const std::string& error, const std::string& compiling);
 
 			/**
-			* @brief Runs this worker thread with a given ID
-			* @param[in] id (int) The ID to assign to this worker thread
+			* @brief Compiles a single file on this worker thread
 			* @param[in] cmd (const snuffbox::builder::WorkerThread::BuildCommand&) The command to execute
 			*/
-			void Run(int id, const BuildCommand& cmd);
+			void Execute(const BuildCommand& cmd);
 
 			/**
 			* @brief Attempts to join this thread
@@ -93,12 +124,13 @@ namespace snuffbox
 			const int& id() const;
 
 			/**
-			* @return (const bool&) Has this thread finished?
+			* @return (const snuffbox::builder::BuildReport::Job&) The timing of the last job
 			*/
-			const bool& finished() const;
+			const BuildReport::Job& job() const;
 
 			/**
-			* @brief Frees up the compilers
+			* @brief Joins the thread and frees up the compilers
+			* @remarks The build thread should be shut down before a worker is destructed
 			*/
 			~WorkerThread();
 
@@ -112,12 +144,13 @@ namespace snuffbox
 			std::string error_; //!< The error this thread has encountered, if any
 
 			int id_; //!< The ID of this worker thread
-			BuildCommand command_; //!< The current build command of this thread
+			BuildReport::Job job_; //!< The timing of the last job
 
-			bool finished_; //!< Has this thread finished?
+			std::deque<BuildCommand> jobs_; //!< The jobs of this worker, popped from the back by the worker and stolen from the front by others
+			std::mutex jobs_mutex_; //!< The mutex that guards the job deque
 
 			typedef BuildGraph::BuildData::FileType FileType;
-			compilers::Compiler* compilers_[static_cast<int>(FileType::kSkip)]; //!< The different compilers per file type
+			compilers::Compiler* compilers_[static_cast<int>(FileType::kSkip)]; //!< The different compilers per file type, reused for every job of this worker
 		};
 	}
 }
\ No newline at end of file
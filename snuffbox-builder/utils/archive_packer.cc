@@ -0,0 +1,155 @@
+#include "archive_packer.h"
+
+#include <snuffbox-compilers/utils/archive_format.h>
+
+#include <fstream>
+#include <stdio.h>
+#include <string.h>
+
+namespace snuffbox
+{
+	namespace builder
+	{
+		//-----------------------------------------------------------------------------------------------
+		const char* ArchivePacker::ARCHIVE_NAME = "content.pack";
+
+		//-----------------------------------------------------------------------------------------------
+		bool ArchivePacker::Pack(const std::string& bin, const std::vector<std::string>& paths, std::string* error)
+		{
+			typedef compilers::ArchiveFormat Format;
+
+			auto Align = [](uint64_t offset)
+			{
+				return (offset + Format::ALIGNMENT - 1) & ~(Format::ALIGNMENT - 1);
+			};
+
+			uint32_t count = static_cast<uint32_t>(paths.size());
+
+			Format::Header header;
+			header.magic = compilers::Magic::kArchive;
+			header.version = Format::VERSION;
+			header.count = count;
+			header.capacity = Format::Capacity(count);
+			header.paths_offset = sizeof(Format::Header) + header.capacity * sizeof(Format::Entry);
+
+			std::vector<Format::Entry> table(header.capacity);
+			memset(&table[0], 0, table.size() * sizeof(Format::Entry));
+
+			std::string path_table;
+			std::vector<std::vector<char>> contents(count);
+			std::vector<uint32_t> indices(header.capacity);
+
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				const std::string& path = paths.at(i);
+
+				if (path.size() == 0 || path.size() > UINT16_MAX)
+				{
+					*error = "Invalid path length for '" + path + "'";
+					return false;
+				}
+
+				std::ifstream fin(bin + '/' + path, std::ios::binary | std::ios::ate);
+
+				if (fin.is_open() == false)
+				{
+					*error = "Could not open '" + path + "' for packing";
+					return false;
+				}
+
+				std::vector<char>& data = contents.at(i);
+				data.resize(static_cast<size_t>(fin.tellg()));
+
+				fin.seekg(0, std::ios::beg);
+				fin.read(data.data(), data.size());
+				fin.close();
+
+				uint64_t hash = Format::Hash(path.c_str(), path.size());
+				uint32_t mask = header.capacity - 1;
+				uint32_t slot = static_cast<uint32_t>(hash & mask);
+
+				while (table.at(slot).path_length != 0)
+				{
+					slot = (slot + 1) & mask;
+				}
+
+				indices.at(slot) = i;
+
+				Format::Entry& entry = table.at(slot);
+				entry.hash = hash;
+				entry.size = data.size();
+				entry.path_offset = static_cast<uint32_t>(path_table.size());
+				entry.path_length = static_cast<uint16_t>(path.size());
+				entry.flags = Format::EntryFlags::kNone;
+
+				path_table += path;
+			}
+
+			uint64_t offset = Align(header.paths_offset + path_table.size());
+			uint64_t data_offset = offset;
+
+			for (uint32_t i = 0; i < header.capacity; ++i)
+			{
+				Format::Entry& entry = table.at(i);
+
+				if (entry.path_length == 0)
+				{
+					continue;
+				}
+
+				entry.offset = offset;
+				offset = Align(offset + entry.size + 1);
+			}
+
+			header.size = offset;
+
+			std::string full_path = bin + '/' + ARCHIVE_NAME;
+			Remove(bin);
+
+			std::ofstream fout(full_path, std::ios::binary);
+
+			if (fout.is_open() == false)
+			{
+				*error = "Could not open '" + full_path + "' for writing";
+				return false;
+			}
+
+			fout.write(reinterpret_cast<const char*>(&header), sizeof(Format::Header));
+			fout.write(reinterpret_cast<const char*>(&table[0]), table.size() * sizeof(Format::Entry));
+			fout.write(path_table.c_str(), path_table.size());
+
+			std::vector<char> padding(static_cast<size_t>(Format::ALIGNMENT), 0);
+			uint64_t written = header.paths_offset + path_table.size();
+
+			fout.write(padding.data(), data_offset - written);
+			written = data_offset;
+
+			for (uint32_t i = 0; i < header.capacity; ++i)
+			{
+				const Format::Entry& entry = table.at(i);
+
+				if (entry.path_length == 0)
+				{
+					continue;
+				}
+
+				const std::vector<char>& data = contents.at(indices.at(i));
+				fout.write(data.data(), data.size());
+
+				written += entry.size;
+				fout.write(padding.data(), Align(written + 1) - written);
+				written = Align(written + 1);
+			}
+
+			fout.close();
+
+			return true;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void ArchivePacker::Remove(const std::string& bin)
+		{
+			remove((bin + '/' + ARCHIVE_NAME).c_str());
+		}
+	}
+}
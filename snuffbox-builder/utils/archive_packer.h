@@ -0,0 +1,41 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace snuffbox
+{
+	namespace builder
+	{
+		/**
+		* @class snuffbox::builder::ArchivePacker
+		* @brief Packs the compiled files of a build directory into a single archive that the engine can memory-map
+		* @see snuffbox::compilers::ArchiveFormat
+		* @author Daniel Konings
+		*/
+		class ArchivePacker
+		{
+
+		public:
+
+			/**
+			* @brief Packs a list of compiled files into the archive of a build directory
+			* @param[in] bin (const std::string&) The build directory, the archive is written to 'bin/ARCHIVE_NAME'
+			* @param[in] paths (const std::vector<std::string>&) The paths of the files to pack, relative to the build directory
+			* @param[out] error (std::string*) The reason packing failed, if it did
+			* @return (bool) Was the archive written succesfully?
+			*/
+			static bool Pack(const std::string& bin, const std::vector<std::string>& paths, std::string* error);
+
+			/**
+			* @brief Removes the archive of a build directory
+			* @param[in] bin (const std::string&) The build directory
+			* @remarks The engine prefers archived files over loose ones, so this should be called whenever the archive can no longer 
+			* be repacked to match the build directory, e.g. after a failed build, otherwise it shadows the files that were rebuilt
+			*/
+			static void Remove(const std::string& bin);
+
+			static const char* ARCHIVE_NAME; //!< The file name of the archive in the build directory
+		};
+	}
+}
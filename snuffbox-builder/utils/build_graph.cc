@@ -1,7 +1,16 @@
-#include "../application/builder.h"
 #include "build_graph.h"
+#include "../threads/build_thread.h"
+
+#include <snuffbox-compilers/compilers/script_compiler.h>
+#include <snuffbox-compilers/compilers/shader_compiler.h>
+#include <snuffbox-compilers/utils/hash.h>
 
 #include <assert.h>
+#include <string.h>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <unordered_set>
 
 #ifdef SNUFF_WIN32
 	#define localtime(out, time) { localtime_s(&out, time); }
@@ -15,106 +24,334 @@ namespace snuffbox
 	namespace builder
 	{
 		//-----------------------------------------------------------------------------------------------
-		const size_t BuildGraph::BuildData::BINARY_OFFSET = sizeof(std::string);
-		const size_t BuildGraph::BuildData::BINARY_SIZE = sizeof(BuildGraph::BuildData) - BuildGraph::BuildData::BINARY_OFFSET;
+		const unsigned int BuildGraph::MAX_INCLUDE_DEPTH_ = 16;
 
 		//-----------------------------------------------------------------------------------------------
-		BuildGraph::BuildGraph()
+		BuildGraph::BuildGraph() :
+			profile_(compilers::ShaderCompiler::Profile::kDebug)
 		{
 			
 		}
 
 		//-----------------------------------------------------------------------------------------------
-		BuildGraph::Graph BuildGraph::CreateGraph(const std::string& src, const std::string& bin)
+		void BuildGraph::set_profile(compilers::ShaderCompiler::Profile profile)
+		{
+			profile_ = profile;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		BuildGraph::Graph BuildGraph::CreateGraph(const std::string& src, const std::string& bin, Index* index)
 		{
 			lister_.List(src);
 			lister_.CreateDirectories(bin);
 
 			Load(bin);
 
-			const DirectoryLister::DirectoryTree& tree = lister_.tree();
+			const DirectoryLister::EntryList& entries = lister_.entries();
 
 			Graph new_graph;
+			new_graph.reserve(entries.size());
+			index->clear();
+
 			BuildData data;
-			std::string relative, ext;
+			const char* ext;
 
-			for (DirectoryLister::DirectoryTree::const_iterator it = tree.begin(); it != tree.end(); ++it)
+			for (size_t i = 0; i < entries.size(); ++i)
 			{
-				for (int i = 0; i < static_cast<int>(it->second.size()); ++i)
+				const DirectoryLister::Entry& entry = entries.at(i);
+				ext = strrchr(entry.path, '.');
+
+				if (ext == nullptr || GetFileType(ext) == BuildData::FileType::kSkip)
 				{
-					relative = it->second.at(i);
-					ext = relative.c_str() + relative.find_last_of('.');
+					continue;
+				}
+
+				data.path = entry.path;
+				data.is_content = data.was_build = false;
+				data.content_hash = data.compiler_hash = data.include_hash = 0;
+				data.inode = entry.inode;
+				data.size = entry.size;
+				data.mtime = entry.mtime;
+
+				data.last_build = data.last_modified = GetFileTime(entry.mtime);
+
+				index->emplace(data.path, new_graph.size());
+				new_graph.push_back(data);
+			}
+
+			return std::move(new_graph);
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		unsigned int BuildGraph::SyncGraph(Graph& graph, const Index& index, const std::string& src, const std::string& bin)
+		{
+			std::vector<std::string> to_hash;
+			std::vector<BuildData*> hashed;
+
+			std::vector<bool> matched(previous_.count(), false);
+			uint32_t num_matched = 0;
 
-					if (relative == ".snuff" || GetFileType(ext) == BuildData::FileType::kSkip)
+			const BuildGraphFile::Record* previous;
+			uint32_t record;
+
+			for (int i = 0; i < graph.size(); ++i)
+			{
+				BuildData& data = graph.at(i);
+				previous = previous_.Find(data.path, &record);
+
+				if (previous != nullptr)
+				{
+					matched.at(record) = true;
+					++num_matched;
+
+					if (previous->inode == data.inode && previous->size == data.size && previous->mtime == data.mtime)
 					{
+						ReadRecord(*previous, &data);
 						continue;
 					}
 
-					data.path = (it->first == "" ? "" : (it->first + '/')) + relative;
-					data.is_content = data.was_build = false;
+					data.is_content = previous->is_content != 0;
+					data.was_build = previous->was_build != 0;
+					data.last_build = GetFileTime(previous->last_build * 1000000000LL);
+					data.content_hash = previous->content_hash;
+					data.compiler_hash = previous->compiler_hash;
+					data.include_hash = previous->include_hash;
+				}
 
-					data.last_build = data.last_modified = GetFileTime(src + '/' + data.path);
+				to_hash.push_back(src + '/' + data.path);
+				hashed.push_back(&data);
+			}
 
-					new_graph.push_back(data);
+			const char* path;
+
+			for (uint32_t i = 0; i < previous_.count() && num_matched < previous_.count(); ++i)
+			{
+				path = matched.at(i) == true ? nullptr : previous_.path(previous_.record(i));
+
+				if (path != nullptr)
+				{
+					remove((bin + '/' + path).c_str());
+					ForgetIncludes(path);
 				}
 			}
 
-			return std::move(new_graph);
+			previous_.Close();
+
+			std::vector<uint64_t> hashes;
+			HashFiles(to_hash, &hashes);
+
+			for (int i = 0; i < hashed.size(); ++i)
+			{
+				BuildData* data = hashed.at(i);
+
+				if (data->content_hash != hashes.at(i))
+				{
+					data->content_hash = hashes.at(i);
+					data->was_build = false;
+				}
+			}
+
+			std::unordered_set<std::string> recheck;
+			std::unordered_set<const Include*> listed;
+
+			const DirectoryLister::EntryList& entries = lister_.entries();
+			std::unordered_map<std::string, Include>::const_iterator include;
+
+			for (size_t i = 0; i < entries.size() && includes_.empty() == false; ++i)
+			{
+				const DirectoryLister::Entry& entry = entries.at(i);
+				include = includes_.find(entry.path);
+
+				if (include == includes_.end())
+				{
+					continue;
+				}
+
+				listed.insert(&include->second);
+
+				if (include->second.inode != entry.inode || include->second.size != entry.size || include->second.mtime != entry.mtime)
+				{
+					recheck.insert(include->second.shaders.begin(), include->second.shaders.end());
+				}
+			}
+
+			for (include = includes_.begin(); include != includes_.end(); ++include)
+			{
+				if (include->second.inode != 0 && listed.find(&include->second) == listed.end())
+				{
+					recheck.insert(include->second.shaders.begin(), include->second.shaders.end());
+				}
+			}
+
+			BuildData::FileType type;
+			struct stat attributes;
+
+			unsigned int built = 0;
+			for (int i = 0; i < graph.size(); ++i)
+			{
+				BuildData& data = graph.at(i);
+
+				if (data.was_build == false)
+				{
+					continue;
+				}
+
+				type = GetFileType(data.path.c_str() + data.path.find_last_of('.'));
+
+				bool changed = 
+					data.compiler_hash != Fingerprint(type) ||
+					stat((bin + '/' + data.path).c_str(), &attributes) != 0;
+
+				if (changed == false && type == BuildData::FileType::kShader &&
+					(shader_includes_.find(data.path) == shader_includes_.end() || recheck.find(data.path) != recheck.end()))
+				{
+					changed = TrackIncludes(src, data.path) != data.include_hash;
+				}
+
+				if (changed == true)
+				{
+					data.was_build = false;
+					continue;
+				}
+
+				++built;
+			}
+
+			return built;
 		}
 
 		//-----------------------------------------------------------------------------------------------
-		unsigned int BuildGraph::SyncGraph(Graph& graph, const std::string& src, const std::string& bin)
+		unsigned int BuildGraph::Sync(const std::string& src, const std::string& bin)
 		{
-			std::string src_path;
-			std::string bin_path;
-			std::ifstream fin;
+			Index new_index;
+			Graph new_graph = CreateGraph(src, bin, &new_index);
+			unsigned int built = SyncGraph(new_graph, new_index, src, bin);
 
-			tm last_modified;
+			data_ = std::move(new_graph);
+			index_ = std::move(new_index);
 
-			unsigned int built = 0;
-			bool found = false;
-			for (int i = 0; i < data_.size(); ++i)
+			return built;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		unsigned int BuildGraph::Apply(const std::vector<SourceWatch::Change>& changes, const std::string& src, const std::string& bin)
+		{
+			Index::const_iterator found;
+			for (size_t i = 0; i < changes.size(); ++i)
 			{
-				found = false;
-				for (int j = 0; j < graph.size(); ++j)
+				const SourceWatch::Change& change = changes.at(i);
+
+				if (change.removed == false)
 				{
-					if (data_.at(i).path == graph.at(j).path)
-					{
-						found = true;
-						BuildData& data = graph.at(j);
-						data = data_.at(i);
+					continue;
+				}
 
-						if (data.was_build == true)
-						{
-							src_path = src + '/' + data.path;
-							bin_path = bin + '/' + data.path;
+				found = index_.find(change.path);
 
-							last_modified = GetFileTime(src_path);
+				if (found == index_.end())
+				{
+					continue;
+				}
 
-							fin = std::ifstream(bin_path);
+				remove((bin + '/' + change.path).c_str());
+				Erase(found->second);
+			}
 
-							if (fin.is_open() == false || difftime(mktime(&last_modified), mktime(&data.last_build)) > 0.0)
-							{
-								data.last_modified = last_modified;
-								data.was_build = false;
-								continue;
-							}
+			std::vector<std::string> to_hash;
+			std::vector<size_t> hashed;
 
-							if (fin.is_open() == true)
-							{
-								fin.close();
-							}
+			BuildData data;
+			struct stat attributes;
+			size_t dot;
 
-							++built;
-						}
+			for (size_t i = 0; i < changes.size(); ++i)
+			{
+				const SourceWatch::Change& change = changes.at(i);
+				dot = change.path.find_last_of('.');
 
-						break;
-					}
+				if (change.removed == true || dot == std::string::npos || GetFileType(change.path.substr(dot)) == BuildData::FileType::kSkip)
+				{
+					continue;
+				}
+
+				if (stat((src + '/' + change.path).c_str(), &attributes) != 0)
+				{
+					continue;
+				}
+
+				found = index_.find(change.path);
+
+				if (found == index_.end())
+				{
+					data.path = change.path;
+					data.is_content = data.was_build = false;
+					data.content_hash = data.compiler_hash = data.include_hash = 0;
+					data.last_build = data.last_modified = GetFileTime(GetModifiedTime(attributes));
+
+					found = index_.emplace(data.path, data_.size()).first;
+					data_.push_back(data);
+				}
+
+				BuildData& entry = data_.at(found->second);
+				entry.inode = static_cast<uint64_t>(attributes.st_ino);
+				entry.size = static_cast<uint64_t>(attributes.st_size);
+				entry.mtime = GetModifiedTime(attributes);
+
+				to_hash.push_back(src + '/' + change.path);
+				hashed.push_back(found->second);
+			}
+
+			std::vector<uint64_t> hashes;
+			HashFiles(to_hash, &hashes);
+
+			for (size_t i = 0; i < hashed.size(); ++i)
+			{
+				BuildData& entry = data_.at(hashed.at(i));
+
+				if (entry.content_hash != hashes.at(i))
+				{
+					entry.content_hash = hashes.at(i);
+					entry.last_modified = GetFileTime(entry.mtime);
+					entry.was_build = false;
+				}
+			}
+
+			std::unordered_set<std::string> recheck;
+			std::unordered_map<std::string, Include>::const_iterator include;
+
+			for (size_t i = 0; i < changes.size(); ++i)
+			{
+				include = includes_.find(changes.at(i).path);
+
+				if (include != includes_.end())
+				{
+					recheck.insert(include->second.shaders.begin(), include->second.shaders.end());
+				}
+			}
+
+			for (std::unordered_set<std::string>::const_iterator it = recheck.begin(); it != recheck.end(); ++it)
+			{
+				found = index_.find(*it);
+
+				if (found == index_.end())
+				{
+					continue;
 				}
 
-				if (found == false)
+				BuildData& entry = data_.at(found->second);
+
+				if (entry.was_build == true && TrackIncludes(src, entry.path) != entry.include_hash)
 				{
-					remove((bin + "/" + data_.at(i).path).c_str());
+					entry.was_build = false;
+				}
+			}
+
+			unsigned int built = 0;
+			for (size_t i = 0; i < data_.size(); ++i)
+			{
+				if (data_.at(i).was_build == true)
+				{
+					++built;
 				}
 			}
 
@@ -122,14 +359,103 @@ namespace snuffbox
 		}
 
 		//-----------------------------------------------------------------------------------------------
-		unsigned int BuildGraph::Sync(const std::string& src, const std::string& bin)
+		uint64_t BuildGraph::TrackIncludes(const std::string& src, const std::string& relative)
 		{
-			Graph new_graph = CreateGraph(src, bin);
-			unsigned int built = SyncGraph(new_graph, src, bin);
+			ForgetIncludes(relative);
 
-			data_ = new_graph;
+			std::vector<std::string> paths;
+			uint64_t hash = HashShaderIncludes(src, relative, &paths);
 
-			return built;
+			std::string root = NormalisePath(src);
+			root = root.empty() == true ? root : root + '/';
+
+			std::vector<std::string>& tracked = shader_includes_[relative];
+			std::string path;
+			struct stat attributes;
+
+			for (size_t i = 0; i < paths.size(); ++i)
+			{
+				path = NormalisePath(paths.at(i));
+
+				if (path.compare(0, root.size(), root) == 0)
+				{
+					path.erase(0, root.size());
+				}
+
+				if (std::find(tracked.begin(), tracked.end(), path) != tracked.end())
+				{
+					continue;
+				}
+
+				tracked.push_back(path);
+
+				Include& include = includes_[path];
+				include.shaders.push_back(relative);
+
+				if (stat(paths.at(i).c_str(), &attributes) != 0)
+				{
+					include.inode = include.size = 0;
+					include.mtime = 0;
+
+					continue;
+				}
+
+				include.inode = static_cast<uint64_t>(attributes.st_ino);
+				include.size = static_cast<uint64_t>(attributes.st_size);
+				include.mtime = GetModifiedTime(attributes);
+			}
+
+			return hash;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void BuildGraph::ForgetIncludes(const std::string& relative)
+		{
+			std::unordered_map<std::string, std::vector<std::string>>::iterator it = shader_includes_.find(relative);
+
+			if (it == shader_includes_.end())
+			{
+				return;
+			}
+
+			std::unordered_map<std::string, Include>::iterator include;
+
+			for (size_t i = 0; i < it->second.size(); ++i)
+			{
+				include = includes_.find(it->second.at(i));
+
+				if (include == includes_.end())
+				{
+					continue;
+				}
+
+				std::vector<std::string>& shaders = include->second.shaders;
+				shaders.erase(std::remove(shaders.begin(), shaders.end(), relative), shaders.end());
+
+				if (shaders.empty() == true)
+				{
+					includes_.erase(include);
+				}
+			}
+
+			shader_includes_.erase(it);
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void BuildGraph::Erase(size_t index)
+		{
+			ForgetIncludes(data_.at(index).path);
+			index_.erase(data_.at(index).path);
+
+			size_t last = data_.size() - 1;
+
+			if (index != last)
+			{
+				data_.at(index) = std::move(data_.at(last));
+				index_[data_.at(index).path] = index;
+			}
+
+			data_.pop_back();
 		}
 
 		//-----------------------------------------------------------------------------------------------
@@ -185,6 +511,7 @@ namespace snuffbox
 
 				ext = relative.c_str() + relative.find_last_of('.');
 				cmd.file_type = GetFileType(ext);
+				cmd.profile = profile_;
 
 				thread->Queue(cmd);
 			}
@@ -195,116 +522,294 @@ namespace snuffbox
 		}
 
 		//-----------------------------------------------------------------------------------------------
-		void BuildGraph::OnCompiled(const std::string& relative, const std::string& bin)
+		void BuildGraph::OnCompiled(const std::string& relative, const std::string& src, const std::string& bin)
 		{
-			for (int i = 0; i < data_.size(); ++i)
-			{
-				BuildGraph::BuildData& data = data_.at(i);
+			Index::const_iterator it = index_.find(relative);
 
-				if (data.path == relative)
-				{
-					data.was_build = true;
-					data.last_build = BuildGraph::GetFileTime(bin + '/' + relative);
-					break;
-				}
+			if (it == index_.end())
+			{
+				return;
 			}
+
+			BuildGraph::BuildData& data = data_.at(it->second);
+
+			data.was_build = true;
+			data.last_build = BuildGraph::GetFileTime(bin + '/' + relative);
+
+			BuildData::FileType type = GetFileType(relative.c_str() + relative.find_last_of('.'));
+			data.compiler_hash = Fingerprint(type);
+			data.include_hash = type == BuildData::FileType::kShader ? TrackIncludes(src, relative) : 0;
 		}
 
 		//-----------------------------------------------------------------------------------------------
 		void BuildGraph::Save(const std::string& bin) const
 		{
-			std::string full_path = bin + "/.build_graph";
-			remove(full_path.c_str());
+			std::vector<BuildGraphFile::Record> records(data_.size());
+			std::string strings;
+
+			for (int i = 0; i < data_.size(); ++i)
+			{
+				const BuildData& data = data_.at(i);
+				BuildGraphFile::Record& record = records.at(i);
+
+				tm last_modified = data.last_modified;
+				tm last_build = data.last_build;
+
+				memset(&record, 0, sizeof(BuildGraphFile::Record));
+				record.content_hash = data.content_hash;
+				record.compiler_hash = data.compiler_hash;
+				record.include_hash = data.include_hash;
+				record.inode = data.inode;
+				record.size = data.size;
+				record.mtime = data.mtime;
+				record.last_modified = static_cast<int64_t>(mktime(&last_modified));
+				record.last_build = static_cast<int64_t>(mktime(&last_build));
+				record.path = static_cast<uint32_t>(strings.size());
+				record.length = static_cast<uint32_t>(data.path.size());
+				record.is_content = data.is_content == true ? 1 : 0;
+				record.was_build = data.was_build == true ? 1 : 0;
+
+				strings.append(data.path);
+				strings.push_back('\0');
+			}
+
+			BuildGraphFile::Write(bin + "/.build_graph", records, strings);
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void BuildGraph::Load(const std::string& bin)
+		{
+			previous_.Open(bin + "/.build_graph");
+		}
 
-			std::ofstream fout(full_path, std::ios::binary);
+		//-----------------------------------------------------------------------------------------------
+		void BuildGraph::ReadRecord(const BuildGraphFile::Record& record, BuildData* data)
+		{
+			data->is_content = record.is_content != 0;
+			data->was_build = record.was_build != 0;
+			data->content_hash = record.content_hash;
+			data->compiler_hash = record.compiler_hash;
+			data->include_hash = record.include_hash;
+			data->inode = record.inode;
+			data->size = record.size;
+			data->mtime = record.mtime;
+
+			data->last_modified = GetFileTime(record.last_modified * 1000000000LL);
+			data->last_build = GetFileTime(record.last_build * 1000000000LL);
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		tm BuildGraph::GetFileTime(const std::string& path)
+		{
+			struct stat attributes;
+			stat(path.c_str(), &attributes);
+
+			return GetFileTime(GetModifiedTime(attributes));
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		tm BuildGraph::GetFileTime(int64_t mtime)
+		{
+			time_t time = static_cast<time_t>(mtime / 1000000000LL);
+
+			tm out;
+			localtime(out, &time);
+
+			return out;
+		}
 
-			if (fout.is_open() == false)
+		//-----------------------------------------------------------------------------------------------
+		int64_t BuildGraph::GetModifiedTime(const struct stat& attributes)
+		{
+#ifdef SNUFF_LINUX
+			return static_cast<int64_t>(attributes.st_mtim.tv_sec) * 1000000000LL + attributes.st_mtim.tv_nsec;
+#else
+			return static_cast<int64_t>(attributes.st_mtime) * 1000000000LL;
+#endif
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		uint64_t BuildGraph::HashFile(const std::string& path)
+		{
+			std::ifstream fin(path, std::ios::binary);
+
+			if (fin.is_open() == false)
 			{
-				return;
+				return 0;
 			}
 
-			for (int i = 0; i < data_.size(); ++i)
+			char buffer[65536];
+			uint64_t hash = compilers::Hash::SEED;
+
+			while (fin.good() == true)
 			{
-				WriteToFile(fout, data_.at(i), i == data_.size() - 1);
+				fin.read(buffer, sizeof(buffer));
+				hash = compilers::Hash::FNV1a(buffer, static_cast<size_t>(fin.gcount()), hash);
 			}
 
-			fout.close();
+			return hash;
 		}
 
 		//-----------------------------------------------------------------------------------------------
-		void BuildGraph::WriteToFile(std::ofstream& file, const BuildData& data, bool last) const
+		void BuildGraph::HashFiles(const std::vector<std::string>& paths, std::vector<uint64_t>* hashes)
 		{
-			size_t size = data.path.size();
-			assert(size + 1 <= 256);
-			
-			file.write(reinterpret_cast<const char*>(&size), sizeof(size_t));
-			file.write(data.path.c_str(), data.path.size());
+			hashes->resize(paths.size());
 
-			const char* binary = reinterpret_cast<const char*>(&data) + BuildGraph::BuildData::BINARY_OFFSET;
+			if (paths.empty() == true)
+			{
+				return;
+			}
 
-			file.write(binary, BuildData::BINARY_SIZE);
+			std::atomic<size_t> next(0);
+			auto work = [&paths, hashes, &next]()
+			{
+				size_t index;
+				while ((index = next++) < paths.size())
+				{
+					hashes->at(index) = HashFile(paths.at(index));
+				}
+			};
 
-			if (last == false)
+			unsigned int count = std::min(
+				std::max(1u, std::thread::hardware_concurrency()), 
+				static_cast<unsigned int>(paths.size()));
+
+			std::vector<std::thread> threads;
+			for (unsigned int i = 1; i < count; ++i)
+			{
+				threads.push_back(std::thread(work));
+			}
+
+			work();
+
+			for (unsigned int i = 0; i < threads.size(); ++i)
 			{
-				file.write(reinterpret_cast<char*>(&last), sizeof(bool));
+				threads.at(i).join();
 			}
 		}
 
 		//-----------------------------------------------------------------------------------------------
-		void BuildGraph::Load(const std::string& bin)
+		uint64_t BuildGraph::Fingerprint(BuildData::FileType type) const
 		{
-			std::string full_path = bin + "/.build_graph";
-			std::ifstream fin(full_path, std::ios::binary);
+			switch (type)
+			{
+			case BuildData::FileType::kScript:
+				return compilers::ScriptCompiler::Fingerprint();
 
-			if (fin.is_open() == false)
+			case BuildData::FileType::kShader:
+				return compilers::ShaderCompiler::Fingerprint(profile_);
+
+			default:
+				return 0;
+			}
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		uint64_t BuildGraph::HashIncludes(const std::string& directory, const std::string& path, std::vector<std::string>* includes, unsigned int depth)
+		{
+			if (depth >= MAX_INCLUDE_DEPTH_)
 			{
-				return;
+				return 0;
 			}
 
-			data_.clear();
+			std::ifstream fin(path);
 
-			BuildData data;
+			if (fin.is_open() == false)
+			{
+				return 0;
+			}
 
-			size_t size;
-			bool eof;
-			char buffer[256];
+			uint64_t hash = 0;
+			uint64_t contents;
 
-			while (fin.eof() == false)
+			std::string line, name, include;
+			size_t start, end;
+
+			while (std::getline(fin, line))
 			{
-				fin.read(reinterpret_cast<char*>(&size), sizeof(size_t));
+				start = line.find_first_not_of(" \t");
+
+				if (start == std::string::npos || line.compare(start, 8, "#include") != 0)
+				{
+					continue;
+				}
 
-				if (fin.eof() == true)
+				start = line.find('"', start + 8);
+				end = start == std::string::npos ? std::string::npos : line.find('"', start + 1);
+
+				if (end == std::string::npos)
 				{
-					break;
+					continue;
 				}
-				
-				assert(size + 1 <= 256);
-				fin.read(buffer, size);
 
-				memset(buffer + size, '\0', sizeof(char));
+				name = line.substr(start + 1, end - start - 1);
+				include = directory + '/' + name;
+
+				if (includes != nullptr)
+				{
+					includes->push_back(include);
+				}
 
-				data.path = buffer;
-				
-				fin.read(reinterpret_cast<char*>(&data) + BuildGraph::BuildData::BINARY_OFFSET, BuildData::BINARY_SIZE);
+				hash = compilers::Hash::FNV1a(name.c_str(), name.size() + 1, hash == 0 ? compilers::Hash::SEED : hash);
 
-				data_.push_back(data);
+				contents = HashFile(include);
+				hash = compilers::Hash::FNV1a(&contents, sizeof(uint64_t), hash);
 
-				fin.read(reinterpret_cast<char*>(&eof), sizeof(bool));
+				contents = HashIncludes(directory, include, includes, depth + 1);
+				hash = compilers::Hash::FNV1a(&contents, sizeof(uint64_t), hash);
 			}
 
-			fin.close();
+			return hash;
 		}
 
 		//-----------------------------------------------------------------------------------------------
-		tm BuildGraph::GetFileTime(const std::string& path)
+		uint64_t BuildGraph::HashShaderIncludes(const std::string& src, const std::string& relative, std::vector<std::string>* includes)
 		{
-			struct stat attributes;
-			stat(path.c_str(), &attributes);
+			std::string path = src + '/' + relative;
+			return HashIncludes(path.substr(0, path.find_last_of('/')), path, includes);
+		}
 
-			tm out;
-			localtime(out, &attributes.st_mtime);
+		//-----------------------------------------------------------------------------------------------
+		std::string BuildGraph::NormalisePath(const std::string& path)
+		{
+			std::vector<std::string> segments;
+			std::string segment;
 
-			return out;
+			for (size_t i = 0; i <= path.size(); ++i)
+			{
+				if (i < path.size() && path.at(i) != '/' && path.at(i) != '\\')
+				{
+					segment.push_back(path.at(i));
+					continue;
+				}
+
+				if (segment == "..")
+				{
+					if (segments.empty() == false && segments.back() != "..")
+					{
+						segments.pop_back();
+					}
+					else
+					{
+						segments.push_back(segment);
+					}
+				}
+				else if (segment.empty() == false && segment != ".")
+				{
+					segments.push_back(segment);
+				}
+
+				segment.clear();
+			}
+
+			std::string normalised = path.empty() == false && path.at(0) == '/' ? "/" : "";
+
+			for (size_t i = 0; i < segments.size(); ++i)
+			{
+				normalised += i == 0 ? segments.at(i) : '/' + segments.at(i);
+			}
+
+			return normalised;
 		}
 
 		//-----------------------------------------------------------------------------------------------
@@ -3,15 +3,24 @@
 #include <fstream>
 #include <string>
 #include <vector>
+#include <unordered_map>
 #include <time.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <inttypes.h>
 
 #include "../platform/platform_directory_lister.h"
+#include "source_watch.h"
+#include "build_graph_file.h"
+
+#include <snuffbox-compilers/compilers/shader_compiler.h>
 
 namespace snuffbox
 {
 	namespace builder
 	{
 		class Builder;
+		class HeadlessBuilder;
 		class BuildThread;
 
 		/**
@@ -24,6 +33,8 @@ namespace snuffbox
 		{
 
 			friend class Builder;
+			friend class HeadlessBuilder;
+			friend class GraphBenchmark;
 
 		public:
 
@@ -50,9 +61,12 @@ namespace snuffbox
 				bool was_build; //!< Was the file already build before?
 				tm last_modified; //!< The last time the file was modified
 				tm last_build; //!< The last time the file was build
-
-				static const size_t BINARY_OFFSET;
-				static const size_t BINARY_SIZE;
+				uint64_t content_hash; //!< The hash of the file's contents, the file is rebuilt when it changes
+				uint64_t compiler_hash; //!< The fingerprint of the compiler the file was last built with
+				uint64_t include_hash; //!< The hash of every file a shader included when it was last built, 0 for other files
+				uint64_t inode; //!< The inode of the file when its contents were last hashed
+				uint64_t size; //!< The size of the file when its contents were last hashed
+				int64_t mtime; //!< The modification time of the file when its contents were last hashed, in nanoseconds since the epoch
 			};
 
 			/**
@@ -68,30 +82,56 @@ namespace snuffbox
 
 		protected:
 
+			/**
+			* @struct snuffbox::builder::BuildGraph::Include
+			* @brief A file that is included by built shaders, with the attributes it had when it was last hashed
+			* @author Daniel Konings
+			*/
+			struct Include
+			{
+				uint64_t inode; //!< The inode of the file, 0 if it did not exist
+				uint64_t size; //!< The size of the file
+				int64_t mtime; //!< The modification time of the file, in nanoseconds since the epoch
+				std::vector<std::string> shaders; //!< The shaders that include the file, directly or through another include
+			};
+
 			typedef std::vector<BuildData> Graph;
+			typedef std::unordered_map<std::string, size_t> Index;
 
 			/**
 			* @brief Default constructor, loads any old build data
 			*/
 			BuildGraph();
 
+			/**
+			* @brief Sets the profile shaders are compiled with
+			* @param[in] profile (snuffbox::compilers::ShaderCompiler::Profile) The profile
+			* @remarks Changing the profile changes the shader fingerprint, which rebuilds every shader on the next sync
+			*/
+			void set_profile(compilers::ShaderCompiler::Profile profile);
+
 			/**
 			* @brief Creates a new graph from the lister tree
 			* @param[in] src (const std::string&) The current source directory
 			* @param[in] bin (const std::string&) The current build directory
+			* @param[out] index (snuffbox::builder::BuildGraph::Index*) The index of every path in the newly created graph
 			* @remarks This method also relists the source directory using the directory lister
 			* @return (snuffbox::builder::BuildGraph::Graph) The newly created graph
 			*/
-			Graph CreateGraph(const std::string& src, const std::string& bin);
+			Graph CreateGraph(const std::string& src, const std::string& bin, Index* index);
 
 			/**
 			* @brief Synchronises the a graph based on the current graph
 			* @param[in] graph (snuffbox::builder::BuildGraph::Graph&) The graph to synchronise with the current graph
+			* @param[in] index (const snuffbox::builder::BuildGraph::Index&) The index of every path in the graph to synchronise
 			* @param[in] src (const std::string&) The current source directory
 			* @param[in] bin (const std::string&) The current build directory
+			* @remarks The previous state of every file is looked up in the mapped build graph file, which is closed afterwards.
+			* Built shaders are only checked for changed includes when one of their tracked includes was listed with different attributes,
+			* or when their includes were not tracked yet in this session
 			* @return (unsigned int) How many files in the graph were already built?
 			*/
-			unsigned int SyncGraph(Graph& graph, const std::string& src, const std::string& bin);
+			unsigned int SyncGraph(Graph& graph, const Index& index, const std::string& src, const std::string& bin);
 
 			/**
 			* @brief Syncs the build graph with the source directory lister
@@ -100,6 +140,38 @@ namespace snuffbox
 			*/
 			unsigned int Sync(const std::string& src, const std::string& bin);
 
+			/**
+			* @brief Applies changes from the source watch to the build graph, without relisting the source directory
+			* @param[in] changes (const std::vector<snuffbox::builder::SourceWatch::Change>&) The changed files
+			* @param[in] src (const std::string&) The current source directory
+			* @param[in] bin (const std::string&) The current build directory
+			* @remarks Changed files are only marked as not built when their contents differ, removed files have their output removed.
+			* Include files are not part of the graph, so only the shaders that include a changed file are checked for changed includes
+			* @return (unsigned int) How many files were already built?
+			*/
+			unsigned int Apply(const std::vector<SourceWatch::Change>& changes, const std::string& src, const std::string& bin);
+
+			/**
+			* @brief Hashes the includes of a shader and tracks them, so that the shader is only checked again when one of them changes
+			* @param[in] src (const std::string&) The source directory
+			* @param[in] relative (const std::string&) The path to the shader, relative to the source directory
+			* @return (uint64_t) The hash of every include
+			* @see snuffbox::builder::BuildGraph::HashShaderIncludes
+			*/
+			uint64_t TrackIncludes(const std::string& src, const std::string& relative);
+
+			/**
+			* @brief Stops tracking the includes of a shader
+			* @param[in] relative (const std::string&) The path to the shader, relative to the source directory
+			*/
+			void ForgetIncludes(const std::string& relative);
+
+			/**
+			* @brief Removes an entry from the graph, by moving the last entry into its place
+			* @param[in] index (size_t) The index of the entry to remove
+			*/
+			void Erase(size_t index);
+
 			/**
 			* @brief Retrieves the compile data for the current list of files in the graph
 			* @remarks This is how many files have already been build and how many there are to build in total
@@ -120,9 +192,10 @@ namespace snuffbox
 			/**
 			* @brief Called when a file is compiled, the build graph will adjust the time values and set it to a built state
 			* @param[in] relative (const std::string&) The relative path of the file
+			* @param[in] src (const std::string&) The source folder, to hash the includes of shaders from
 			* @param[in] bin (const std::string&) The binary folder
 			*/
-			void OnCompiled(const std::string& relative, const std::string& bin);
+			void OnCompiled(const std::string& relative, const std::string& src, const std::string& bin);
 
 			/**
 			* @brief Saves the current build graph to the binary path
@@ -131,18 +204,39 @@ namespace snuffbox
 			void Save(const std::string& bin) const;
 
 			/**
-			* @brief Write build data to a file
-			* @param[in] file (std::ofstream&) The file to write to
-			* @param[in] data (const snuffbox::builder::BuildData&) The data to write
-			* @param[in] last (bool) Is this the last entry?
+			* @brief Maps an old build graph from the binary path, its records are looked up while synchronising
+			* @param[in] bin (const std::string&) The current binary path
+			* @remarks Graphs that are of an older version or corrupt are discarded, which rebuilds everything
 			*/
-			void WriteToFile(std::ofstream& file, const BuildData& data, bool last) const;
+			void Load(const std::string& bin);
 
 			/**
-			* @brief Loads an old build graph from the binary path
-			* @param[in] bin (const std::string&) The current binary path
+			* @brief Copies the build data of a previous session from a record
+			* @param[in] record (const snuffbox::builder::BuildGraphFile::Record&) The record to copy
+			* @param[out] data (snuffbox::builder::BuildGraph::BuildData*) The build data to copy into, its path is left untouched
 			*/
-			void Load(const std::string& bin);
+			static void ReadRecord(const BuildGraphFile::Record& record, BuildData* data);
+
+			/**
+			* @brief Hashes the contents of a file
+			* @param[in] path (const std::string&) The path to the file
+			* @return (uint64_t) The hash, or 0 if the file could not be read
+			*/
+			static uint64_t HashFile(const std::string& path);
+
+			/**
+			* @brief Hashes the contents of multiple files in parallel
+			* @param[in] paths (const std::vector<std::string>&) The paths to the files
+			* @param[out] hashes (std::vector<uint64_t>*) The hashes, in the same order as the paths
+			*/
+			static void HashFiles(const std::vector<std::string>& paths, std::vector<uint64_t>* hashes);
+
+			/**
+			* @brief Retrieves the fingerprint of the compiler that builds a file type
+			* @param[in] type (snuffbox::builder::BuildGraph::BuildData::FileType) The file type
+			* @return (uint64_t) The fingerprint of the compiler's version and options
+			*/
+			uint64_t Fingerprint(BuildData::FileType type) const;
 
 			/**
 			* @brief Retrieves the last modified time attribute from a file
@@ -151,6 +245,48 @@ namespace snuffbox
 			*/
 			static tm GetFileTime(const std::string& path);
 
+			/**
+			* @brief Converts a modification time, as listed by the directory lister, to a time structure
+			* @param[in] mtime (int64_t) The modification time in nanoseconds since the epoch
+			* @return (tm) The last modified time
+			*/
+			static tm GetFileTime(int64_t mtime);
+
+			/**
+			* @brief Retrieves the modification time from file attributes, as precise as the platform stores it
+			* @param[in] attributes (const struct stat&) The attributes of the file
+			* @return (int64_t) The modification time in nanoseconds since the epoch
+			*/
+			static int64_t GetModifiedTime(const struct stat& attributes);
+
+			/**
+			* @brief Hashes the contents of every file a shader includes, directly or through another include
+			* @param[in] directory (const std::string&) The directory of the shader, which includes are resolved relative to
+			* @param[in] path (const std::string&) The path to the shader or include file to scan
+			* @param[out] includes (std::vector<std::string>*) The paths of every include, if not nullptr
+			* @param[in] depth (unsigned int) The current include depth, to guard against circular includes
+			* @remarks The path of every include is hashed along with its contents, so removing or reordering includes changes the hash as well
+			* @return (uint64_t) The hash of every include, or 0 if the file includes nothing
+			*/
+			static uint64_t HashIncludes(const std::string& directory, const std::string& path, std::vector<std::string>* includes = nullptr, unsigned int depth = 0);
+
+			/**
+			* @brief Hashes the includes of a shader in the source directory
+			* @param[in] src (const std::string&) The source directory
+			* @param[in] relative (const std::string&) The path to the shader, relative to the source directory
+			* @param[out] includes (std::vector<std::string>*) The paths of every include, if not nullptr
+			* @return (uint64_t) The hash of every include
+			* @see snuffbox::builder::BuildGraph::HashIncludes
+			*/
+			static uint64_t HashShaderIncludes(const std::string& src, const std::string& relative, std::vector<std::string>* includes = nullptr);
+
+			/**
+			* @brief Removes empty, '.' and '..' segments from a path
+			* @param[in] path (const std::string&) The path to normalise
+			* @return (std::string) The normalised path, separated by forward slashes
+			*/
+			static std::string NormalisePath(const std::string& path);
+
 			/**
 			* @brief Retrieves a file type from a file extension
 			* @param[in] ext (const std::string&) The file extension as a string
@@ -161,7 +297,14 @@ namespace snuffbox
 		private:
 
 			Graph data_; //!< The full graph of build data
+			Index index_; //!< The position of every path in the graph of build data
 			DirectoryLister lister_; //!< The directory lister
+			BuildGraphFile previous_; //!< The mapped build graph of the previous session, only open while synchronising
+			compilers::ShaderCompiler::Profile profile_; //!< The profile shaders are compiled with
+			std::unordered_map<std::string, Include> includes_; //!< Every file included by a tracked shader, by its path relative to the source directory
+			std::unordered_map<std::string, std::vector<std::string>> shader_includes_; //!< The includes of every tracked shader, by the path of the shader
+
+			static const unsigned int MAX_INCLUDE_DEPTH_; //!< The maximum depth of nested shader includes that are checked
 		};
 	}
 }
\ No newline at end of file
@@ -0,0 +1,320 @@
+#include "build_graph_file.h"
+
+#include <snuffbox-compilers/utils/hash.h>
+
+#include <fstream>
+#include <string.h>
+#include <stdio.h>
+#include <assert.h>
+
+#ifdef SNUFF_WIN32
+	#include <Windows.h>
+#else
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+namespace snuffbox
+{
+	namespace builder
+	{
+		static_assert(sizeof(BuildGraphFile::Header) == 24, "The build graph header should be packed");
+		static_assert(sizeof(BuildGraphFile::Record) % sizeof(uint64_t) == 0, "The build graph records should keep the index aligned");
+		static_assert(sizeof(BuildGraphFile::Record) == 80, "The build graph records should be packed");
+
+		//-----------------------------------------------------------------------------------------------
+		const uint32_t BuildGraphFile::VERSION = 6;
+		const char BuildGraphFile::MAGIC_[4] = { 'S', 'N', 'B', 'G' };
+
+		//-----------------------------------------------------------------------------------------------
+		BuildGraphFile::BuildGraphFile() :
+			data_(nullptr),
+			size_(0),
+			header_(nullptr),
+			records_(nullptr),
+			index_(nullptr),
+			strings_(nullptr),
+#ifdef SNUFF_WIN32
+			file_(INVALID_HANDLE_VALUE),
+			mapping_(nullptr)
+#else
+			file_(-1)
+#endif
+		{
+
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		bool BuildGraphFile::Open(const std::string& path)
+		{
+			Close();
+
+#ifdef SNUFF_WIN32
+			file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+			if (file_ == INVALID_HANDLE_VALUE)
+			{
+				return false;
+			}
+
+			LARGE_INTEGER size;
+			if (GetFileSizeEx(file_, &size) == FALSE || size.QuadPart < static_cast<LONGLONG>(sizeof(Header)))
+			{
+				Close();
+				return false;
+			}
+
+			mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+			if (mapping_ == nullptr)
+			{
+				Close();
+				return false;
+			}
+
+			data_ = reinterpret_cast<const unsigned char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+			size_ = static_cast<size_t>(size.QuadPart);
+#else
+			file_ = open(path.c_str(), O_RDONLY);
+
+			if (file_ == -1)
+			{
+				return false;
+			}
+
+			struct stat attributes;
+			if (fstat(file_, &attributes) != 0 || attributes.st_size < static_cast<off_t>(sizeof(Header)))
+			{
+				Close();
+				return false;
+			}
+
+			void* mapped = mmap(nullptr, static_cast<size_t>(attributes.st_size), PROT_READ, MAP_SHARED, file_, 0);
+
+			data_ = mapped == MAP_FAILED ? nullptr : reinterpret_cast<const unsigned char*>(mapped);
+			size_ = static_cast<size_t>(attributes.st_size);
+#endif
+
+			if (data_ == nullptr)
+			{
+				Close();
+				return false;
+			}
+
+			const Header* header = reinterpret_cast<const Header*>(data_);
+
+			if (memcmp(header->magic, MAGIC_, sizeof(MAGIC_)) != 0 || header->version != VERSION)
+			{
+				Close();
+				return false;
+			}
+
+			if (header->capacity == 0 || (header->capacity & (header->capacity - 1)) != 0 || header->count >= header->capacity)
+			{
+				Close();
+				return false;
+			}
+
+			uint64_t expected = static_cast<uint64_t>(sizeof(Header)) +
+				static_cast<uint64_t>(header->count) * sizeof(Record) +
+				static_cast<uint64_t>(header->capacity) * sizeof(uint32_t) +
+				header->strings;
+
+			if (expected != size_)
+			{
+				Close();
+				return false;
+			}
+
+			header_ = header;
+			records_ = reinterpret_cast<const Record*>(data_ + sizeof(Header));
+			index_ = reinterpret_cast<const uint32_t*>(records_ + header->count);
+			strings_ = reinterpret_cast<const char*>(index_ + header->capacity);
+
+			return true;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void BuildGraphFile::Close()
+		{
+#ifdef SNUFF_WIN32
+			if (data_ != nullptr)
+			{
+				UnmapViewOfFile(data_);
+			}
+
+			if (mapping_ != nullptr)
+			{
+				CloseHandle(mapping_);
+				mapping_ = nullptr;
+			}
+
+			if (file_ != INVALID_HANDLE_VALUE)
+			{
+				CloseHandle(file_);
+				file_ = INVALID_HANDLE_VALUE;
+			}
+#else
+			if (data_ != nullptr)
+			{
+				munmap(const_cast<unsigned char*>(data_), size_);
+			}
+
+			if (file_ != -1)
+			{
+				close(file_);
+				file_ = -1;
+			}
+#endif
+
+			data_ = nullptr;
+			size_ = 0;
+			header_ = nullptr;
+			records_ = nullptr;
+			index_ = nullptr;
+			strings_ = nullptr;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		uint32_t BuildGraphFile::count() const
+		{
+			return header_ == nullptr ? 0 : header_->count;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		const BuildGraphFile::Record& BuildGraphFile::record(uint32_t index) const
+		{
+			assert(index < count());
+			return records_[index];
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		const char* BuildGraphFile::path(const Record& record) const
+		{
+			if (static_cast<uint64_t>(record.path) + record.length >= header_->strings || strings_[record.path + record.length] != '\0')
+			{
+				return nullptr;
+			}
+
+			return strings_ + record.path;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		const BuildGraphFile::Record* BuildGraphFile::Find(const std::string& path, uint32_t* index) const
+		{
+			if (header_ == nullptr)
+			{
+				return nullptr;
+			}
+
+			uint64_t hash = compilers::Hash::FNV1a(path.c_str(), path.size());
+			uint32_t mask = header_->capacity - 1;
+			uint32_t slot;
+
+			const char* found;
+
+			for (uint32_t i = 0; i < header_->capacity; ++i)
+			{
+				slot = index_[(hash + i) & mask];
+
+				if (slot == 0 || slot > header_->count)
+				{
+					return nullptr;
+				}
+
+				const Record& record = records_[slot - 1];
+
+				if (record.length != path.size())
+				{
+					continue;
+				}
+
+				found = this->path(record);
+
+				if (found != nullptr && memcmp(found, path.c_str(), path.size()) == 0)
+				{
+					if (index != nullptr)
+					{
+						*index = slot - 1;
+					}
+
+					return &record;
+				}
+			}
+
+			return nullptr;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		bool BuildGraphFile::Write(const std::string& path, const std::vector<Record>& records, const std::string& strings)
+		{
+			Header header;
+			memcpy(header.magic, MAGIC_, sizeof(MAGIC_));
+			header.version = VERSION;
+			header.count = static_cast<uint32_t>(records.size());
+			header.strings = static_cast<uint32_t>(strings.size());
+			header.capacity = 1;
+			header.padding = 0;
+
+			while (header.capacity <= header.count * 2)
+			{
+				header.capacity <<= 1;
+			}
+
+			std::vector<uint32_t> index(header.capacity, 0);
+			uint32_t mask = header.capacity - 1;
+			uint64_t hash;
+
+			for (uint32_t i = 0; i < header.count; ++i)
+			{
+				const Record& record = records.at(i);
+				hash = compilers::Hash::FNV1a(strings.c_str() + record.path, record.length);
+
+				while (index.at(hash & mask) != 0)
+				{
+					++hash;
+				}
+
+				index.at(hash & mask) = i + 1;
+			}
+
+			size_t records_size = records.size() * sizeof(Record);
+
+			std::string temp = path + ".tmp";
+			std::ofstream fout(temp, std::ios::binary);
+
+			if (fout.is_open() == false)
+			{
+				return false;
+			}
+
+			fout.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+			fout.write(reinterpret_cast<const char*>(records.data()), records_size);
+			fout.write(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(uint32_t));
+			fout.write(strings.data(), strings.size());
+
+			bool written = fout.good();
+			fout.close();
+
+			if (written == false)
+			{
+				remove(temp.c_str());
+				return false;
+			}
+
+#ifdef SNUFF_WIN32
+			return MoveFileExA(temp.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING) != FALSE;
+#else
+			return rename(temp.c_str(), path.c_str()) == 0;
+#endif
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		BuildGraphFile::~BuildGraphFile()
+		{
+			Close();
+		}
+	}
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <inttypes.h>
+
+namespace snuffbox
+{
+	namespace builder
+	{
+		/**
+		* @class snuffbox::builder::BuildGraphFile
+		* @brief The on-disk format of the build graph, which is memory mapped and read in place
+		* @remarks The file starts with a header, followed by fixed-size records, an open-addressed index of the records by path and a string table with the paths.
+		* Opening a file only checks its header and size, records are looked up through the index and bounds checked when they are read,
+		* so synchronising only touches the records of the files that are listed
+		* @author Daniel Konings
+		*/
+		class BuildGraphFile
+		{
+
+		public:
+
+			/**
+			* @struct snuffbox::builder::BuildGraphFile::Header
+			* @brief The header at the start of the file
+			* @author Daniel Konings
+			*/
+			struct Header
+			{
+				char magic[4]; //!< Always 'SNBG'
+				uint32_t version; //!< The version of the format
+				uint32_t count; //!< The number of records
+				uint32_t strings; //!< The size of the string table in bytes
+				uint32_t capacity; //!< The number of slots in the index, always a power of two
+				uint32_t padding; //!< Padding to keep the records aligned, always zero
+			};
+
+			/**
+			* @struct snuffbox::builder::BuildGraphFile::Record
+			* @brief A single entry of the build graph, aligned to 8 bytes
+			* @author Daniel Konings
+			*/
+			struct Record
+			{
+				uint64_t content_hash; //!< The hash of the file's contents
+				uint64_t compiler_hash; //!< The fingerprint of the compiler the file was last built with
+				uint64_t include_hash; //!< The hash of every file a shader included when it was last built
+				uint64_t inode; //!< The inode of the file when its contents were last hashed
+				uint64_t size; //!< The size of the file when its contents were last hashed
+				int64_t mtime; //!< The modification time of the file when its contents were last hashed, in nanoseconds since the epoch
+				int64_t last_modified; //!< The last time the file was modified, in seconds since the epoch
+				int64_t last_build; //!< The last time the file was build, in seconds since the epoch
+				uint32_t path; //!< The offset of the path in the string table
+				uint32_t length; //!< The length of the path, without null terminator
+				uint8_t is_content; //!< Is this file actual content?
+				uint8_t was_build; //!< Was the file already build before?
+				uint8_t padding[6]; //!< Padding to keep the next record aligned, always zero
+			};
+
+			/**
+			* @brief Default constructor
+			*/
+			BuildGraphFile();
+
+			/**
+			* @brief Remove copy constructor
+			*/
+			BuildGraphFile(const BuildGraphFile& other) = delete;
+
+			/**
+			* @brief Maps a build graph file and validates it
+			* @param[in] path (const std::string&) The path to the file
+			* @return (bool) Was the file mapped and is it valid? Files of another version or with a size that does not match their header are not
+			*/
+			bool Open(const std::string& path);
+
+			/**
+			* @brief Unmaps the file, any retrieved records become invalid
+			*/
+			void Close();
+
+			/**
+			* @return (uint32_t) The number of records in the file
+			*/
+			uint32_t count() const;
+
+			/**
+			* @param[in] index (uint32_t) The index of the record
+			* @return (const snuffbox::builder::BuildGraphFile::Record&) The record at the index
+			*/
+			const Record& record(uint32_t index) const;
+
+			/**
+			* @param[in] record (const snuffbox::builder::BuildGraphFile::Record&) The record to retrieve the path of
+			* @return (const char*) The null terminated path of the record, which lives in the mapped string table, or nullptr if the record is corrupt
+			*/
+			const char* path(const Record& record) const;
+
+			/**
+			* @brief Looks up a record by path through the index
+			* @param[in] path (const std::string&) The path of the record
+			* @param[out] index (uint32_t*) The index of the found record, if not nullptr
+			* @return (const snuffbox::builder::BuildGraphFile::Record*) The found record, or nullptr if the file has no valid record with the path
+			*/
+			const Record* Find(const std::string& path, uint32_t* index = nullptr) const;
+
+			/**
+			* @brief Writes a build graph file, through a temporary file so a partially written file never replaces a valid one
+			* @param[in] path (const std::string&) The path to write to
+			* @param[in] records (const std::vector<snuffbox::builder::BuildGraphFile::Record>&) The records to write
+			* @param[in] strings (const std::string&) The string table the records point into
+			* @return (bool) Was the file written succesfully?
+			* @remarks The temporary file replaces the old one in a single rename, so there is no moment at which neither exists
+			*/
+			static bool Write(const std::string& path, const std::vector<Record>& records, const std::string& strings);
+
+			/**
+			* @brief Default destructor, unmaps the file
+			*/
+			~BuildGraphFile();
+
+			static const uint32_t VERSION; //!< The current version of the format, files of any other version are discarded
+
+		private:
+
+			const unsigned char* data_; //!< The mapped data
+			size_t size_; //!< The size of the mapped data
+			const Header* header_; //!< The header of a valid file, or nullptr
+			const Record* records_; //!< The records of a valid file
+			const uint32_t* index_; //!< The index of a valid file, every slot holds a record index plus one, or 0 if it is empty
+			const char* strings_; //!< The string table of a valid file
+
+#ifdef SNUFF_WIN32
+			void* file_; //!< The file handle
+			void* mapping_; //!< The file mapping handle
+#else
+			int file_; //!< The file descriptor
+#endif
+
+			static const char MAGIC_[4]; //!< The magic at the start of every build graph file
+		};
+	}
+}
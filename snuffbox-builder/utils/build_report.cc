@@ -0,0 +1,326 @@
+#include "build_report.h"
+
+#include <fstream>
+#include <algorithm>
+#include <stdio.h>
+
+namespace snuffbox
+{
+	namespace builder
+	{
+		//-----------------------------------------------------------------------------------------------
+		const char* BuildReport::TRACE_NAME = ".build_trace.json";
+
+		//-----------------------------------------------------------------------------------------------
+		BuildReport::BuildReport() :
+			start_(std::chrono::high_resolution_clock::now()),
+			total_(0.0),
+			num_workers_(0)
+		{
+
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void BuildReport::Begin(unsigned int num_workers)
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+
+			jobs_.clear();
+			num_workers_ = num_workers;
+			total_ = 0.0;
+
+			start_ = std::chrono::high_resolution_clock::now();
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void BuildReport::Add(const Job& job)
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			jobs_.push_back(job);
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void BuildReport::End()
+		{
+			total_ = Elapsed();
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		double BuildReport::Elapsed() const
+		{
+			std::chrono::duration<double, std::milli> elapsed = std::chrono::high_resolution_clock::now() - start_;
+			return elapsed.count();
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		BuildReport::Statistics BuildReport::Compute() const
+		{
+			Statistics s;
+			s.busy = s.longest = 0.0;
+			s.failed = 0;
+
+			double duration;
+			for (size_t i = 0; i < jobs_.size(); ++i)
+			{
+				const Job& job = jobs_.at(i);
+				duration = job.written - job.started;
+
+				s.busy += duration;
+				s.longest = std::max(s.longest, duration);
+				s.failed += job.failed == true ? 1 : 0;
+			}
+
+			s.parallelism = total_ > 0.0 ? s.busy / total_ : 0.0;
+			s.lower_bound = std::max(s.longest, num_workers_ > 0 ? s.busy / num_workers_ : s.busy);
+
+			return s;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		std::vector<std::string> BuildReport::Summary(size_t slowest) const
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+
+			std::vector<std::string> lines;
+			char line[512];
+
+			Statistics s = Compute();
+
+			snprintf(line, sizeof(line), "Build report: %u file(s) in %.3f ms on %u worker(s), %u failed",
+				static_cast<unsigned int>(jobs_.size()), total_, num_workers_, static_cast<unsigned int>(s.failed));
+			lines.push_back(line);
+
+			snprintf(line, sizeof(line), "  Effective parallelism %.2f, longest file %.3f ms, best possible time %.3f ms",
+				s.parallelism, s.longest, s.lower_bound);
+			lines.push_back(line);
+
+			std::vector<double> busy(num_workers_, 0.0);
+			std::vector<unsigned int> count(num_workers_, 0);
+
+			const int num_types = static_cast<int>(BuildGraph::BuildData::FileType::kSkip);
+			const char* type_names[] = { "Scripts", "Shaders" };
+
+			double read[num_types] = { 0.0 };
+			double compile[num_types] = { 0.0 };
+			double write[num_types] = { 0.0 };
+			unsigned int files[num_types] = { 0 };
+
+			size_t spirv_size = 0;
+			size_t optimised_size = 0;
+
+			for (size_t i = 0; i < jobs_.size(); ++i)
+			{
+				const Job& job = jobs_.at(i);
+				int type = static_cast<int>(job.type);
+
+				if (job.worker >= 0 && job.worker < static_cast<int>(num_workers_))
+				{
+					busy.at(job.worker) += job.written - job.started;
+					++count.at(job.worker);
+				}
+
+				if (type < num_types)
+				{
+					read[type] += job.read - job.started;
+					compile[type] += job.compiled - job.read;
+					write[type] += job.written - job.compiled;
+					++files[type];
+				}
+
+				spirv_size += job.spirv_size;
+				optimised_size += job.optimised_size;
+			}
+
+			for (unsigned int i = 0; i < num_workers_; ++i)
+			{
+				snprintf(line, sizeof(line), "  Worker %u: %u file(s), busy %.3f ms, %.1f%% utilised",
+					i + 1, count.at(i), busy.at(i), total_ > 0.0 ? busy.at(i) / total_ * 100.0 : 0.0);
+				lines.push_back(line);
+			}
+
+			for (int i = 0; i < num_types; ++i)
+			{
+				if (files[i] == 0)
+				{
+					continue;
+				}
+
+				snprintf(line, sizeof(line), "  %s: %u file(s), read %.3f ms, compile %.3f ms, write %.3f ms",
+					type_names[i], files[i], read[i], compile[i], write[i]);
+				lines.push_back(line);
+			}
+
+			if (spirv_size > 0)
+			{
+				snprintf(line, sizeof(line), "  Spir-V: %u byte(s), optimised to %u byte(s), %.1f%% smaller",
+					static_cast<unsigned int>(spirv_size),
+					static_cast<unsigned int>(optimised_size),
+					(1.0 - static_cast<double>(optimised_size) / spirv_size) * 100.0);
+				lines.push_back(line);
+			}
+
+			std::vector<const Job*> sorted(jobs_.size());
+			for (size_t i = 0; i < jobs_.size(); ++i)
+			{
+				sorted.at(i) = &jobs_.at(i);
+			}
+
+			size_t listed = std::min(slowest, sorted.size());
+			std::partial_sort(sorted.begin(), sorted.begin() + listed, sorted.end(), [](const Job* a, const Job* b)
+			{
+				return a->written - a->started > b->written - b->started;
+			});
+
+			for (size_t i = 0; i < listed; ++i)
+			{
+				const Job* job = sorted.at(i);
+
+				snprintf(line, sizeof(line), "  %u. %s: %.3f ms (waited %.3f ms, read %.3f ms, compile %.3f ms, write %.3f ms)",
+					static_cast<unsigned int>(i + 1),
+					job->path.c_str(),
+					job->written - job->started,
+					job->started - job->queued,
+					job->read - job->started,
+					job->compiled - job->read,
+					job->written - job->compiled);
+
+				lines.push_back(line);
+			}
+
+			return lines;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		std::string BuildReport::ToJSON() const
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+
+			Statistics s = Compute();
+			char json[512];
+
+			snprintf(json, sizeof(json),
+				"{\"files\":%u,\"failed\":%u,\"workers\":%u,\"ms\":%.3f,\"busy_ms\":%.3f,\"parallelism\":%.3f,\"longest_ms\":%.3f,\"lower_bound_ms\":%.3f}",
+				static_cast<unsigned int>(jobs_.size()),
+				static_cast<unsigned int>(s.failed),
+				num_workers_,
+				total_,
+				s.busy,
+				s.parallelism,
+				s.longest,
+				s.lower_bound);
+
+			return json;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		bool BuildReport::WriteTrace(const std::string& path) const
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+
+			std::ofstream fout(path, std::ios::binary);
+
+			if (fout.is_open() == false)
+			{
+				return false;
+			}
+
+			char event[256];
+			fout << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+			for (unsigned int i = 0; i < num_workers_; ++i)
+			{
+				snprintf(event, sizeof(event), "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"Worker %u\"}}",
+					i == 0 ? "" : ",", i + 1, i + 1);
+
+				fout << event;
+			}
+
+			const char* phases[] = { "read", "compile", "write" };
+
+			for (size_t i = 0; i < jobs_.size(); ++i)
+			{
+				const Job& job = jobs_.at(i);
+				std::string name = Quote(job.path);
+
+				double times[] = { job.started, job.read, job.compiled, job.written };
+
+				for (int j = 0; j < 3; ++j)
+				{
+					snprintf(event, sizeof(event), ",{\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,\"name\":",
+						phases[j], job.worker + 1, times[j] * 1000.0, (times[j + 1] - times[j]) * 1000.0);
+
+					fout << event << name;
+
+					if (job.failed == true)
+					{
+						fout << ",\"args\":{\"failed\":true}";
+					}
+					else if (j == 1 && job.spirv_size > 0)
+					{
+						snprintf(event, sizeof(event), ",\"args\":{\"spirv_bytes\":%u,\"optimised_bytes\":%u}",
+							static_cast<unsigned int>(job.spirv_size), static_cast<unsigned int>(job.optimised_size));
+
+						fout << event;
+					}
+
+					fout << '}';
+				}
+			}
+
+			fout << "]}";
+
+			bool written = fout.good();
+			fout.close();
+
+			return written;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		std::string BuildReport::Quote(const std::string& str)
+		{
+			std::string quoted = "\"";
+			char escaped[8];
+
+			for (size_t i = 0; i < str.size(); ++i)
+			{
+				unsigned char c = static_cast<unsigned char>(str.at(i));
+
+				switch (c)
+				{
+				case '"':
+					quoted += "\\\"";
+					break;
+
+				case '\\':
+					quoted += "\\\\";
+					break;
+
+				case '\n':
+					quoted += "\\n";
+					break;
+
+				case '\r':
+					quoted += "\\r";
+					break;
+
+				case '\t':
+					quoted += "\\t";
+					break;
+
+				default:
+					if (c < 0x20)
+					{
+						snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+						quoted += escaped;
+						break;
+					}
+
+					quoted += static_cast<char>(c);
+					break;
+				}
+			}
+
+			return quoted + '"';
+		}
+	}
+}
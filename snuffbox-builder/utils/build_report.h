@@ -0,0 +1,133 @@
+#pragma once
+
+#include "build_graph.h"
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <chrono>
+
+namespace snuffbox
+{
+	namespace builder
+	{
+		/**
+		* @class snuffbox::builder::BuildReport
+		* @brief Collects the timing of every job in a build, and summarises it or exports it as a Chrome trace
+		* @remarks All times are in milliseconds since the build started
+		* @author Daniel Konings
+		*/
+		class BuildReport
+		{
+
+		public:
+
+			/**
+			* @struct snuffbox::builder::BuildReport::Job
+			* @brief The timing of a single compiled file
+			* @author Daniel Konings
+			*/
+			struct Job
+			{
+				std::string path; //!< The path to the source file
+				BuildGraph::BuildData::FileType type; //!< The type of the file
+				int worker; //!< The ID of the worker thread that compiled the file
+				bool failed; //!< Did compilation fail?
+				double queued; //!< When the job was handed to a worker
+				double started; //!< When the worker started the job
+				double read; //!< When the source was read
+				double compiled; //!< When the source was compiled
+				double written; //!< When the output was written, or when the job failed
+				size_t spirv_size; //!< The size of the Spir-V glslang generated, for shaders
+				size_t optimised_size; //!< The size of the Spir-V after it was optimised for the build profile, for shaders
+			};
+
+			/**
+			* @brief Default constructor
+			*/
+			BuildReport();
+
+			/**
+			* @brief Starts a new report, clearing the previous one
+			* @param[in] num_workers (unsigned int) The number of worker threads in the build
+			*/
+			void Begin(unsigned int num_workers);
+
+			/**
+			* @brief Adds a finished job to the report, this function is thread-safe
+			* @param[in] job (const snuffbox::builder::BuildReport::Job&) The job to add
+			*/
+			void Add(const Job& job);
+
+			/**
+			* @brief Ends the report, recording the total time of the build
+			*/
+			void End();
+
+			/**
+			* @return (double) The milliseconds since the report began
+			*/
+			double Elapsed() const;
+
+			/**
+			* @brief Creates a readable summary of the build
+			* @param[in] slowest (size_t) The number of slowest files to list, default = 10
+			* @return (std::vector<std::string>) The lines of the summary
+			* @remarks This lists the slowest files, the totals per file type, the utilisation of every worker, the parallelism achieved and how much the shaders were optimised
+			*/
+			std::vector<std::string> Summary(size_t slowest = 10) const;
+
+			/**
+			* @brief Writes the statistics of the summary as a single line JSON object
+			* @return (std::string) The JSON object
+			*/
+			std::string ToJSON() const;
+
+			/**
+			* @brief Writes every job as Chrome trace events, which can be opened in chrome://tracing
+			* @param[in] path (const std::string&) The path to write the trace to
+			* @return (bool) Was the trace written succesfully?
+			*/
+			bool WriteTrace(const std::string& path) const;
+
+			/**
+			* @brief Escapes a string so it can be written as a JSON string
+			* @param[in] str (const std::string&) The string to escape
+			* @return (std::string) The escaped string, including quotes
+			*/
+			static std::string Quote(const std::string& str);
+
+			static const char* TRACE_NAME; //!< The file name of the trace in the build directory
+
+		protected:
+
+			/**
+			* @struct snuffbox::builder::BuildReport::Statistics
+			* @brief The statistics that are derived from the jobs of a build
+			* @author Daniel Konings
+			*/
+			struct Statistics
+			{
+				double busy; //!< The total milliseconds the workers were executing jobs
+				double parallelism; //!< The average number of workers that were busy
+				double longest; //!< The milliseconds the longest job took
+				double lower_bound; //!< The shortest the build could have taken, the longest job or the total work spread over every worker
+				size_t failed; //!< The number of failed jobs
+			};
+
+			/**
+			* @return (snuffbox::builder::BuildReport::Statistics) The statistics of the current report
+			*/
+			Statistics Compute() const;
+
+		private:
+
+			std::chrono::high_resolution_clock::time_point start_; //!< When the report began
+			double total_; //!< The total milliseconds the build took
+			unsigned int num_workers_; //!< The number of worker threads
+
+			std::vector<Job> jobs_; //!< The finished jobs
+			mutable std::mutex mutex_; //!< The mutex that guards the jobs
+		};
+	}
+}
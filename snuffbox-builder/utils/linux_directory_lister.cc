@@ -3,96 +3,207 @@
 
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <string.h>
 
+#include <thread>
+#include <algorithm>
+
 namespace snuffbox
 {
 	namespace builder
 	{
 		//-----------------------------------------------------------------------------------------------
-		LinuxDirectoryLister::LinuxDirectoryLister()
+		const unsigned int LinuxDirectoryLister::MAX_THREADS_ = 8;
+
+		//-----------------------------------------------------------------------------------------------
+		LinuxDirectoryLister::LinuxDirectoryLister() :
+			root_(-1),
+			scanning_(0)
 		{
 
 		}
 
 		//-----------------------------------------------------------------------------------------------
-		bool LinuxDirectoryLister::List(const std::string& start_at, bool root)
+		bool LinuxDirectoryLister::List(const std::string& root)
 		{
-			if (root == true)
+			Clear();
+
+			root_ = open(root.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+			if (root_ == -1)
 			{
-				Clear();
+				return false;
 			}
 
-			struct dirent* entry;
-			DIR* dp;
+			pending_.push_back("");
+
+			unsigned int count = std::min(MAX_THREADS_, std::max(1u, std::thread::hardware_concurrency()));
+			std::vector<Scanner> scanners(count);
+			std::vector<std::thread> threads;
+
+			for (unsigned int i = 1; i < count; ++i)
+			{
+				threads.push_back(std::thread(&LinuxDirectoryLister::Scan, this, &scanners.at(i)));
+			}
 
-			std::string new_dir;
+			Scan(&scanners.at(0));
+
+			for (unsigned int i = 0; i < threads.size(); ++i)
+			{
+				threads.at(i).join();
+			}
+
+			close(root_);
+			root_ = -1;
+
+			for (unsigned int i = 0; i < count; ++i)
+			{
+				Scanner& scanner = scanners.at(i);
+
+				arena_.Merge(&scanner.arena);
+				entries_.insert(entries_.end(), scanner.entries.begin(), scanner.entries.end());
+				directories_.insert(directories_.end(), scanner.directories.begin(), scanner.directories.end());
+			}
+
+			std::sort(entries_.begin(), entries_.end(), [](const Entry& a, const Entry& b)
+			{
+				return strcmp(a.path, b.path) < 0;
+			});
+
+			std::sort(directories_.begin(), directories_.end());
+
+			return true;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void LinuxDirectoryLister::Scan(Scanner* scanner)
+		{
 			std::string relative;
 
-			if (root == true)
+			while (true)
 			{
-				root_ = start_at;
+				{
+					std::unique_lock<std::mutex> lock(pending_mutex_);
+					pending_condition_.wait(lock, [this]()
+					{
+						return pending_.empty() == false || scanning_ == 0;
+					});
+
+					if (pending_.empty() == true)
+					{
+						return;
+					}
+
+					relative = std::move(pending_.front());
+					pending_.pop_front();
+
+					++scanning_;
+				}
+
+				ScanDirectory(relative, scanner);
+
+				{
+					std::lock_guard<std::mutex> lock(pending_mutex_);
+					--scanning_;
+				}
+
+				pending_condition_.notify_all();
 			}
-			else
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void LinuxDirectoryLister::ScanDirectory(const std::string& relative, Scanner* scanner)
+		{
+			int fd = relative.empty() == true ?
+				dup(root_) :
+				openat(root_, relative.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+			if (fd == -1)
 			{
-				directories_.push_back(start_at.c_str() + root_.size() + 1);
+				return;
 			}
 
-			dp = opendir(start_at.c_str());
+			DIR* dp = fdopendir(fd);
 
 			if (dp == nullptr)
 			{
-				return false;
+				close(fd);
+				return;
 			}
 
-			entry = readdir(dp);
+			struct dirent* entry;
+			struct stat attributes;
+
+			std::vector<std::string> found;
+			std::string path;
+			Entry file;
 
-			do
+			while ((entry = readdir(dp)) != nullptr)
 			{
 				if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0)
 				{
 					continue;
 				}
 
-				relative = start_at.c_str() + root_.size() + (root == true ? 0 : 1);
+				path = relative.empty() == true ? entry->d_name : relative + '/' + entry->d_name;
+
+				if (entry->d_type == DT_DIR)
+				{
+					found.push_back(path);
+					continue;
+				}
 
-				if (IsDirectory(start_at + "/" + entry->d_name) == true)
+				if (fstatat(fd, entry->d_name, &attributes, 0) != 0)
 				{
-					List(start_at + "/" + entry->d_name, false);
+					continue;
 				}
-				else
+
+				if (S_ISDIR(attributes.st_mode))
 				{
-					if (tree_.find(relative) == tree_.end())
-					{
-						tree_.emplace(relative, std::vector<std::string>());
-					}
+					found.push_back(path);
+					continue;
+				}
 
-					tree_[relative].push_back(entry->d_name);
+				if (S_ISREG(attributes.st_mode) == 0)
+				{
+					continue;
 				}
-			} while ((entry = readdir(dp)) != nullptr);
+
+				file.path = scanner->arena.Copy(path.c_str(), path.size());
+				file.inode = static_cast<uint64_t>(attributes.st_ino);
+				file.size = static_cast<uint64_t>(attributes.st_size);
+				file.mtime = static_cast<int64_t>(attributes.st_mtim.tv_sec) * 1000000000LL + attributes.st_mtim.tv_nsec;
+
+				scanner->entries.push_back(file);
+			}
 
 			closedir(dp);
 
-			return true;
+			if (found.empty() == true)
+			{
+				return;
+			}
+
+			scanner->directories.insert(scanner->directories.end(), found.begin(), found.end());
+
+			{
+				std::lock_guard<std::mutex> lock(pending_mutex_);
+				pending_.insert(pending_.end(), found.begin(), found.end());
+			}
+
+			pending_condition_.notify_all();
 		}
 
 		//-----------------------------------------------------------------------------------------------
 		void LinuxDirectoryLister::CreateDirectories(const std::string& bin)
 		{
 			std::string full_path;
-			std::string dir;
-
-			DIR* dp;
 
 			for (int i = 0; i < directories_.size(); ++i)
 			{
-				dir = directories_.at(i);
-				if (dir == "")
-				{
-					continue;
-				}
-
-				full_path = bin + '/' + dir;
+				full_path = bin + '/' + directories_.at(i);
 				if (DirectoryExists(full_path) == false)
 				{
 					mkdir(full_path.c_str(), S_IRWXU | S_IRWXG | S_IRWXO);
@@ -104,13 +215,14 @@ namespace snuffbox
 		void LinuxDirectoryLister::Clear()
 		{
 			directories_.clear();
-			tree_.clear();
+			entries_.clear();
+			arena_.Clear();
 		}
 
 		//-----------------------------------------------------------------------------------------------
-		const LinuxDirectoryLister::DirectoryTree& LinuxDirectoryLister::tree() const
+		const LinuxDirectoryLister::EntryList& LinuxDirectoryLister::entries() const
 		{
-			return tree_;
+			return entries_;
 		}
 
 		//-----------------------------------------------------------------------------------------------
@@ -126,13 +238,5 @@ namespace snuffbox
 
 			return exists;
 		}
-
-		//-----------------------------------------------------------------------------------------------
-		bool LinuxDirectoryLister::IsDirectory(const std::string& path)
-		{
-			struct stat attrib;
-			stat(path.c_str(), &attrib);
-			return S_ISREG(attrib.st_mode) == 0;
-		}
 	}
 }
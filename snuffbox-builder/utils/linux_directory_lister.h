@@ -1,8 +1,13 @@
 #pragma once
 
-#include <map>
+#include "path_arena.h"
+
 #include <string>
 #include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <inttypes.h>
 
 namespace snuffbox
 {
@@ -11,6 +16,7 @@ namespace snuffbox
 		/**
 		* @class snuffbox::builder::LinuxDirectoryLister
 		* @brief The directory lister for the linux platform
+		* @remarks Directories are scanned in parallel, relative to a descriptor of the root directory, and every file is stat'ed once while listing
 		* @author Daniel Konings
 		*/
 		class LinuxDirectoryLister
@@ -18,7 +24,20 @@ namespace snuffbox
 
 		public:
 
-			typedef std::map<std::string, std::vector<std::string>> DirectoryTree;
+			/**
+			* @struct snuffbox::builder::LinuxDirectoryLister::Entry
+			* @brief A listed file with the attributes it had while listing
+			* @author Daniel Konings
+			*/
+			struct Entry
+			{
+				const char* path; //!< The path relative to the root directory, which lives in the lister's arena
+				uint64_t inode; //!< The inode of the file
+				uint64_t size; //!< The size of the file in bytes
+				int64_t mtime; //!< The last time the file was modified, in nanoseconds since the epoch
+			};
+
+			typedef std::vector<Entry> EntryList;
 
 			/**
 			* @brief Default constructor
@@ -26,12 +45,11 @@ namespace snuffbox
 			LinuxDirectoryLister();
 
 			/**
-			* @brief Start listing all directories and files starting at a root
-			* @param[in] start_at (const std::string&) The root directory to start at
-			* @param[in] root (bool) Is this the root directory? Default = true
+			* @brief Lists all files in a root directory and every directory below it
+			* @param[in] root (const std::string&) The root directory
 			* @return (bool) Was listing the directories a success?
 			*/
-			bool List(const std::string& start_at, bool root = true);
+			bool List(const std::string& root);
 
 			/**
 			* @brief Create the directories that reflect on the source directory in the build directory
@@ -45,12 +63,37 @@ namespace snuffbox
 			void Clear();
 
 			/**
-			* @return (const snuffbox::builder::LinuxDirectoryLister::DirectoryTree&) The directory tree
+			* @return (const snuffbox::builder::LinuxDirectoryLister::EntryList&) The listed files, sorted by path
 			*/
-			const DirectoryTree& tree() const;
+			const EntryList& entries() const;
 
 		protected:
 
+			/**
+			* @struct snuffbox::builder::LinuxDirectoryLister::Scanner
+			* @brief The results of a single scanning thread, which are merged once every directory is scanned
+			* @author Daniel Konings
+			*/
+			struct Scanner
+			{
+				PathArena arena; //!< The arena the paths of the entries live in
+				EntryList entries; //!< The files that were found
+				std::vector<std::string> directories; //!< The directories that were found
+			};
+
+			/**
+			* @brief Takes directories from the pending queue and scans them until every directory is scanned
+			* @param[in] scanner (snuffbox::builder::LinuxDirectoryLister::Scanner*) The results of this thread
+			*/
+			void Scan(Scanner* scanner);
+
+			/**
+			* @brief Scans a single directory, queueing the directories in it
+			* @param[in] relative (const std::string&) The directory, relative to the root directory
+			* @param[in] scanner (snuffbox::builder::LinuxDirectoryLister::Scanner*) The results of this thread
+			*/
+			void ScanDirectory(const std::string& relative, Scanner* scanner);
+
 			/**
 			* @brief Checks if a directory exists
 			* @param[in] path (const std::string&) The path to the directory
@@ -58,19 +101,20 @@ namespace snuffbox
 			*/
 			static bool DirectoryExists(const std::string& path);
 
-			/**
-			* @brief Checks if a path is a directory
-			* @param[in] path (const std::string&) The path to the file or directory
-			* @return (bool) Is this path a directory?
-			*/
-			static bool IsDirectory(const std::string& path);
-
 		private:
 
-			std::string root_; //!< The current root directory
+			int root_; //!< The descriptor of the root directory while listing
+
+			PathArena arena_; //!< The arena the paths of the entries live in
+			EntryList entries_; //!< The listed files
+			std::vector<std::string> directories_; //!< The listed directories, sorted so parents come before their children
+
+			std::deque<std::string> pending_; //!< The directories that still have to be scanned
+			unsigned int scanning_; //!< The number of directories that are being scanned
+			std::mutex pending_mutex_; //!< The mutex that guards the pending directories
+			std::condition_variable pending_condition_; //!< Signaled when directories are queued or the last one was scanned
 
-			DirectoryTree tree_; //!< The directory tree
-			std::vector<std::string> directories_; //!< The directories in chronological order of recursion
+			static const unsigned int MAX_THREADS_; //!< The maximum number of threads to scan with
 		};
 	}
 }
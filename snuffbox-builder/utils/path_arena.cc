@@ -0,0 +1,83 @@
+#include "path_arena.h"
+
+#include <string.h>
+
+namespace snuffbox
+{
+	namespace builder
+	{
+		//-----------------------------------------------------------------------------------------------
+		const size_t PathArena::BLOCK_SIZE_ = 64 * 1024;
+
+		//-----------------------------------------------------------------------------------------------
+		PathArena::PathArena() :
+			used_(0),
+			capacity_(0)
+		{
+
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		const char* PathArena::Copy(const char* path, size_t length)
+		{
+			size_t size = length + 1;
+
+			if (used_ + size > capacity_)
+			{
+				capacity_ = size > BLOCK_SIZE_ ? size : BLOCK_SIZE_;
+				used_ = 0;
+
+				blocks_.push_back(std::unique_ptr<char[]>(new char[capacity_]));
+			}
+
+			char* copy = blocks_.back().get() + used_;
+			used_ += size;
+
+			memcpy(copy, path, length);
+			copy[length] = '\0';
+
+			return copy;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void PathArena::Merge(PathArena* other)
+		{
+			if (other->blocks_.empty() == true)
+			{
+				return;
+			}
+
+			std::unique_ptr<char[]> last;
+
+			if (blocks_.empty() == false)
+			{
+				last = std::move(blocks_.back());
+				blocks_.pop_back();
+			}
+
+			for (size_t i = 0; i < other->blocks_.size(); ++i)
+			{
+				blocks_.push_back(std::move(other->blocks_.at(i)));
+			}
+
+			if (last != nullptr)
+			{
+				blocks_.push_back(std::move(last));
+			}
+			else
+			{
+				used_ = other->used_;
+				capacity_ = other->capacity_;
+			}
+
+			other->Clear();
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void PathArena::Clear()
+		{
+			blocks_.clear();
+			used_ = capacity_ = 0;
+		}
+	}
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+
+namespace snuffbox
+{
+	namespace builder
+	{
+		/**
+		* @class snuffbox::builder::PathArena
+		* @brief Stores null terminated paths in large blocks, so listing a directory tree doesn't allocate per file
+		* @remarks Copied paths stay valid until the arena is cleared, also after merging it into another arena
+		* @author Daniel Konings
+		*/
+		class PathArena
+		{
+
+		public:
+
+			/**
+			* @brief Default constructor
+			*/
+			PathArena();
+
+			/**
+			* @brief Copies a path into the arena
+			* @param[in] path (const char*) The path to copy
+			* @param[in] length (size_t) The length of the path, without null terminator
+			* @return (const char*) The null terminated copy
+			*/
+			const char* Copy(const char* path, size_t length);
+
+			/**
+			* @brief Takes over every block of another arena, the paths of the other arena remain valid
+			* @param[in] other (snuffbox::builder::PathArena*) The arena to take the blocks of, which is left empty
+			*/
+			void Merge(PathArena* other);
+
+			/**
+			* @brief Releases every block, all copied paths become invalid
+			*/
+			void Clear();
+
+		private:
+
+			std::vector<std::unique_ptr<char[]>> blocks_; //!< The allocated blocks
+			size_t used_; //!< The number of bytes used in the last block
+			size_t capacity_; //!< The size of the last block
+
+			static const size_t BLOCK_SIZE_; //!< The size of a block, longer paths get a block of their own
+		};
+	}
+}
@@ -0,0 +1,227 @@
+#include "source_watch.h"
+
+#ifdef SNUFF_LINUX
+	#include <sys/inotify.h>
+	#include <sys/stat.h>
+	#include <poll.h>
+	#include <dirent.h>
+	#include <unistd.h>
+	#include <string.h>
+#endif
+
+namespace snuffbox
+{
+	namespace builder
+	{
+		//-----------------------------------------------------------------------------------------------
+		const unsigned int SourceWatch::SETTLE_TIME_ = 10;
+
+		//-----------------------------------------------------------------------------------------------
+		SourceWatch::SourceWatch()
+#ifdef SNUFF_LINUX
+			: inotify_(-1)
+#endif
+		{
+
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		bool SourceWatch::Start(const std::string& src)
+		{
+			Stop();
+
+#ifdef SNUFF_LINUX
+			inotify_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+			if (inotify_ == -1)
+			{
+				return false;
+			}
+
+			root_ = src;
+
+			if (Watch("") == false)
+			{
+				Stop();
+				return false;
+			}
+
+			return true;
+#else
+			return false;
+#endif
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void SourceWatch::Stop()
+		{
+#ifdef SNUFF_LINUX
+			if (inotify_ != -1)
+			{
+				close(inotify_);
+				inotify_ = -1;
+			}
+
+			descriptors_.clear();
+#endif
+
+			root_.clear();
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		bool SourceWatch::Wait(unsigned int timeout, std::vector<Change>* changes)
+		{
+			changes->clear();
+
+#ifdef SNUFF_LINUX
+			if (inotify_ == -1)
+			{
+				return false;
+			}
+
+			std::map<std::string, bool> changed;
+
+			pollfd fd;
+			fd.fd = inotify_;
+			fd.events = POLLIN;
+
+			int wait = static_cast<int>(timeout);
+			while (poll(&fd, 1, wait) > 0)
+			{
+				if (ReadEvents(&changed) == false)
+				{
+					return false;
+				}
+
+				wait = static_cast<int>(SETTLE_TIME_);
+			}
+
+			Change change;
+			for (std::map<std::string, bool>::const_iterator it = changed.begin(); it != changed.end(); ++it)
+			{
+				change.path = it->first;
+				change.removed = it->second;
+
+				changes->push_back(change);
+			}
+
+			return true;
+#else
+			return false;
+#endif
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		bool SourceWatch::is_active() const
+		{
+#ifdef SNUFF_LINUX
+			return inotify_ != -1;
+#else
+			return false;
+#endif
+		}
+
+#ifdef SNUFF_LINUX
+		//-----------------------------------------------------------------------------------------------
+		bool SourceWatch::Watch(const std::string& relative)
+		{
+			std::string full_path = relative.empty() == true ? root_ : root_ + '/' + relative;
+
+			int descriptor = inotify_add_watch(inotify_, full_path.c_str(),
+				IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_CREATE | IN_DELETE | IN_DELETE_SELF | IN_ONLYDIR);
+
+			if (descriptor == -1)
+			{
+				return false;
+			}
+
+			descriptors_[descriptor] = relative;
+
+			DIR* dp = opendir(full_path.c_str());
+
+			if (dp == nullptr)
+			{
+				return false;
+			}
+
+			struct dirent* entry;
+			struct stat attributes;
+			std::string child;
+
+			bool success = true;
+			while (success == true && (entry = readdir(dp)) != nullptr)
+			{
+				if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0)
+				{
+					continue;
+				}
+
+				child = relative.empty() == true ? entry->d_name : relative + '/' + entry->d_name;
+
+				bool directory = entry->d_type == DT_DIR;
+
+				if (entry->d_type == DT_UNKNOWN)
+				{
+					directory = stat((root_ + '/' + child).c_str(), &attributes) == 0 && S_ISDIR(attributes.st_mode);
+				}
+
+				if (directory == true)
+				{
+					success = Watch(child);
+				}
+			}
+
+			closedir(dp);
+
+			return success;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		bool SourceWatch::ReadEvents(std::map<std::string, bool>* changes)
+		{
+			alignas(inotify_event) char buffer[4096];
+
+			while (true)
+			{
+				ssize_t length = read(inotify_, buffer, sizeof(buffer));
+
+				if (length <= 0)
+				{
+					return true;
+				}
+
+				for (char* ptr = buffer; ptr < buffer + length; ptr += sizeof(inotify_event) + reinterpret_cast<inotify_event*>(ptr)->len)
+				{
+					const inotify_event* evt = reinterpret_cast<const inotify_event*>(ptr);
+
+					if ((evt->mask & (IN_Q_OVERFLOW | IN_DELETE_SELF | IN_IGNORED)) != 0)
+					{
+						return false;
+					}
+
+					if ((evt->mask & IN_ISDIR) != 0)
+					{
+						return false;
+					}
+
+					std::map<int, std::string>::const_iterator it = descriptors_.find(evt->wd);
+
+					if (it == descriptors_.end() || evt->len == 0 || (evt->mask & IN_CREATE) != 0)
+					{
+						continue;
+					}
+
+					std::string path = it->second.empty() == true ? evt->name : it->second + '/' + evt->name;
+					(*changes)[path] = (evt->mask & (IN_DELETE | IN_MOVED_FROM)) != 0;
+				}
+			}
+		}
+#endif
+
+		//-----------------------------------------------------------------------------------------------
+		SourceWatch::~SourceWatch()
+		{
+			Stop();
+		}
+	}
+}
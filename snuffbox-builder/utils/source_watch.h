@@ -0,0 +1,103 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace snuffbox
+{
+	namespace builder
+	{
+		/**
+		* @class snuffbox::builder::SourceWatch
+		* @brief Watches the source directory for files that were written, moved or removed, so the build graph can be kept in sync without relisting it
+		* @remarks On Linux every directory in the source tree is watched with inotify, elsewhere the watch can't be started and the builder polls instead
+		* @author Daniel Konings
+		*/
+		class SourceWatch
+		{
+
+		public:
+
+			/**
+			* @struct snuffbox::builder::SourceWatch::Change
+			* @brief A file in the source directory that changed
+			* @author Daniel Konings
+			*/
+			struct Change
+			{
+				std::string path; //!< The path to the file, relative to the source directory
+				bool removed; //!< Was the file removed or moved away?
+			};
+
+			/**
+			* @brief Default constructor
+			*/
+			SourceWatch();
+
+			/**
+			* @brief Remove copy constructor
+			*/
+			SourceWatch(const SourceWatch& other) = delete;
+
+			/**
+			* @brief Starts watching every directory in a source tree, any previous watch is stopped first
+			* @param[in] src (const std::string&) The source directory
+			* @return (bool) Was the watch started? This is always false on platforms without inotify
+			*/
+			bool Start(const std::string& src);
+
+			/**
+			* @brief Stops watching the source tree
+			*/
+			void Stop();
+
+			/**
+			* @brief Waits for changes in the source tree and collects them
+			* @param[in] timeout (unsigned int) The maximum number of milliseconds to wait for the first change
+			* @param[out] changes (std::vector<snuffbox::builder::SourceWatch::Change>*) The changed files, every file is listed once
+			* @return (bool) Could the changes be collected? If not, events were lost or a directory was added or removed, and the whole tree should be synced again
+			*/
+			bool Wait(unsigned int timeout, std::vector<Change>* changes);
+
+			/**
+			* @return (bool) Is the source tree being watched?
+			*/
+			bool is_active() const;
+
+			/**
+			* @brief Default destructor, stops watching
+			*/
+			~SourceWatch();
+
+		protected:
+
+#ifdef SNUFF_LINUX
+			/**
+			* @brief Adds a watch to a directory and every directory below it
+			* @param[in] relative (const std::string&) The directory, relative to the source directory
+			* @return (bool) Were all directories watched succesfully?
+			*/
+			bool Watch(const std::string& relative);
+
+			/**
+			* @brief Reads all pending inotify events
+			* @param[out] changes (std::map<std::string, bool>*) The changed files, by relative path, with whether they were removed
+			* @return (bool) Could the changes be collected?
+			*/
+			bool ReadEvents(std::map<std::string, bool>* changes);
+#endif
+
+		private:
+
+			std::string root_; //!< The source directory that is watched
+
+#ifdef SNUFF_LINUX
+			int inotify_; //!< The inotify instance, or -1 if the watch is not active
+			std::map<int, std::string> descriptors_; //!< The watched directories, relative to the source directory, by watch descriptor
+#endif
+
+			static const unsigned int SETTLE_TIME_; //!< The milliseconds to keep collecting events after the first one, so a single save is handled in one batch
+		};
+	}
+}
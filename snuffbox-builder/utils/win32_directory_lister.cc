@@ -24,6 +24,7 @@ namespace snuffbox
 			DWORD error = 0;
 			std::string new_dir;
 			std::string relative;
+			std::string path;
 			
 			if (root == true)
 			{
@@ -56,12 +57,19 @@ namespace snuffbox
 				}
 				else
 				{
-					if (tree_.find(relative) == tree_.end())
-					{
-						tree_.emplace(relative, std::vector<std::string>());
-					}
+					path = relative.empty() == true ? ffd.cFileName : relative + '/' + ffd.cFileName;
 
-					tree_[relative].push_back(ffd.cFileName);
+					ULARGE_INTEGER time;
+					time.LowPart = ffd.ftLastWriteTime.dwLowDateTime;
+					time.HighPart = ffd.ftLastWriteTime.dwHighDateTime;
+
+					Entry entry;
+					entry.path = arena_.Copy(path.c_str(), path.size());
+					entry.inode = 0;
+					entry.size = (static_cast<uint64_t>(ffd.nFileSizeHigh) << 32) | ffd.nFileSizeLow;
+					entry.mtime = static_cast<int64_t>(time.QuadPart - 116444736000000000ULL) * 100LL;
+
+					entries_.push_back(entry);
 				}
 			} while (FindNextFileA(current, &ffd) != 0);
 
@@ -94,13 +102,14 @@ namespace snuffbox
 		void Win32DirectoryLister::Clear()
 		{
 			directories_.clear();
-			tree_.clear();
+			entries_.clear();
+			arena_.Clear();
 		}
 
 		//-----------------------------------------------------------------------------------------------
-		const Win32DirectoryLister::DirectoryTree& Win32DirectoryLister::tree() const
+		const Win32DirectoryLister::EntryList& Win32DirectoryLister::entries() const
 		{
-			return tree_;
+			return entries_;
 		}
 
 		//-----------------------------------------------------------------------------------------------
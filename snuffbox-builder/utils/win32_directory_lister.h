@@ -1,8 +1,10 @@
 #pragma once
 
+#include "path_arena.h"
+
 #include <vector>
 #include <string>
-#include <map>
+#include <inttypes.h>
 
 namespace snuffbox
 {
@@ -18,7 +20,20 @@ namespace snuffbox
 
 		public:
 
-			typedef std::map<std::string, std::vector<std::string>> DirectoryTree;
+			/**
+			* @struct snuffbox::builder::Win32DirectoryLister::Entry
+			* @brief A listed file with the attributes it had while listing
+			* @author Daniel Konings
+			*/
+			struct Entry
+			{
+				const char* path; //!< The path relative to the root directory, which lives in the lister's arena
+				uint64_t inode; //!< Always 0, as Windows doesn't report a file index while listing
+				uint64_t size; //!< The size of the file in bytes
+				int64_t mtime; //!< The last time the file was modified, in nanoseconds since the epoch
+			};
+
+			typedef std::vector<Entry> EntryList;
 
 			/**
 			* @brief Default constructor
@@ -45,9 +60,9 @@ namespace snuffbox
 			void Clear();
 
 			/**
-			* @return (const snuffbox::builder::Win32DirectoryLister::DirectoryTree&) The directory tree
+			* @return (const snuffbox::builder::Win32DirectoryLister::EntryList&) The listed files
 			*/
-			const DirectoryTree& tree() const;
+			const EntryList& entries() const;
 
 		protected:
 
@@ -62,7 +77,8 @@ namespace snuffbox
 
 			std::string root_; //!< The current root directory
 
-			DirectoryTree tree_; //!< The directory tree
+			PathArena arena_; //!< The arena the paths of the entries live in
+			EntryList entries_; //!< The listed files
 			std::vector<std::string> directories_; //!< The directories in chronological order of recursion
 		};
 	}
@@ -12,6 +12,7 @@ namespace snuffbox
 			allocator_(allocation),
 			deallocator_(deallocation),
 			data_(nullptr),
+			view_(nullptr),
 			error_message_(nullptr)
 		{
 			
@@ -36,18 +37,21 @@ namespace snuffbox
 		}
 
 		//-----------------------------------------------------------------------------------------------
-		bool Compiler::Decompile(const unsigned char* input, const unsigned char** output, size_t* out_size, const unsigned char* userdata)
+		bool Compiler::Decompile(const unsigned char* input, size_t size, const unsigned char** output, size_t* out_size, const unsigned char* userdata)
 		{
 			if (data_ != nullptr)
 			{
 				Deallocate(data_);
+				data_ = nullptr;
 			}
 
-			bool success = Decompilation(input, out_size, userdata);
+			view_ = nullptr;
+
+			bool success = input != nullptr && Decompilation(input, size, out_size, userdata);
 
 			if (output != nullptr)
 			{
-				*output = success == true ? data_ : nullptr;
+				*output = success == true ? (data_ != nullptr ? data_ : view_) : nullptr;
 			}
 
 			return success;
@@ -120,8 +124,14 @@ namespace snuffbox
 		}
 
 		//-----------------------------------------------------------------------------------------------
-		bool Compiler::GetFileHeader(const unsigned char* data, Magic file_type, FileHeader* out)
+		bool Compiler::GetFileHeader(const unsigned char* data, size_t size, Magic file_type, FileHeader* out)
 		{
+			if (size < sizeof(FileHeader))
+			{
+				SetError("File is too small to contain a file header");
+				return false;
+			}
+
 			const FileHeader* header = reinterpret_cast<const FileHeader*>(data);
 			if (header->magic != Magic::kSnuffboxFile || header->file_type != file_type)
 			{
@@ -129,6 +139,12 @@ namespace snuffbox
 				return false;
 			}
 
+			if (header->file_size > size - sizeof(FileHeader))
+			{
+				SetError("File is smaller than its header specifies");
+				return false;
+			}
+
 			if (out != nullptr)
 			{
 				*out = *header;
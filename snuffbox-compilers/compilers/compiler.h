@@ -53,11 +53,11 @@ namespace snuffbox
 
 			/**
 			* @see snuffbox::compiler::Compiler::Decompilation
-			* @param[out] output (const unsigned char**) The decompiled data
+			* @param[out] output (const unsigned char**) The decompiled data, which can be a view into the input that lives as long as the input does
 			* @param[out] out_size (size_t*) The output size
 			* @remarks Makes sure snuffbox::compiler::Compiler::data_ is freed up before re-use
 			*/
-			bool Decompile(const unsigned char* input, const unsigned char** output, size_t* out_size, const unsigned char* userdata);
+			bool Decompile(const unsigned char* input, size_t size, const unsigned char** output, size_t* out_size, const unsigned char* userdata);
 
 			/**
 			* @return (const char*) The current error of the compiler, or nullptr if there is none
@@ -101,11 +101,14 @@ namespace snuffbox
 			/**
 			* @brief Decompile compiled binary data into a raw binary format
 			* @param[in] input (const unsigned char*) The compiled data to decompile into the raw binary format
+			* @param[in] size (size_t) The input size
+			* @param[out] out_size (size_t*) The output size
 			* @param[in] userdata (const unsigned char*) User data to pass into the different compilers
 			* @return (bool) Was the decompilation a success?
-			* @remarks snuffbox::compilers::Compiler::Allocate should be used to allocate the memory for 'out'
+			* @remarks snuffbox::compilers::Compiler::Allocate should be used to allocate the memory for 'out', 
+			* unless the output is a part of the input as-is, in which case snuffbox::compilers::Compiler::view_ can point into the input instead
 			*/
-			virtual bool Decompilation(const unsigned char* input, size_t* out_size, const unsigned char* userdata) = 0;
+			virtual bool Decompilation(const unsigned char* input, size_t size, size_t* out_size, const unsigned char* userdata) = 0;
 
 			/**
 			* @brief Sets the current error message of the compiler
@@ -116,11 +119,12 @@ namespace snuffbox
 			/**
 			* @brief Retrieves the file header from input data
 			* @param[in] input (const unsigned char*) The data to retrieve the file header from
+			* @param[in] size (size_t) The size of the data, which should fit the header and the file size it specifies
 			* @param[in] file_type (snuffbox::compilers::Magic) The expected file type to compare to the 'magic' field of the file header
 			* @param[out] out (snuffbox::compilers::Compiler::FileHeader*) The output value
 			* @return (bool) Does the raw data contain a file header?
 			*/
-			bool GetFileHeader(const unsigned char* input, Magic file_type, FileHeader* out);
+			bool GetFileHeader(const unsigned char* input, size_t size, Magic file_type, FileHeader* out);
 
 			/**
 			* @brief Creates a file header containing information about the file
@@ -137,6 +141,7 @@ namespace snuffbox
 		protected:
 
 			unsigned char* data_; //!< The currently allocated data (compiled or raw)
+			const unsigned char* view_; //!< The decompiled data when it is a view into the input, instead of allocated data
 			char* error_message_; //!< The error message of the compiler, if any
 		};
 	}
@@ -1,5 +1,6 @@
 #include "script_compiler.h"
 #include "../utils/rc4.h"
+#include "../utils/hash.h"
 
 #include <memory>
 #include <string.h>
@@ -8,6 +9,9 @@ namespace snuffbox
 {
 	namespace compilers
 	{
+		//-----------------------------------------------------------------------------------------------
+		const uint32_t ScriptCompiler::VERSION = 1;
+
 		//-----------------------------------------------------------------------------------------------
 		ScriptCompiler::ScriptCompiler(Compiler::Allocation allocator, Compiler::Deallocation deallocator) :
 			Compiler(allocator, deallocator)
@@ -15,6 +19,13 @@ namespace snuffbox
 
 		}
 
+		//-----------------------------------------------------------------------------------------------
+		uint64_t ScriptCompiler::Fingerprint()
+		{
+			uint64_t hash = Hash::FNV1a(&VERSION, sizeof(uint32_t));
+			return Hash::FNV1a(SNUFF_ENCRYPTION_KEY, strlen(SNUFF_ENCRYPTION_KEY), hash);
+		}
+
 		//-----------------------------------------------------------------------------------------------
 		bool ScriptCompiler::Compilation(const unsigned char* input, size_t size, size_t* out_size, const unsigned char* userdata)
 		{
@@ -44,10 +55,10 @@ namespace snuffbox
 		}
 
 		//-----------------------------------------------------------------------------------------------
-		bool ScriptCompiler::Decompilation(const unsigned char* input, size_t* out_size, const unsigned char* userdata)
+		bool ScriptCompiler::Decompilation(const unsigned char* input, size_t size, size_t* out_size, const unsigned char* userdata)
 		{
 			FileHeader header;
-			if (GetFileHeader(input, Magic::kScript, &header) == false)
+			if (GetFileHeader(input, size, Magic::kScript, &header) == false)
 			{
 				return false;
 			}
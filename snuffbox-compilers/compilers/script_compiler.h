@@ -21,6 +21,13 @@ namespace snuffbox
 			*/
 			ScriptCompiler(Allocation allocator = nullptr, Deallocation deallocator = nullptr);
 
+			/**
+			* @brief Hashes the version of the compiler and the options it compiles with, which includes the encryption key
+			* @return (uint64_t) The fingerprint, compiled files should be rebuilt when it changes
+			*/
+			static uint64_t Fingerprint();
+
+			static const uint32_t VERSION; //!< The version of the script compiler, bump this when its output changes
 
 		protected:
 
@@ -32,7 +39,7 @@ namespace snuffbox
 			/**
 			* @see snuffbox::compilers::Compiler::Decompilation
 			*/
-			bool Decompilation(const unsigned char* input, size_t* out_size, const unsigned char* userdata) override;
+			bool Decompilation(const unsigned char* input, size_t size, size_t* out_size, const unsigned char* userdata) override;
 		};
 	}
 }
\ No newline at end of file
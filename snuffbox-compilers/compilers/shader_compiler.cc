@@ -1,15 +1,53 @@
 #include "shader_compiler.h"
 #include "../utils/glslang_validator.h"
+#include "../utils/hash.h"
 
 namespace snuffbox
 {
 	namespace compilers
 	{
+		//-----------------------------------------------------------------------------------------------
+		const uint32_t ShaderCompiler::VERSION = 1;
+
 		//-----------------------------------------------------------------------------------------------
 		ShaderCompiler::ShaderCompiler(Allocation allocator, Deallocation deallocator) :
-			Compiler(allocator, deallocator)
+			Compiler(allocator, deallocator),
+			profile_(Profile::kDebug),
+			spirv_size_(0),
+			optimised_size_(0)
+		{
+
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void ShaderCompiler::set_profile(Profile profile)
+		{
+			profile_ = profile;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		const ShaderCompiler::Profile& ShaderCompiler::profile() const
+		{
+			return profile_;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		const size_t& ShaderCompiler::spirv_size() const
+		{
+			return spirv_size_;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		const size_t& ShaderCompiler::optimised_size() const
 		{
+			return optimised_size_;
+		}
 
+		//-----------------------------------------------------------------------------------------------
+		uint64_t ShaderCompiler::Fingerprint(Profile profile)
+		{
+			uint64_t hash = Hash::FNV1a(&VERSION, sizeof(uint32_t));
+			return Hash::FNV1a(&profile, sizeof(Profile), hash);
 		}
 
 		//-----------------------------------------------------------------------------------------------
@@ -31,14 +69,20 @@ namespace snuffbox
 			unsigned char* bin = nullptr;
 			size_t bin_size;
 
+			spirv_size_ = optimised_size_ = 0;
+
 			GLSLangValidator validator;
+			GLSLangValidator::ShaderType shader_type = static_cast<GLSLangValidator::ShaderType>(type);
 
-			if (validator.Compile(reinterpret_cast<const char*>(input), size, full_path, static_cast<GLSLangValidator::ShaderType>(type), &bin_size, &bin) == false)
+			if (validator.Compile(reinterpret_cast<const char*>(input), size, full_path, shader_type, profile_ == Profile::kRelease, &bin_size, &bin) == false)
 			{
 				SetError(validator.GetError());
 				return false;
 			}
 
+			spirv_size_ = validator.GetUnoptimisedSize();
+			optimised_size_ = bin_size;
+
 			const size_t header_size = sizeof(Compiler::FileHeader);
 			const size_t shader_header_size = sizeof(ShaderCompiler::Header);
 
@@ -65,11 +109,11 @@ namespace snuffbox
 		}
 
 		//-----------------------------------------------------------------------------------------------
-		bool ShaderCompiler::Decompilation(const unsigned char* input, size_t* out_size, const unsigned char* userdata)
+		bool ShaderCompiler::Decompilation(const unsigned char* input, size_t size, size_t* out_size, const unsigned char* userdata)
 		{
 			Compiler::FileHeader header;
 			
-			if (GetFileHeader(input, Magic::kShader, &header) == false)
+			if (GetFileHeader(input, size, Magic::kShader, &header) == false)
 			{
 				return false;
 			}
@@ -77,8 +121,7 @@ namespace snuffbox
 			const size_t s = header.file_size;
 
 #ifdef SNUFF_USE_VULKAN
-			data_ = Allocate(s);
-			memcpy(data_, input + sizeof(FileHeader), s);
+			view_ = input + sizeof(FileHeader);
 #else
 			SetError("No implementation provided for shaders for this type of renderer");
 			return false;
@@ -27,11 +27,50 @@ namespace snuffbox
 				char type; //!< The type of the shader
 			};
 
+			/**
+			* @brief The build profiles shaders can be compiled with
+			*/
+			enum struct Profile : char
+			{
+				kDebug, //!< The Spir-V is written as glslang generates it, including debug names
+				kRelease //!< Dead code is removed, loads and stores are optimised and debug information is stripped
+			};
+
 			/**
 			* @see snuffbox::compilers::Compiler::Compiler
 			*/
 			ShaderCompiler(Allocation allocator = nullptr, Deallocation deallocator = nullptr);
 
+			/**
+			* @brief Sets the profile to compile with
+			* @param[in] profile (snuffbox::compilers::ShaderCompiler::Profile) The profile
+			*/
+			void set_profile(Profile profile);
+
+			/**
+			* @return (const snuffbox::compilers::ShaderCompiler::Profile&) The profile shaders are compiled with, default = kDebug
+			*/
+			const Profile& profile() const;
+
+			/**
+			* @return (const size_t&) The size of the Spir-V of the last compiled shader, as glslang generated it
+			*/
+			const size_t& spirv_size() const;
+
+			/**
+			* @return (const size_t&) The size of the Spir-V of the last compiled shader, after it was optimised for the profile
+			*/
+			const size_t& optimised_size() const;
+
+			/**
+			* @brief Hashes the version of the compiler and the options it compiles with
+			* @param[in] profile (snuffbox::compilers::ShaderCompiler::Profile) The profile that is compiled with
+			* @return (uint64_t) The fingerprint, compiled files should be rebuilt when it changes
+			*/
+			static uint64_t Fingerprint(Profile profile);
+
+			static const uint32_t VERSION; //!< The version of the shader compiler, bump this when its output or the compile options change
+
 		protected:
 
 			/**
@@ -43,7 +82,7 @@ namespace snuffbox
 			/**
 			* @see snuffbox::compilers::Compiler::Decompilation
 			*/
-			bool Decompilation(const unsigned char* input, size_t* out_size, const unsigned char* userdata) override;
+			bool Decompilation(const unsigned char* input, size_t size, size_t* out_size, const unsigned char* userdata) override;
 
 			/**
 			* @brief Retrieves the shader type from an extension
@@ -51,6 +90,12 @@ namespace snuffbox
 			* @return (char) The GLSLangValidator shader type
 			*/
 			static char GetShaderTypeFromExtension(const char* path);
+
+		private:
+
+			Profile profile_; //!< The profile shaders are compiled with
+			size_t spirv_size_; //!< The size of the Spir-V of the last compiled shader
+			size_t optimised_size_; //!< The size of the optimised Spir-V of the last compiled shader
 		};
 	}
 }
\ No newline at end of file
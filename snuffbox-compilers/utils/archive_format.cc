@@ -0,0 +1,117 @@
+#include "archive_format.h"
+#include "hash.h"
+
+#include <string.h>
+
+namespace snuffbox
+{
+	namespace compilers
+	{
+		//-----------------------------------------------------------------------------------------------
+		const uint32_t ArchiveFormat::VERSION = 1;
+		const uint64_t ArchiveFormat::ALIGNMENT = 16;
+
+		//-----------------------------------------------------------------------------------------------
+		uint64_t ArchiveFormat::Hash(const char* path, size_t length)
+		{
+			return compilers::Hash::FNV1a(path, length);
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		uint32_t ArchiveFormat::Capacity(uint32_t count)
+		{
+			uint32_t capacity = 1;
+
+			while (capacity < count * 2)
+			{
+				capacity <<= 1;
+			}
+
+			return capacity;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		bool ArchiveFormat::Validate(const unsigned char* data, size_t size)
+		{
+			if (data == nullptr || size < sizeof(Header))
+			{
+				return false;
+			}
+
+			const Header* header = reinterpret_cast<const Header*>(data);
+
+			if (header->magic != Magic::kArchive || header->version != VERSION || header->size != size)
+			{
+				return false;
+			}
+
+			if (header->capacity == 0 || (header->capacity & (header->capacity - 1)) != 0)
+			{
+				return false;
+			}
+
+			uint64_t table_end = sizeof(Header) + static_cast<uint64_t>(header->capacity) * sizeof(Entry);
+
+			if (table_end > header->paths_offset || header->paths_offset > size)
+			{
+				return false;
+			}
+
+			const Entry* table = reinterpret_cast<const Entry*>(data + sizeof(Header));
+			uint64_t paths_size = size - header->paths_offset;
+			uint32_t count = 0;
+
+			for (uint32_t i = 0; i < header->capacity; ++i)
+			{
+				const Entry& entry = table[i];
+
+				if (entry.path_length == 0)
+				{
+					continue;
+				}
+
+				if (entry.path_offset > paths_size || entry.path_length > paths_size - entry.path_offset)
+				{
+					return false;
+				}
+
+				if (entry.offset < header->paths_offset || entry.offset >= size || entry.size >= size - entry.offset || data[entry.offset + entry.size] != '\0')
+				{
+					return false;
+				}
+
+				++count;
+			}
+
+			return count == header->count && count < header->capacity;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		const ArchiveFormat::Entry* ArchiveFormat::Find(const unsigned char* data, const char* path, size_t length)
+		{
+			const Header* header = reinterpret_cast<const Header*>(data);
+			const Entry* table = reinterpret_cast<const Entry*>(data + sizeof(Header));
+			const char* paths = reinterpret_cast<const char*>(data + header->paths_offset);
+
+			uint64_t hash = Hash(path, length);
+			uint32_t mask = header->capacity - 1;
+
+			for (uint32_t i = 0; i < header->capacity; ++i)
+			{
+				const Entry& entry = table[(hash + i) & mask];
+
+				if (entry.path_length == 0)
+				{
+					return nullptr;
+				}
+
+				if (entry.hash == hash && entry.path_length == length && memcmp(paths + entry.path_offset, path, length) == 0)
+				{
+					return &entry;
+				}
+			}
+
+			return nullptr;
+		}
+	}
+}
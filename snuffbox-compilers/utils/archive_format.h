@@ -0,0 +1,100 @@
+#pragma once
+
+#include <inttypes.h>
+#include <stddef.h>
+
+#include "magic.h"
+
+namespace snuffbox
+{
+	namespace compilers
+	{
+		/**
+		* @class snuffbox::compilers::ArchiveFormat
+		* @brief The layout of a packed content archive, shared by the builder that writes it and the engine that maps it
+		* @remarks An archive is a header, followed by an open-addressed hash table of entries, a table of paths and the aligned entry data
+		* @author Daniel Konings
+		*/
+		class ArchiveFormat
+		{
+
+		public:
+
+			/**
+			* @brief The different flags an entry can have
+			*/
+			enum EntryFlags : uint32_t
+			{
+				kNone = 0x0, //!< The entry is stored as-is
+				kCompressed = 0x1 //!< The entry is compressed and has to be inflated before use
+			};
+
+			/**
+			* @struct snuffbox::compilers::ArchiveFormat::Header
+			* @brief The header at the start of every archive
+			* @author Daniel Konings
+			*/
+			struct Header
+			{
+				Magic magic; //!< Should be snuffbox::compilers::Magic::kArchive
+				uint32_t version; //!< The version of the format the archive was written with
+				uint32_t count; //!< The number of entries in the archive
+				uint32_t capacity; //!< The number of slots in the hash table, always a power of two
+				uint64_t paths_offset; //!< The offset of the path table from the start of the archive
+				uint64_t size; //!< The total size of the archive in bytes
+			};
+
+			/**
+			* @struct snuffbox::compilers::ArchiveFormat::Entry
+			* @brief A single slot in the hash table, slots without a path are empty
+			* @author Daniel Konings
+			*/
+			struct Entry
+			{
+				uint64_t hash; //!< The hash of the entry's path
+				uint64_t offset; //!< The offset of the entry's data from the start of the archive
+				uint64_t size; //!< The size of the entry's data, excluding the padding
+				uint32_t path_offset; //!< The offset of the path in the path table
+				uint16_t path_length; //!< The length of the path, 0 for an empty slot
+				uint16_t flags; //!< The snuffbox::compilers::ArchiveFormat::EntryFlags of the entry
+			};
+
+			/**
+			* @brief Hashes a path with 64-bit FNV-1a
+			* @param[in] path (const char*) The path to hash, relative to the build directory with forward slashes
+			* @param[in] length (size_t) The length of the path
+			* @return (uint64_t) The hashed path
+			*/
+			static uint64_t Hash(const char* path, size_t length);
+
+			/**
+			* @brief Calculates the number of hash table slots for a number of entries, keeping the load factor at or under a half
+			* @param[in] count (uint32_t) The number of entries
+			* @return (uint32_t) The number of slots, a power of two
+			*/
+			static uint32_t Capacity(uint32_t count);
+
+			/**
+			* @brief Checks if a block of memory holds a valid archive of the current version
+			* @param[in] data (const unsigned char*) The archive data
+			* @param[in] size (size_t) The size of the archive data
+			* @remarks Every occupied entry is checked to lie within the archive, with its data followed by a zero byte and its path within the path table,
+			* so that a truncated or corrupt archive is rejected when it is mounted instead of being read out of bounds by Find
+			* @return (bool) Is the archive valid?
+			*/
+			static bool Validate(const unsigned char* data, size_t size);
+
+			/**
+			* @brief Looks up an entry in a validated archive by probing its hash table
+			* @param[in] data (const unsigned char*) The archive data
+			* @param[in] path (const char*) The path of the entry, relative to the build directory with forward slashes
+			* @param[in] length (size_t) The length of the path
+			* @return (const snuffbox::compilers::ArchiveFormat::Entry*) The found entry, or nullptr if it is not in the archive
+			*/
+			static const Entry* Find(const unsigned char* data, const char* path, size_t length);
+
+			static const uint32_t VERSION; //!< The current version of the archive format
+			static const uint64_t ALIGNMENT; //!< The alignment of every entry's data, at least one byte of zero padding follows each entry
+		};
+	}
+}
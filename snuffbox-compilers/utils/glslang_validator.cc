@@ -5,6 +5,9 @@
 #include <glslang/OSDependent/osinclude.h>
 #include <fstream>
 #include <SPIRV/disassemble.h>
+#include <SPIRV/doc.h>
+#include <SPIRV/SPVRemapper.h>
+#include <OGLCompilersDLL/InitializeDll.h>
 
 #include <mutex>
 
@@ -13,7 +16,13 @@ namespace snuffbox
 	namespace compilers
 	{
 		//-----------------------------------------------------------------------------------------------
-		std::mutex GLSLangValidator::GLSLANG_MUTEX_;
+		std::mutex GLSLangValidator::PROCESS_MUTEX_;
+
+		//-----------------------------------------------------------------------------------------------
+		bool GLSLangValidator::INITIALISED_ = false;
+
+		//-----------------------------------------------------------------------------------------------
+		thread_local std::string GLSLangValidator::REMAP_ERROR_;
 
 		//-----------------------------------------------------------------------------------------------
 		GLSLangValidator::Includer::Includer(const char* directory) :
@@ -63,22 +72,29 @@ namespace snuffbox
 		//-----------------------------------------------------------------------------------------------
 		GLSLangValidator::GLSLangValidator() :
 			error_(""),
-			buffer_(nullptr)
+			buffer_(nullptr),
+			unoptimised_size_(0)
 		{
 			
 		}
 
 		//-----------------------------------------------------------------------------------------------
-		bool GLSLangValidator::Compile(const char* hlsl, size_t length, const char* filename, ShaderType type, size_t* converted_size, unsigned char** spirv)
+		bool GLSLangValidator::Compile(const char* hlsl, size_t length, const char* filename, ShaderType type, bool optimise, size_t* converted_size, unsigned char** spirv)
 		{
-			std::lock_guard<std::mutex> lock(GLSLANG_MUTEX_);
-
 			if (buffer_ != nullptr)
 			{
 				delete[] buffer_;
 				buffer_ = nullptr;
 			}
 
+			unoptimised_size_ = 0;
+
+			if (InitialiseThread() == false)
+			{
+				error_ = "Could not initialise glslang for the compiling thread";
+				return false;
+			}
+
 			EShLanguage lang;
 
 			switch (type)
@@ -181,6 +197,29 @@ namespace snuffbox
 			spv::SpvBuildLogger logger;
 
 			glslang::GlslangToSpv(*program.getIntermediate(lang), spv, &logger);
+
+			unoptimised_size_ = spv.size() * 4;
+
+			if (optimise == true)
+			{
+				const uint32_t options = 
+					spv::spirvbin_t::DCE_ALL | 
+					spv::spirvbin_t::OPT_ALL | 
+					spv::spirvbin_t::STRIP;
+
+				REMAP_ERROR_.clear();
+
+				spv::spirvbin_t remapper;
+				remapper.remap(spv, options);
+
+				if (REMAP_ERROR_.empty() == false)
+				{
+					error_ = "Could not optimise shader\n\n";
+					error_ += REMAP_ERROR_;
+
+					return Failed();
+				}
+			}
 			
 			size_t s = spv.size() * 4;
 
@@ -207,6 +246,12 @@ namespace snuffbox
 			return error_.c_str();
 		}
 
+		//-----------------------------------------------------------------------------------------------
+		size_t GLSLangValidator::GetUnoptimisedSize() const
+		{
+			return unoptimised_size_;
+		}
+
 		//-----------------------------------------------------------------------------------------------
 		GLSLangValidator::~GLSLangValidator()
 		{
@@ -251,13 +296,57 @@ namespace snuffbox
 		//-----------------------------------------------------------------------------------------------
 		void GLSLangValidator::Initialise()
 		{
+			std::lock_guard<std::mutex> lock(PROCESS_MUTEX_);
+
+			if (INITIALISED_ == true)
+			{
+				return;
+			}
+
 			glslang::InitializeProcess();
+
+			spv::Parameterize();
+			spv::spirvbin_t::registerErrorHandler(OnRemapError);
+
+			INITIALISED_ = true;
 		}
 
 		//-----------------------------------------------------------------------------------------------
 		void GLSLangValidator::Shutdown()
 		{
+			std::lock_guard<std::mutex> lock(PROCESS_MUTEX_);
+
+			if (INITIALISED_ == false)
+			{
+				return;
+			}
+
 			glslang::FinalizeProcess();
+			INITIALISED_ = false;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		bool GLSLangValidator::InitialiseThread()
+		{
+			struct ThreadState
+			{
+				ThreadState() : initialised(glslang::InitThread()) {}
+				~ThreadState() { glslang::DetachThread(); }
+
+				bool initialised;
+			};
+
+			static thread_local ThreadState state;
+			return state.initialised;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void GLSLangValidator::OnRemapError(const std::string& error)
+		{
+			if (REMAP_ERROR_.empty() == true)
+			{
+				REMAP_ERROR_ = error;
+			}
 		}
 	}
 }
\ No newline at end of file
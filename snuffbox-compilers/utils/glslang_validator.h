@@ -79,17 +79,23 @@ namespace snuffbox
 			* @param[in] hlsl (const char*) The HLSL string as binary
 			* @param[in] filename (const char*) The file name of the shader being compiled
 			* @param[in] type (snuffbox::compilers::GLSLangValidator::ShaderType) The type of the shader
+			* @param[in] optimise (bool) Should dead code be removed, loads and stores be optimised and debug information be stripped?
 			* @param[out] converted_size (size_t*) The size of the converted Spir-V bytecode
 			* @param[out] spirv (unsigned char**) The converted Spir-V bytecode
 			* @return (bool) Was the compilation succesful?
 			*/
-			bool Compile(const char* hlsl, size_t length, const char* filename, ShaderType type, size_t* converted_size, unsigned char** spirv);
+			bool Compile(const char* hlsl, size_t length, const char* filename, ShaderType type, bool optimise, size_t* converted_size, unsigned char** spirv);
 
 			/**
 			* @return (const char*) The last error that was encountered, nullptr if no errors have occurred
 			*/
 			const char* GetError() const;
 
+			/**
+			* @return (size_t) The size of the Spir-V bytecode of the last compilation, before it was optimised
+			*/
+			size_t GetUnoptimisedSize() const;
+
 			/**
 			* @brief Frees up the buffer if it was used
 			*/
@@ -103,7 +109,9 @@ namespace snuffbox
 			static std::string GetDirectory(const char* full_path);
 
 			/**
-			* @brief Initialises glslang
+			* @brief Initialises glslang for the process, this should be called before any shader is compiled
+			* @remarks This can be called more than once, only the first call initialises.
+			* The SPIR-V opcode tables are built here as well, as they would otherwise be built lazily by whichever worker thread uses them first
 			*/
 			static void Initialise();
 
@@ -111,13 +119,32 @@ namespace snuffbox
 			* @brief Shuts glslang down
 			*/
 			static void Shutdown();
+
+		protected:
+
+			/**
+			* @brief Initialises glslang for the calling thread, the first time a thread compiles a shader
+			* @remarks The thread is detached from glslang again when it exits
+			* @return (bool) Was the thread initialised succesfully?
+			*/
+			static bool InitialiseThread();
+
+			/**
+			* @brief Records an error of the Spir-V remapper for the calling thread
+			* @param[in] error (const std::string&) The error
+			* @remarks The remapper exits the process on errors by default, this handler is registered instead
+			*/
+			static void OnRemapError(const std::string& error);
 			
 		private:
 
-			static std::mutex GLSLANG_MUTEX_; //!< The mutex for thread safety, I'm not sure how to do actual multithreading using glslang
+			static std::mutex PROCESS_MUTEX_; //!< The mutex that guards process initialisation, compiling itself does not lock
+			static bool INITIALISED_; //!< Was glslang initialised for the process?
+			static thread_local std::string REMAP_ERROR_; //!< The first error the Spir-V remapper reported on the calling thread
 
 			std::string error_; //!< The current error message
 			unsigned char* buffer_; //!< The buffer to store the Spir-V bytecode in
+			size_t unoptimised_size_; //!< The size of the last Spir-V bytecode before it was optimised
 		};
 	}
 }
\ No newline at end of file
@@ -0,0 +1,25 @@
+#include "hash.h"
+
+namespace snuffbox
+{
+	namespace compilers
+	{
+		//-----------------------------------------------------------------------------------------------
+		const uint64_t Hash::SEED = 14695981039346656037ULL;
+
+		//-----------------------------------------------------------------------------------------------
+		uint64_t Hash::FNV1a(const void* data, size_t size, uint64_t seed)
+		{
+			const unsigned char* bytes = static_cast<const unsigned char*>(data);
+			uint64_t hash = seed;
+
+			for (size_t i = 0; i < size; ++i)
+			{
+				hash ^= bytes[i];
+				hash *= 1099511628211ULL;
+			}
+
+			return hash;
+		}
+	}
+}
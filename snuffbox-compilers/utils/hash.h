@@ -0,0 +1,32 @@
+#pragma once
+
+#include <stddef.h>
+#include <inttypes.h>
+
+namespace snuffbox
+{
+	namespace compilers
+	{
+		/**
+		* @class snuffbox::compilers::Hash
+		* @brief Non-cryptographic hashing of raw data, used for archive lookups and incremental builds
+		* @author Daniel Konings
+		*/
+		class Hash
+		{
+
+		public:
+
+			/**
+			* @brief Hashes a block of data with 64-bit FNV-1a
+			* @param[in] data (const void*) The data to hash
+			* @param[in] size (size_t) The size of the data
+			* @param[in] seed (uint64_t) The hash to continue from, to hash multiple blocks as one, default = snuffbox::compilers::Hash::SEED
+			* @return (uint64_t) The hashed data
+			*/
+			static uint64_t FNV1a(const void* data, size_t size, uint64_t seed = SEED);
+
+			static const uint64_t SEED; //!< The FNV-1a offset basis, the seed for a new hash
+		};
+	}
+}
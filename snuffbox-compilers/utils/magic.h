@@ -13,7 +13,8 @@ namespace snuffbox
 		{
 			kSnuffboxFile = 0x46554E53, //!< 'SNUF' represented as a hexadecimal value, all snuffbox files should have this in their header
 			kScript = 0x00534A53, //!< 'SJS' represented as a hexadecimal value, used for JavaScript files
-			kShader = 0x00485353 //!< 'SSH' represented as a hexadecimal value, used for shader files
+			kShader = 0x00485353, //!< 'SSH' represented as a hexadecimal value, used for shader files
+			kArchive = 0x4B415053 //!< 'SPAK' represented as a hexadecimal value, used for packed content archives
 		};
 	}
 }
\ No newline at end of file
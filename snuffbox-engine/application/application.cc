@@ -9,22 +9,29 @@
 
 #ifdef SNUFF_JAVASCRIPT
 #include "../js/js_state_wrapper.h"
+#include "../js/js_worker.h"
+#include "../js/js_profiler.h"
 #include "../js/js_callback.h"
 #include "../io/script.h"
 #endif
 
 #include "../input/input.h"
 #include "../core/window.h"
+#include "../core/thread_pool.h"
 
 namespace snuffbox
 {
 	namespace engine
 	{
+		//-----------------------------------------------------------------------------------------------
+		const float SnuffboxApp::DEFAULT_FRAME_BUDGET_ = 1000.0f / 60.0f;
+
 		//-----------------------------------------------------------------------------------------------
 		SnuffboxApp::SnuffboxApp(size_t max_memory) :
 			running_(true),
 #ifdef SNUFF_JAVASCRIPT
 			js_state_wrapper_(nullptr),
+			js_profiler_(nullptr),
 			js_on_startup_(nullptr),
 			js_on_update_(nullptr),
 			js_on_reload_(nullptr),
@@ -34,8 +41,10 @@ namespace snuffbox
 			cvar_service_(nullptr),
 			content_service_(nullptr),
 			window_service_(nullptr),
+			thread_pool_(nullptr),
 			delta_timer_(nullptr),
-			delta_time_(0.0f)
+			delta_time_(0.0f),
+			frame_stats_({ 0.0f, 0.0f, 0.0f, 0 })
 		{
 			Memory::Initialise<MallocAllocator>(max_memory);
 		}
@@ -62,10 +71,17 @@ namespace snuffbox
 				OnUpdate(delta_time_);
 
 #ifdef SNUFF_JAVASCRIPT
+				js_profiler_->Update();
 				js_on_update_->Call(delta_time_);
+				JSWorker::Update();
+				NotifyIdle();
+
+				frame_stats_.gc_time = js_state_wrapper_->ConsumeGCPauses(&frame_stats_.gc_count);
 #endif
 				log_service_->client_.FlushLogs();
 				delta_time_ = delta_timer_->Stop(Timer::Unit::kSeconds);
+
+				frame_stats_.frame_time = delta_time_ * 1e3f;
 			}
 
 			Shutdown();
@@ -73,6 +89,12 @@ namespace snuffbox
 			return ExitCodes::kSuccess;
 		}
 
+		//-----------------------------------------------------------------------------------------------
+		const SnuffboxApp::FrameStats& SnuffboxApp::frame_stats() const
+		{
+			return frame_stats_;
+		}
+
 		//-----------------------------------------------------------------------------------------------
 		SnuffboxApp::~SnuffboxApp()
 		{
@@ -90,6 +112,8 @@ namespace snuffbox
 				input_service_ = Memory::ConstructUnique<Input>();
 				window_service_ = Memory::ConstructUnique<Window>();
 
+				thread_pool_ = Memory::ConstructUnique<ThreadPool>();
+
 				cvar_service_->ParseCommandLine(argc, argv);
 
 				Timer log_time("--Log service");
@@ -114,7 +138,7 @@ namespace snuffbox
 
 				Timer content_manager_time("--Content manager");
 				{
-					content_service_->Initialise(cvar_service_.get(), window_service_->renderer_.get(), this);
+					content_service_->Initialise(cvar_service_.get(), window_service_->renderer_.get(), this, thread_pool_.get());
 					Services::Provide<ContentService>(content_service_.get());
 				}
 				content_manager_time.Stop(Timer::Unit::kMilliseconds, true);
@@ -124,13 +148,16 @@ namespace snuffbox
 #ifdef SNUFF_JAVASCRIPT
 				Timer javascript_time("--JavaScript state");
 				js_state_wrapper_ = Memory::ConstructUnique<JSStateWrapper>(Memory::default_allocator());
-				js_state_wrapper_->Initialise();
+				js_state_wrapper_->Initialise(thread_pool_.get());
+
+				js_profiler_ = Memory::ConstructUnique<JSProfiler>();
+				Services::Provide<ProfilerService>(js_profiler_.get());
 
 				log_service_->Assert(content_service_->Load<Script>("main.js").Get() != nullptr, "'main.js' is required in the current src_directory");
 
 				js_on_startup_ = Memory::ConstructUnique<JSCallback<>>();
 				js_on_update_ = Memory::ConstructUnique<JSCallback<float>>();
-				js_on_reload_ = Memory::ConstructUnique<JSCallback<String>>();
+				js_on_reload_ = Memory::ConstructUnique<JSCallback<Vector<String>>>();
 				js_on_shutdown_ = Memory::ConstructUnique<JSCallback<>>();
 
 				BindJSCallbacks();
@@ -145,14 +172,14 @@ namespace snuffbox
 		}
 
 		//-----------------------------------------------------------------------------------------------
-		void SnuffboxApp::Reload(const String& path)
+		void SnuffboxApp::Reload(const Vector<String>& paths)
 		{
 #ifdef SNUFF_JAVASCRIPT
 			BindJSCallbacks();
 
-			js_on_reload_->Call(path);
+			js_on_reload_->Call(paths);
 #endif
-			OnReload(path);
+			OnReload(paths);
 		}
 
 		//-----------------------------------------------------------------------------------------------
@@ -175,6 +202,10 @@ namespace snuffbox
 			js_on_reload_->Clear();
 			js_on_shutdown_->Clear();
 
+			Services::Remove<ProfilerService>();
+			js_profiler_.reset();
+
+			JSWorker::TerminateAll();
 			js_state_wrapper_->Shutdown();
 #endif
 			log_service_->client_.FlushLogs();
@@ -197,6 +228,35 @@ namespace snuffbox
 			js_on_reload_->Set("Application", "onReload");
 			js_on_shutdown_->Set("Application", "onShutdown");
 		}
+
+		//-----------------------------------------------------------------------------------------------
+		void SnuffboxApp::NotifyIdle()
+		{
+			frame_stats_.idle_time = 0.0f;
+
+			CVarBoolean* idle = cvar_service_->Get<CVarBoolean>("gc_idle");
+			if (idle != nullptr && idle->value() == false)
+			{
+				return;
+			}
+
+			float budget = DEFAULT_FRAME_BUDGET_;
+
+			CVarNumber* frame_budget = cvar_service_->Get<CVarNumber>("frame_budget");
+			if (frame_budget != nullptr)
+			{
+				budget = frame_budget->value();
+			}
+
+			float remaining = budget - delta_timer_->Elapsed(Timer::Unit::kMilliseconds);
+			if (remaining <= 0.0f)
+			{
+				return;
+			}
+
+			js_state_wrapper_->IdleNotification(static_cast<double>(remaining) * 1e-3);
+			frame_stats_.idle_time = remaining;
+		}
 #endif
 
 		//-----------------------------------------------------------------------------------------------
@@ -218,7 +278,7 @@ namespace snuffbox
 		}
 
 		//-----------------------------------------------------------------------------------------------
-		void SnuffboxApp::OnReload(const String& path)
+		void SnuffboxApp::OnReload(const Vector<String>& paths)
 		{
 
 		}
@@ -14,9 +14,11 @@ namespace snuffbox
 		class CVar;
 		class ContentManager;
 		class Input;
+		class ThreadPool;
 
 #ifdef SNUFF_JAVASCRIPT
 		class JSStateWrapper;
+		class JSProfiler;
 		
 		template <typename ... Args>
 		class JSCallback;
@@ -45,6 +47,19 @@ namespace snuffbox
 				kUnknown //!< When an unknown error has occurred
 			};
 
+			/**
+			* @struct snuffbox::engine::SnuffboxApp::FrameStats
+			* @brief Timing statistics of the last frame, all times are in milliseconds
+			* @author Daniel Konings
+			*/
+			struct FrameStats
+			{
+				float frame_time; //!< The total time the frame took
+				float idle_time; //!< The idle time that was handed to the garbage collector
+				float gc_time; //!< The time spent in garbage collection pauses
+				unsigned int gc_count; //!< The number of garbage collections that occurred
+			};
+
 			/**
 			* @brief Default constructor
 			* @param[in] max_memory (size_t) The maximum amount of memory for the application to use, default = 4Gb
@@ -59,6 +74,11 @@ namespace snuffbox
 			*/
 			ExitCodes Exec(int argc, char** argv);
 
+			/**
+			* @return (const snuffbox::engine::SnuffboxApp::FrameStats&) The timing statistics of the last frame
+			*/
+			const FrameStats& frame_stats() const;
+
 			/**
 			* @brief Default destructor
 			*/
@@ -74,10 +94,10 @@ namespace snuffbox
 			void Initialise(int argc, char** argv);
 
 			/**
-			* @brief Called when a file is reloaded from the content manager
-			* @param[in] path (const snuffbox::engine::String&) The relative path of the reloaded file
+			* @brief Called once when a batch of files was reloaded by the content manager
+			* @param[in] paths (const snuffbox::engine::Vector<snuffbox::engine::String>&) The relative paths of the reloaded files
 			*/
-			void Reload(const String& path);
+			void Reload(const Vector<String>& paths);
 
 			/**
 			* @brief Shuts the application down
@@ -89,6 +109,12 @@ namespace snuffbox
 			* @brief Binds the JavaScript callbacks to the current JavaScript context
 			*/
 			void BindJSCallbacks();
+
+			/**
+			* @brief Hands the remaining time of the frame budget to the JavaScript garbage collector
+			* @remarks The budget is set by the 'frame_budget' CVar, idle collection is toggled with 'gc_idle'
+			*/
+			void NotifyIdle();
 #endif
 
 			/**
@@ -109,10 +135,10 @@ namespace snuffbox
 			virtual void OnUpdate(float dt);
 
 			/**
-			* @brief Called when a file has been reloaded
-			* @param[in] path (const snuffbox::engine::String&) The relative path to the reloaded file
+			* @brief Called when a batch of files has been reloaded
+			* @param[in] paths (const snuffbox::engine::Vector<snuffbox::engine::String>&) The relative paths to the reloaded files, including the files that depend on a changed file
 			*/
-			virtual void OnReload(const String& path);
+			virtual void OnReload(const Vector<String>& paths);
 
 			/**
 			* @brief Called when the application is shutdown, before destruction
@@ -130,10 +156,11 @@ namespace snuffbox
 
 #ifdef SNUFF_JAVASCRIPT
 			UniquePtr<JSStateWrapper> js_state_wrapper_; //!< The JavaScript state wrapper
+			UniquePtr<JSProfiler> js_profiler_; //!< The script profiler
 
 			UniquePtr<JSCallback<>> js_on_startup_; //!< The JavaScript 'Application.onStartup(void)' callback
 			UniquePtr<JSCallback<float>> js_on_update_; //!< The JavaScript 'Application.onUpdate(number)' callback
-			UniquePtr<JSCallback<String>> js_on_reload_; //!< The JavaScript 'Application.onReload(string)' callback
+			UniquePtr<JSCallback<Vector<String>>> js_on_reload_; //!< The JavaScript 'Application.onReload(string[])' callback
 			UniquePtr<JSCallback<>> js_on_shutdown_; //!< The JavaScript 'Application.onShutdown(void)' callback
 #endif
 
@@ -143,8 +170,14 @@ namespace snuffbox
 			UniquePtr<Input> input_service_; //!< The input service
 			UniquePtr<Window> window_service_; //!< The window to render to
 
+			UniquePtr<ThreadPool> thread_pool_; //!< The thread pool to run background work on
+
 			UniquePtr<Timer> delta_timer_; //!< The delta timer
 			float delta_time_; //!< The current delta time of the application
+
+			FrameStats frame_stats_; //!< The timing statistics of the last frame
+
+			static const float DEFAULT_FRAME_BUDGET_; //!< The default frame budget in milliseconds, if 'frame_budget' was not set
 		};
 	}
 }
@@ -0,0 +1,86 @@
+#include "thread_pool.h"
+
+namespace snuffbox
+{
+	namespace engine
+	{
+		//-----------------------------------------------------------------------------------------------
+		ThreadPool::ThreadPool(unsigned int num_threads) :
+			stop_(false)
+		{
+			if (num_threads == 0)
+			{
+				unsigned int hardware = std::thread::hardware_concurrency();
+				num_threads = hardware > 1 ? hardware - 1 : 1;
+			}
+
+			threads_.reserve(num_threads);
+
+			for (unsigned int i = 0; i < num_threads; ++i)
+			{
+				threads_.emplace_back(&ThreadPool::Run, this);
+			}
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void ThreadPool::Schedule(const Task& task)
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				tasks_.push(task);
+			}
+
+			condition_.notify_one();
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		unsigned int ThreadPool::size() const
+		{
+			return static_cast<unsigned int>(threads_.size());
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void ThreadPool::Run()
+		{
+			Task task;
+
+			while (true)
+			{
+				{
+					std::unique_lock<std::mutex> lock(mutex_);
+					condition_.wait(lock, [this]()
+					{
+						return stop_ == true || tasks_.empty() == false;
+					});
+
+					if (tasks_.empty() == true)
+					{
+						return;
+					}
+
+					task = tasks_.front();
+					tasks_.pop();
+				}
+
+				task();
+				task = nullptr;
+			}
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		ThreadPool::~ThreadPool()
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				stop_ = true;
+			}
+
+			condition_.notify_all();
+
+			for (size_t i = 0; i < threads_.size(); ++i)
+			{
+				threads_.at(i).join();
+			}
+		}
+	}
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "eastl.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+namespace snuffbox
+{
+	namespace engine
+	{
+		/**
+		* @class snuffbox::engine::ThreadPool
+		* @brief A fixed set of worker threads that execute scheduled tasks in order of scheduling
+		* @author Daniel Konings
+		*/
+		class ThreadPool
+		{
+
+		public:
+
+			typedef std::function<void()> Task;
+
+			/**
+			* @brief Construct by specifying the number of threads to spawn
+			* @param[in] num_threads (unsigned int) The number of threads, 0 = the hardware concurrency minus the main thread, default = 0
+			*/
+			ThreadPool(unsigned int num_threads = 0);
+
+			/**
+			* @brief Schedules a task to be executed on one of the worker threads
+			* @param[in] task (const snuffbox::engine::ThreadPool::Task&) The task to execute
+			*/
+			void Schedule(const Task& task);
+
+			/**
+			* @return (unsigned int) The number of worker threads in this pool
+			*/
+			unsigned int size() const;
+
+			/**
+			* @brief Default destructor, finishes all scheduled tasks and joins the worker threads
+			*/
+			~ThreadPool();
+
+		protected:
+
+			/**
+			* @brief The main loop of every worker thread
+			* @remarks A task is released as soon as it has run, so that an idle thread does not keep its captures alive
+			*/
+			void Run();
+
+		private:
+
+			Vector<std::thread> threads_; //!< The worker threads
+			Queue<Task> tasks_; //!< The tasks that are waiting to be executed
+
+			std::mutex mutex_; //!< The mutex to guard the task queue with
+			std::condition_variable condition_; //!< Used to wake up worker threads when a task is scheduled
+			bool stop_; //!< Should the worker threads stop?
+		};
+	}
+}
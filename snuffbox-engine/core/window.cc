@@ -246,7 +246,7 @@ namespace snuffbox
 		{
 			JSWrapper wrapper(args);
 
-			if (wrapper.Check("S") == true)
+			if (wrapper.Check<JSWrapper::kString>() == true)
 			{
 				Services::Get<WindowService>().SetTitle(wrapper.GetValue<String>(0, "Snuffbox"));
 			}
@@ -257,7 +257,7 @@ namespace snuffbox
 		{
 			JSWrapper wrapper(args);
 
-			if (wrapper.Check("NN") == true)
+			if (wrapper.Check<JSWrapper::kNumber, JSWrapper::kNumber>() == true)
 			{
 				Services::Get<WindowService>().SetSize(wrapper.GetValue<unsigned int>(0, 1280),
 													   wrapper.GetValue<unsigned int>(1, 720));
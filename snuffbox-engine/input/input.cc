@@ -344,7 +344,7 @@ namespace snuffbox
 			
 			JSWrapper wrapper(args);
 			
-			if (wrapper.Check("N", false) == true)
+			if (wrapper.Check<JSWrapper::kNumber>(false) == true)
 			{
                 int key = wrapper.GetValue<int>(0, static_cast<int>(KeyCodesEnum::kNone));
 				wrapper.ReturnValue<bool>(Services::Get<InputService>().KeyboardPressed(static_cast<KeyCodes::KeyCode>(key)));
@@ -356,7 +356,7 @@ namespace snuffbox
 		
 			JSWrapper wrapper(args);
 
-			if (wrapper.Check("N", false) == true)
+			if (wrapper.Check<JSWrapper::kNumber>(false) == true)
 			{
                 int key = wrapper.GetValue<int>(0, static_cast<int>(KeyCodesEnum::kNone));
 				wrapper.ReturnValue<bool>(Services::Get<InputService>().KeyboardDown(static_cast<KeyCodes::KeyCode>(key)));
@@ -368,7 +368,7 @@ namespace snuffbox
 		
 			JSWrapper wrapper(args);
 
-			if (wrapper.Check("N", false) == true)
+			if (wrapper.Check<JSWrapper::kNumber>(false) == true)
 			{
                 int key = wrapper.GetValue<int>(0, static_cast<int>(KeyCodesEnum::kNone));
 				wrapper.ReturnValue<bool>(Services::Get<InputService>().KeyboardReleased(static_cast<KeyCodes::KeyCode>(key)));
@@ -449,7 +449,7 @@ namespace snuffbox
 		
 			JSWrapper wrapper(args);
 
-			if (wrapper.Check("N", false) == true)
+			if (wrapper.Check<JSWrapper::kNumber>(false) == true)
 			{
 				int key = wrapper.GetValue<int>(0, static_cast<int>(MouseButtonsEnum::kNone));
 				wrapper.ReturnValue<bool>(Services::Get<InputService>().MousePressed(static_cast<KeyCodes::KeyCode>(key)));
@@ -461,7 +461,7 @@ namespace snuffbox
 		
 			JSWrapper wrapper(args);
 
-			if (wrapper.Check("N", false) == true)
+			if (wrapper.Check<JSWrapper::kNumber>(false) == true)
 			{
 				int key = wrapper.GetValue<int>(0, static_cast<int>(MouseButtonsEnum::kNone));
 				wrapper.ReturnValue<bool>(Services::Get<InputService>().MouseDown(static_cast<KeyCodes::KeyCode>(key)));
@@ -473,7 +473,7 @@ namespace snuffbox
 			
 			JSWrapper wrapper(args);
 
-			if (wrapper.Check("N", false) == true)
+			if (wrapper.Check<JSWrapper::kNumber>(false) == true)
 			{
 				int key = wrapper.GetValue<int>(0, static_cast<int>(MouseButtonsEnum::kNone));
 				wrapper.ReturnValue<bool>(Services::Get<InputService>().MouseReleased(static_cast<KeyCodes::KeyCode>(key)));
@@ -522,7 +522,7 @@ namespace snuffbox
 			
 			JSWrapper wrapper(args);
 
-			if (wrapper.Check("NN", false) == true)
+			if (wrapper.Check<JSWrapper::kNumber, JSWrapper::kNumber>(false) == true)
 			{
 				int id = wrapper.GetValue<int>(0, 0);
 				float dz = wrapper.GetValue<float>(1, Controller::DEFAULT_DEAD_ZONE_);
@@ -535,7 +535,7 @@ namespace snuffbox
 		JS_FUNCTION_IMPL(Input, controllerAxis, JS_BODY({
 			
 			JSWrapper wrapper(args);
-			if (wrapper.Check("NN", false) == true)
+			if (wrapper.Check<JSWrapper::kNumber, JSWrapper::kNumber>(false) == true)
 			{
 				int id = wrapper.GetValue<int>(0, 0);
 				int axis = wrapper.GetValue<int>(1, static_cast<int>(ControllerButtons::Axes::kLeftStickX));
@@ -548,7 +548,7 @@ namespace snuffbox
 		JS_FUNCTION_IMPL(Input, controllerPressed, JS_BODY({
 			
 			JSWrapper wrapper(args);
-			if (wrapper.Check("NN", false) == true)
+			if (wrapper.Check<JSWrapper::kNumber, JSWrapper::kNumber>(false) == true)
 			{
 				int id = wrapper.GetValue<int>(0, 0);
 				int key = wrapper.GetValue<int>(1, static_cast<int>(ControllerButtonsEnum::kNone));
@@ -561,7 +561,7 @@ namespace snuffbox
 		JS_FUNCTION_IMPL(Input, controllerDown, JS_BODY({
 			
 			JSWrapper wrapper(args);
-			if (wrapper.Check("NN", false) == true)
+			if (wrapper.Check<JSWrapper::kNumber, JSWrapper::kNumber>(false) == true)
 			{
 				int id = wrapper.GetValue<int>(0, 0);
 				int key = wrapper.GetValue<int>(1, static_cast<int>(ControllerButtonsEnum::kNone));
@@ -574,7 +574,7 @@ namespace snuffbox
 		JS_FUNCTION_IMPL(Input, controllerReleased, JS_BODY({
 		
 			JSWrapper wrapper(args);
-			if (wrapper.Check("NN", false) == true)
+			if (wrapper.Check<JSWrapper::kNumber, JSWrapper::kNumber>(false) == true)
 			{
 				int id = wrapper.GetValue<int>(0, 0);
 				int key = wrapper.GetValue<int>(1, static_cast<int>(ControllerButtonsEnum::kNone));
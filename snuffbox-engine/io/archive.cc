@@ -0,0 +1,96 @@
+#include "archive.h"
+
+#include "../services/log_service.h"
+
+#include <snuffbox-compilers/utils/archive_format.h>
+
+namespace snuffbox
+{
+	namespace engine
+	{
+		//-----------------------------------------------------------------------------------------------
+		Archive::Archive() :
+			directory_("")
+		{
+
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		bool Archive::Mount(const String& path)
+		{
+			if (file_.Map(path) == false)
+			{
+				return false;
+			}
+
+			if (compilers::ArchiveFormat::Validate(file_.data(), file_.size()) == false)
+			{
+				Services::Get<LogService>().Log(console::LogSeverity::kWarning, "Archive '{0}' is invalid or of an old version, rebuild it with the builder", path);
+				
+				Unmount();
+				return false;
+			}
+
+			size_t slash = path.find_last_of('/');
+			directory_ = slash == String::npos ? "" : path.substr(0, slash);
+
+			return true;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void Archive::Unmount()
+		{
+			file_.Unmap();
+			directory_ = "";
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		const unsigned char* Archive::Find(const String& path, size_t* size) const
+		{
+			const unsigned char* data = file_.data();
+
+			if (data == nullptr)
+			{
+				return nullptr;
+			}
+
+			const char* relative = path.c_str();
+			size_t length = path.size();
+
+			if (directory_.size() > 0 && length > directory_.size() && 
+				path.compare(0, directory_.size(), directory_) == 0 && path.at(directory_.size()) == '/')
+			{
+				relative += directory_.size() + 1;
+				length -= directory_.size() + 1;
+			}
+
+			const compilers::ArchiveFormat::Entry* entry = compilers::ArchiveFormat::Find(data, relative, length);
+
+			if (entry == nullptr)
+			{
+				return nullptr;
+			}
+
+			if ((entry->flags & compilers::ArchiveFormat::EntryFlags::kCompressed) != 0)
+			{
+				Services::Get<LogService>().Log(console::LogSeverity::kError, "Compressed archive entries are not supported, '{0}' will be read from disk instead", path);
+				return nullptr;
+			}
+
+			*size = static_cast<size_t>(entry->size);
+			return data + entry->offset;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		bool Archive::mounted() const
+		{
+			return file_.data() != nullptr;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		Archive::~Archive()
+		{
+			Unmount();
+		}
+	}
+}
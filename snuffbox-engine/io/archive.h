@@ -0,0 +1,69 @@
+#pragma once
+
+#include "../core/eastl.h"
+#include "mapped_file.h"
+
+namespace snuffbox
+{
+	namespace engine
+	{
+		/**
+		* @class snuffbox::engine::Archive
+		* @brief A packed content archive that is memory-mapped read-only, its entries are handed out as views into the mapping
+		* @remarks Lookups are thread-safe once the archive is mounted, as the mapping is never written to
+		* @see snuffbox::compilers::ArchiveFormat
+		* @author Daniel Konings
+		*/
+		class Archive
+		{
+
+		public:
+
+			/**
+			* @brief Default constructor
+			*/
+			Archive();
+
+			/**
+			* @brief Remove copy constructor
+			*/
+			Archive(const Archive& other) = delete;
+
+			/**
+			* @brief Maps an archive file into memory and validates it
+			* @param[in] path (const snuffbox::engine::String&) The path to the archive
+			* @return (bool) Was the archive mounted succesfully?
+			* @remarks Any previously mounted archive is unmounted first
+			*/
+			bool Mount(const String& path);
+
+			/**
+			* @brief Unmaps the archive, every view that was handed out becomes invalid
+			*/
+			void Unmount();
+
+			/**
+			* @brief Looks up an entry by path
+			* @param[in] path (const snuffbox::engine::String&) The path of the entry, either relative to the archive's directory or including it
+			* @param[out] size (size_t*) The size of the entry
+			* @return (const unsigned char*) A view of the entry's data, followed by at least one null byte, or nullptr if it is not in the archive
+			*/
+			const unsigned char* Find(const String& path, size_t* size) const;
+
+			/**
+			* @return (bool) Is an archive mounted?
+			*/
+			bool mounted() const;
+
+			/**
+			* @brief Default destructor, unmounts the archive
+			*/
+			~Archive();
+
+		private:
+
+			String directory_; //!< The directory the archive is in, entries are relative to it
+			MappedFile file_; //!< The mapped archive
+		};
+	}
+}
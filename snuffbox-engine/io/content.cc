@@ -7,11 +7,17 @@ namespace snuffbox
 	{
 		//-----------------------------------------------------------------------------------------------
 		ContentBase::ContentBase() :
-			is_valid_(false)
+			size_(0)
 		{
 
 		}
 
+		//-----------------------------------------------------------------------------------------------
+		bool ContentBase::Load(File* file, ContentManager* cm)
+		{
+			return Decompile(file) == true && Create(cm) == true;
+		}
+
 		//-----------------------------------------------------------------------------------------------
 		bool ContentBase::Reload(File* file, ContentManager* cm)
 		{
@@ -25,15 +31,21 @@ namespace snuffbox
 		}
 
 		//-----------------------------------------------------------------------------------------------
-		void ContentBase::set_is_valid(bool valid)
+		bool ContentBase::evictable() const
 		{
-			is_valid_ = valid;
+			return true;
 		}
 
 		//-----------------------------------------------------------------------------------------------
-		bool ContentBase::is_valid() const
+		void ContentBase::set_size(size_t size)
 		{
-			return is_valid_;
+			size_ = size;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		size_t ContentBase::size() const
+		{
+			return size_;
 		}
 
 		//-----------------------------------------------------------------------------------------------
@@ -41,5 +53,183 @@ namespace snuffbox
 		{
 
 		}
+
+		//-----------------------------------------------------------------------------------------------
+		ContentObject::ContentObject(const ContentPtr<ContentBase>& content) :
+			content_(content)
+		{
+			ContentTable::Pin(content_);
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		const ContentPtr<ContentBase>& ContentObject::content() const
+		{
+			return content_;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		ContentObject::~ContentObject()
+		{
+			ContentTable::Unpin(content_);
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		const uint32_t ContentTable::INVALID_INDEX_ = 0xFFFFFFFF;
+
+		//-----------------------------------------------------------------------------------------------
+		Vector<ContentTable::Slot> ContentTable::slots_;
+		uint32_t ContentTable::free_ = ContentTable::INVALID_INDEX_;
+		uint32_t ContentTable::frame_ = 1;
+		Vector<ContentBase*> ContentTable::dense_[ContentBase::Types::kCount];
+		Vector<uint32_t> ContentTable::owners_[ContentBase::Types::kCount];
+
+		//-----------------------------------------------------------------------------------------------
+		ContentPtr<ContentBase> ContentTable::Insert(ContentBase* content, ContentBase::Types type)
+		{
+			uint32_t index = free_;
+
+			if (index == INVALID_INDEX_)
+			{
+				index = static_cast<uint32_t>(slots_.size());
+
+				Slot slot;
+				slot.generation = 1;
+				slot.dense = INVALID_INDEX_;
+				slot.type = ContentBase::Types::kCount;
+
+				slots_.push_back(slot);
+			}
+			else
+			{
+				free_ = slots_[index].dense;
+			}
+
+			Slot& slot = slots_[index];
+			slot.dense = static_cast<uint32_t>(dense_[type].size());
+			slot.type = type;
+			slot.used = frame_;
+			slot.pins = 0;
+
+			dense_[type].push_back(content);
+			owners_[type].push_back(index);
+
+			return ContentPtr<ContentBase>(index, slot.generation);
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		ContentBase* ContentTable::Remove(const ContentPtr<ContentBase>& handle)
+		{
+			ContentBase* content = Resolve(handle.index_, handle.generation_);
+
+			if (content == nullptr)
+			{
+				return nullptr;
+			}
+
+			Slot& slot = slots_[handle.index_];
+
+			Vector<ContentBase*>& dense = dense_[slot.type];
+			Vector<uint32_t>& owners = owners_[slot.type];
+
+			uint32_t last = static_cast<uint32_t>(dense.size()) - 1;
+
+			if (slot.dense != last)
+			{
+				dense[slot.dense] = dense[last];
+				owners[slot.dense] = owners[last];
+				slots_[owners[slot.dense]].dense = slot.dense;
+			}
+
+			dense.pop_back();
+			owners.pop_back();
+
+			if (++slot.generation == 0)
+			{
+				slot.generation = 1;
+			}
+
+			slot.type = ContentBase::Types::kCount;
+			slot.pins = 0;
+			slot.dense = free_;
+			free_ = handle.index_;
+
+			return content;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		const Vector<ContentBase*>& ContentTable::Dense(ContentBase::Types type)
+		{
+			return dense_[type];
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		ContentBase* ContentTable::Find(const ContentPtr<ContentBase>& handle)
+		{
+			if (handle.index_ >= slots_.size())
+			{
+				return nullptr;
+			}
+
+			const Slot& slot = slots_[handle.index_];
+
+			if (slot.generation != handle.generation_ || slot.type == ContentBase::Types::kCount)
+			{
+				return nullptr;
+			}
+
+			return dense_[slot.type][slot.dense];
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		uint32_t ContentTable::LastUsed(const ContentPtr<ContentBase>& handle)
+		{
+			if (handle.index_ >= slots_.size() || slots_[handle.index_].generation != handle.generation_)
+			{
+				return 0;
+			}
+
+			return slots_[handle.index_].used;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		uint32_t ContentTable::Pins(const ContentPtr<ContentBase>& handle)
+		{
+			if (Find(handle) == nullptr)
+			{
+				return 0;
+			}
+
+			return slots_[handle.index_].pins;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void ContentTable::Pin(const ContentPtr<ContentBase>& handle)
+		{
+			if (Find(handle) != nullptr)
+			{
+				++slots_[handle.index_].pins;
+			}
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void ContentTable::Unpin(const ContentPtr<ContentBase>& handle)
+		{
+			if (Find(handle) != nullptr && slots_[handle.index_].pins > 0)
+			{
+				--slots_[handle.index_].pins;
+			}
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void ContentTable::Tick()
+		{
+			++frame_;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		uint32_t ContentTable::frame()
+		{
+			return frame_;
+		}
 	}
-}
\ No newline at end of file
+}
@@ -1,7 +1,10 @@
 #pragma once
 
 #include <type_traits>
+#include <stdint.h>
+
 #include "../memory/memory.h"
+#include "../core/eastl.h"
 #include "../js/js_defines.h"
 
 namespace snuffbox
@@ -14,30 +17,36 @@ namespace snuffbox
 
 		/**
 		* @class snuffbox::engine::ContentPtr
-		* @brief Used to keep track of content with a ref count and if it's still valid
+		* @brief A handle to content in the snuffbox::engine::ContentTable, which is invalidated by a generation counter
+		* @remarks Resolving a handle is an index and a generation compare, handles are trivially copyable and don't count references
 		* @author Daniel Konings
 		*/
 		template <typename T>
-		class ContentPtr JS_OBJECT
+		class ContentPtr
 		{
 
 			friend class ContentManager;
 			friend class ContentService;
+			friend class ContentTable;
+
+			template <typename Y>
+			friend class ContentPtr;
 
 		public:
 
 			/**
-			* @brief Default constructor
+			* @brief Default constructor, creates a null handle
 			*/
 			ContentPtr();
 
 		protected:
 
 			/**
-			* @brief Construct by providing the actual raw pointer
-			* @param[in] ptr (T*) The pointer to the actual content
+			* @brief Construct by providing the slot in the content table
+			* @param[in] index (uint32_t) The index of the slot
+			* @param[in] generation (uint32_t) The generation of the slot when this handle was created
 			*/
-			ContentPtr(T* ptr);
+			ContentPtr(uint32_t index, uint32_t generation);
 
 			/**
 			* @brief Construct a content pointer from one type to the other
@@ -46,37 +55,31 @@ namespace snuffbox
 			template <typename Y>
 			ContentPtr(const ContentPtr<Y>& other);
 
-			/**
-			* @brief Assignment of a raw pointer from one type to the other
-			* @param[in] ptr (Y*) The raw pointer of a different type
-			*/
-			template <typename Y>
-			ContentPtr<T> operator=(Y* ptr);
-
 		public:
 
 			/**
 			* @brief Retrieves the raw content pointer
-			* @remarks Returns nullptr if the content is no longer loaded, resetting the shared pointer
+			* @remarks Returns nullptr if the content is no longer loaded
 			* @return (T*) The raw pointer
 			*/
-			T* Get();
+			T* Get() const;
 
 			/**
 			* @brief Does a snuffbox::engine::ContentPtr<T>::Get and retrieves the raw pointer
 			* @see snuffbox::engine::ContentPtr<T>::Get
 			* @return (T*) The raw pointer, or nullptr if this content was not valid
 			*/
-			T* operator->();
+			T* operator->() const;
 
 			/**
-			* @return (const snuffbox::engine::SharedPtr<snuffbox::engine::ContentBase>&) The underlying shared pointer
+			* @return (bool) Does this handle still point to loaded content?
 			*/
-			const SharedPtr<ContentBase>& ptr() const;
+			bool is_valid() const;
 
 		private:
 
-			SharedPtr<ContentBase> ptr_; //!< The shared pointer that keeps the reference count for this contained pointer
+			uint32_t index_; //!< The index of the slot in the content table
+			uint32_t generation_; //!< The generation of the slot, which no longer matches once the content is unloaded
 		};
 
 		/**
@@ -111,8 +114,25 @@ namespace snuffbox
 			* @param[in] file (snuffbox::engine::File*) The file to load the data of this content from
 			* @param[in] cm (snuffbox::engine::ContentManager*) The content manager this content is being loaded from
 			* @return (bool) Was the load a success?
+			* @remarks By default, this calls 'Decompile' followed by 'Create'
+			*/
+			virtual bool Load(File* file, ContentManager* cm);
+
+			/**
+			* @brief Reads and decompiles the data of a provided file, without creating any runtime objects yet
+			* @param[in] file (snuffbox::engine::File*) The file to decompile the data of this content from
+			* @return (bool) Was the decompilation a success?
+			* @remarks This is called from a thread pool thread for asynchronous loads, so it shouldn't touch V8 or the renderer
 			*/
-			virtual bool Load(File* file, ContentManager* cm) = 0;
+			virtual bool Decompile(File* file) = 0;
+
+			/**
+			* @brief Creates the runtime objects from the decompiled data and releases that data
+			* @param[in] cm (snuffbox::engine::ContentManager*) The content manager this content is being loaded from
+			* @return (bool) Was the creation a success?
+			* @remarks This is always called from the main thread
+			*/
+			virtual bool Create(ContentManager* cm) = 0;
 
 			/**
 			* @brief Reloads the actual data from a provided file
@@ -129,20 +149,26 @@ namespace snuffbox
 			*/
 			virtual void Unload(ContentManager* cm);
 
+			/**
+			* @return (bool) Can this content be evicted when its budget is exceeded, to be loaded again once it's requested?
+			* @remarks By default this is true, override for content that can't be loaded twice without side effects
+			*/
+			virtual bool evictable() const;
+
 		protected:
 
 			/**
-			* @brief Sets if this content is valid
-			* @param[in] valid (bool) The boolean value
+			* @brief Sets the number of bytes this content occupies
+			* @param[in] size (size_t) The size in bytes
 			*/
-			void set_is_valid(bool valid);
+			void set_size(size_t size);
 
 		public:
 
 			/**
-			* @return (bool) Is this content still valid?
+			* @return (size_t) The number of bytes this content occupies, which counts towards the budget of its type
 			*/
-			bool is_valid() const;
+			size_t size() const;
 
 			/**
 			* @brief Default destructor
@@ -151,7 +177,7 @@ namespace snuffbox
 
 		private:
 
-			bool is_valid_; //!< Is this content still valid?
+			size_t size_; //!< The number of bytes this content occupies
 		};
 
 		/**
@@ -188,62 +214,221 @@ namespace snuffbox
 			static const bool value = std::is_base_of<ContentBase, T>::value;
 		};
 
+		/**
+		* @class snuffbox::engine::ContentObject : [JSObject]
+		* @brief Holds a content handle for JavaScript, so that the handle itself doesn't have to carry a persistent object
+		* @remarks The content is pinned for as long as the object lives, so that content a script holds on to is never evicted
+		* @author Daniel Konings
+		*/
+		class ContentObject JS_OBJECT
+		{
+
+		public:
+
+			/**
+			* @brief Construct by providing the handle to hold
+			* @param[in] content (const snuffbox::engine::ContentPtr<snuffbox::engine::ContentBase>&) The handle
+			*/
+			ContentObject(const ContentPtr<ContentBase>& content);
+
+			/**
+			* @return (const snuffbox::engine::ContentPtr<snuffbox::engine::ContentBase>&) The held handle
+			*/
+			const ContentPtr<ContentBase>& content() const;
+
+			/**
+			* @brief Default destructor, unpins the content
+			*/
+			~ContentObject();
+
+		private:
+
+			ContentPtr<ContentBase> content_; //!< The held handle
+		};
+
+		/**
+		* @class snuffbox::engine::ContentTable
+		* @brief The table of all loaded content, which hands out generation checked handles and stores the content densely by type
+		* @remarks The table is only accessed from the main thread, content that is decompiled asynchronously is inserted once it is created
+		* @author Daniel Konings
+		*/
+		class ContentTable
+		{
+
+			friend class ContentManager;
+
+		protected:
+
+			/**
+			* @struct snuffbox::engine::ContentTable::Slot
+			* @brief A single slot in the table, which is reused after its content is removed
+			* @author Daniel Konings
+			*/
+			struct Slot
+			{
+				uint32_t generation; //!< The current generation, incremented every time the slot is freed
+				uint32_t used; //!< The frame the content was last resolved in
+				uint32_t pins; //!< The number of script objects that hold the content, pinned content is never evicted
+				uint32_t dense; //!< The index of the content in the dense array of its type, or the next free slot if this slot is free
+				ContentBase::Types type; //!< The type of the content, or kCount if the slot is free
+			};
+
+			/**
+			* @brief Inserts content into the table
+			* @param[in] content (snuffbox::engine::ContentBase*) The content to insert, the table does not take ownership
+			* @param[in] type (snuffbox::engine::ContentBase::Types) The type of the content
+			* @return (snuffbox::engine::ContentPtr<snuffbox::engine::ContentBase>) The handle to the inserted content
+			*/
+			static ContentPtr<ContentBase> Insert(ContentBase* content, ContentBase::Types type);
+
+			/**
+			* @brief Removes content from the table, invalidating every handle to it
+			* @param[in] handle (const snuffbox::engine::ContentPtr<snuffbox::engine::ContentBase>&) The handle to the content to remove
+			* @return (snuffbox::engine::ContentBase*) The removed content, or nullptr if the handle was already invalid
+			* @remarks The last content of the same type is moved into the gap, so that the dense array stays packed
+			*/
+			static ContentBase* Remove(const ContentPtr<ContentBase>& handle);
+
+			/**
+			* @brief Retrieves all content of a type
+			* @param[in] type (snuffbox::engine::ContentBase::Types) The type of content to retrieve
+			* @return (const snuffbox::engine::Vector<snuffbox::engine::ContentBase*>&) The densely stored content
+			*/
+			static const Vector<ContentBase*>& Dense(ContentBase::Types type);
+
+			/**
+			* @brief Retrieves the content a handle points to, without marking it as used
+			* @param[in] handle (const snuffbox::engine::ContentPtr<snuffbox::engine::ContentBase>&) The handle to the content
+			* @return (snuffbox::engine::ContentBase*) The content, or nullptr if the handle is invalid
+			*/
+			static ContentBase* Find(const ContentPtr<ContentBase>& handle);
+
+			/**
+			* @brief Retrieves the frame in which content was last resolved
+			* @param[in] handle (const snuffbox::engine::ContentPtr<snuffbox::engine::ContentBase>&) The handle to the content
+			* @return (uint32_t) The frame, or 0 if the handle is invalid
+			*/
+			static uint32_t LastUsed(const ContentPtr<ContentBase>& handle);
+
+			/**
+			* @brief Retrieves how many times content is pinned
+			* @param[in] handle (const snuffbox::engine::ContentPtr<snuffbox::engine::ContentBase>&) The handle to the content
+			* @return (uint32_t) The number of pins, or 0 if the handle is invalid
+			*/
+			static uint32_t Pins(const ContentPtr<ContentBase>& handle);
+
+			/**
+			* @brief Starts a new frame, content that is resolved from here on is marked as used in this frame
+			*/
+			static void Tick();
+
+			/**
+			* @return (uint32_t) The current frame
+			*/
+			static uint32_t frame();
+
+		public:
+
+			/**
+			* @brief Resolves a handle into the content it points to
+			* @param[in] index (uint32_t) The index of the slot
+			* @param[in] generation (uint32_t) The generation the handle was created with
+			* @return (snuffbox::engine::ContentBase*) The content, or nullptr if the slot was freed since
+			* @remarks This marks the content as used in the current frame, so that it isn't evicted
+			*/
+			static ContentBase* Resolve(uint32_t index, uint32_t generation);
+
+			/**
+			* @brief Pins content, so that it isn't evicted
+			* @param[in] handle (const snuffbox::engine::ContentPtr<snuffbox::engine::ContentBase>&) The handle to the content
+			* @remarks Like the rest of the table, this should only be called from the main thread
+			*/
+			static void Pin(const ContentPtr<ContentBase>& handle);
+
+			/**
+			* @brief Removes a pin from content, if the content is still loaded
+			* @param[in] handle (const snuffbox::engine::ContentPtr<snuffbox::engine::ContentBase>&) The handle to the content
+			* @remarks Pins on content that was already removed are ignored, the slot starts counting from zero when it is reused
+			*/
+			static void Unpin(const ContentPtr<ContentBase>& handle);
+
+		private:
+
+			static Vector<Slot> slots_; //!< The slots that handles index into
+			static uint32_t free_; //!< The first free slot, or INVALID_INDEX_ if there is none
+			static uint32_t frame_; //!< The current frame, to find the least recently used content with
+			static Vector<ContentBase*> dense_[ContentBase::Types::kCount]; //!< The content, densely stored by type
+			static Vector<uint32_t> owners_[ContentBase::Types::kCount]; //!< The slot that owns each entry in the dense arrays
+
+			static const uint32_t INVALID_INDEX_; //!< The index that marks the end of the free list
+		};
+
 		//-----------------------------------------------------------------------------------------------
-		template <typename T>
-		inline ContentPtr<T>::ContentPtr() :
-			ptr_(nullptr)
+		inline ContentBase* ContentTable::Resolve(uint32_t index, uint32_t generation)
 		{
+			if (index >= slots_.size())
+			{
+				return nullptr;
+			}
 
+			Slot& slot = slots_[index];
+
+			if (slot.generation != generation || slot.type == ContentBase::Types::kCount)
+			{
+				return nullptr;
+			}
+
+			slot.used = frame_;
+
+			return dense_[slot.type][slot.dense];
 		}
 
 		//-----------------------------------------------------------------------------------------------
 		template <typename T>
-		inline ContentPtr<T>::ContentPtr(T* ptr) :
-			ptr_(Memory::MakeShared<T>(ptr))
+		inline ContentPtr<T>::ContentPtr() :
+			index_(0),
+			generation_(0)
 		{
 
 		}
 
 		//-----------------------------------------------------------------------------------------------
-		template <typename T> template <typename Y>
-		inline ContentPtr<T>::ContentPtr(const ContentPtr<Y>& other)
+		template <typename T>
+		inline ContentPtr<T>::ContentPtr(uint32_t index, uint32_t generation) :
+			index_(index),
+			generation_(generation)
 		{
-			ptr_ = other.ptr();
+
 		}
 
 		//-----------------------------------------------------------------------------------------------
 		template <typename T> template <typename Y>
-		inline ContentPtr<T> ContentPtr<T>::operator=(Y* ptr)
+		inline ContentPtr<T>::ContentPtr(const ContentPtr<Y>& other) :
+			index_(other.index_),
+			generation_(other.generation_)
 		{
-			ptr_ = Memory::MakeShared<Y>(ptr);
-			return *this;
+
 		}
 
 		//-----------------------------------------------------------------------------------------------
 		template <typename T>
-		const SharedPtr<ContentBase>& ContentPtr<T>::ptr() const
+		inline T* ContentPtr<T>::Get() const
 		{
-			return ptr_;
+			return static_cast<T*>(ContentTable::Resolve(index_, generation_));
 		}
 
 		//-----------------------------------------------------------------------------------------------
 		template <typename T>
-		inline T* ContentPtr<T>::Get()
+		inline T* ContentPtr<T>::operator->() const
 		{
-			if (ptr_ == nullptr || ptr_->is_valid() == false)
-			{
-				ptr_.reset();
-				return nullptr;
-			}
-
-			return static_cast<T*>(ptr_.get());
+			return Get();
 		}
 
 		//-----------------------------------------------------------------------------------------------
 		template <typename T>
-		inline T* ContentPtr<T>::operator->()
+		inline bool ContentPtr<T>::is_valid() const
 		{
-			return Get();
+			return ContentTable::Resolve(index_, generation_) != nullptr;
 		}
 
 		//-----------------------------------------------------------------------------------------------
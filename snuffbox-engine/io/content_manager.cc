@@ -9,24 +9,59 @@
 #include "script.h"
 #include "shader.h"
 
+#include "../core/thread_pool.h"
+#include "../core/timer.h"
+
+#include <EASTL/sort.h>
+#include <EASTL/heap.h>
+
+#ifdef SNUFF_LINUX
+#include <sys/stat.h>
+#endif
+
+#ifdef SNUFF_JAVASCRIPT
+#include "../js/js_state_wrapper.h"
+#include "../js/js_callback.h"
+#endif
+
 namespace snuffbox
 {
 	namespace engine
 	{
+		//-----------------------------------------------------------------------------------------------
+		const float ContentManager::DEFAULT_LOAD_BUDGET_ = 4.0f;
+		const char* ContentManager::ARCHIVE_NAME_ = "content.pack";
+
+		//-----------------------------------------------------------------------------------------------
+		const char* ContentManager::BUDGET_CVARS_[] =
+		{
+			"script_budget",
+			"shader_budget"
+		};
+
 		//-----------------------------------------------------------------------------------------------
 		ContentManager::ContentManager() :
 			watch_(this),
 			renderer_(nullptr),
-			application_(nullptr)
+			application_(nullptr),
+			thread_pool_(nullptr),
+			in_flight_(0)
 		{
-
+			for (int i = 0; i < ContentBase::Types::kCount; ++i)
+			{
+				stats_[i].used = 0;
+				stats_[i].budget = 0;
+				stats_[i].evictions = 0;
+				stats_[i].reloads = 0;
+			}
 		}
 
 		//-----------------------------------------------------------------------------------------------
-		void ContentManager::Initialise(CVar* cvar, graphics::Renderer* renderer, SnuffboxApp* app)
+		void ContentManager::Initialise(CVar* cvar, graphics::Renderer* renderer, SnuffboxApp* app, ThreadPool* thread_pool)
 		{
 			renderer_ = renderer;
 			application_ = app;
+			thread_pool_ = thread_pool;
 
 			LogService& log = Services::Get<LogService>();
 			CVarString* src = cvar->Get<CVarString>("src_directory");
@@ -36,8 +71,6 @@ namespace snuffbox
 				src_directory_ = src->value();
 
 				log.Log(console::LogSeverity::kInfo, "Set the source directory of the project to '{0}'", src_directory_);
-
-				return;
 			}
 			else
 			{
@@ -46,40 +79,445 @@ namespace snuffbox
 
 				log.Log(console::LogSeverity::kInfo, "Set the source directory of the project to the target root directory");
 			}
+
+			MountArchive(cvar);
 		}
 
 		//-----------------------------------------------------------------------------------------------
-		void ContentManager::Reload(const String& path)
+		void ContentManager::MountArchive(CVar* cvar)
 		{
-			for (int i = 0; i < ContentBase::Types::kCount; ++i)
+			LogService& log = Services::Get<LogService>();
+
+			CVarBoolean* use_archive = cvar->Get<CVarBoolean>("archive");
+			CVarBoolean* reload = cvar->Get<CVarBoolean>("reload");
+
+			if (use_archive != nullptr && use_archive->value() == false)
 			{
-				ContentMap& map = loaded_content_[i];
-				
-				ContentMap::iterator it = map.find(path);
-				if (it != map.end())
+				log.Log(console::LogSeverity::kInfo, "Loading loose files, the content archive was disabled");
+				return;
+			}
+
+			if (reload != nullptr && reload->value() == true)
+			{
+				log.Log(console::LogSeverity::kInfo, "Loading loose files, as hot-reloading reads changes from disk");
+				return;
+			}
+
+			String path = FullPath(ARCHIVE_NAME_);
+
+			Timer mount_time("--Archive mount");
+			bool mounted = archive_.Mount(path);
+			mount_time.Stop(Timer::Unit::kMilliseconds, true);
+
+			if (mounted == false)
+			{
+				log.Log(console::LogSeverity::kInfo, "No content archive found at '{0}', loading loose files", path);
+				return;
+			}
+
+			File::Mount(&archive_);
+			log.Log(console::LogSeverity::kInfo, "Mounted content archive '{0}'", path);
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void ContentManager::Reload(const Vector<String>& changed)
+		{
+			Vector<String> affected = Affected(changed);
+
+			LogService& log = Services::Get<LogService>();
+			Vector<String> relative;
+
+			size_t root = FullPath("").size();
+
+			for (size_t i = 0; i < affected.size(); ++i)
+			{
+				const String& path = affected.at(i);
+
+				for (int j = 0; j < ContentBase::Types::kCount; ++j)
 				{
-					File* f = File::Open(path, File::AccessFlags::kRead | File::AccessFlags::kBinary);
-					it->second->Reload(f, this);
-					File::Close(f);
+					ContentMap& map = loaded_content_[j];
 
-					break;
+					ContentMap::iterator it = map.find(path);
+					if (it != map.end())
+					{
+						ContentBase* content = it->second.Get();
+						stats_[j].used -= content->size();
+
+						File* f = File::Open(path, File::AccessFlags::kRead | File::AccessFlags::kBinary | File::AccessFlags::kMapped);
+						content->Reload(f, this);
+						File::Close(f);
+
+						stats_[j].used += content->size();
+
+						break;
+					}
 				}
+
+				relative.push_back(path.size() >= root ? path.substr(root) : path);
+				log.Log(console::LogSeverity::kInfo, "Reloaded file: '{0}'", path);
 			}
 
-			application_->Reload(path.c_str() + FullPath("").size());
+#ifdef SNUFF_JAVASCRIPT
+			JSStateWrapper::Instance()->modules().Reload(affected);
+#endif
 
-			Services::Get<LogService>().Log(console::LogSeverity::kInfo, "Reloaded file: '{0}'", path);
+			application_->Reload(relative);
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		Vector<String> ContentManager::Affected(const Vector<String>& changed) const
+		{
+			Vector<String> affected;
+			Map<String, bool> visited;
+
+			for (size_t i = 0; i < changed.size(); ++i)
+			{
+				if (visited.emplace(changed.at(i), true).second == true)
+				{
+					affected.push_back(changed.at(i));
+				}
+			}
+
+			for (size_t i = 0; i < affected.size(); ++i)
+			{
+				Map<String, Vector<String>>::const_iterator it = dependents_.find(affected.at(i));
+
+				if (it == dependents_.end())
+				{
+					continue;
+				}
+
+				const Vector<String>& dependents = it->second;
+
+				for (size_t j = 0; j < dependents.size(); ++j)
+				{
+					if (visited.emplace(dependents.at(j), true).second == true)
+					{
+						affected.push_back(dependents.at(j));
+					}
+				}
+			}
+
+			return affected;
 		}
 
 		//-----------------------------------------------------------------------------------------------
 		void ContentManager::Update()
 		{
+			ContentTable::Tick();
+
 			CVarBoolean* reload = Services::Get<CVarService>().Get<CVarBoolean>("reload");
 
 			if (reload != nullptr && reload->value() == true)
 			{
 				watch_.Update();
 			}
+
+			UpdateRequests();
+
+			for (int i = 0; i < ContentBase::Types::kCount; ++i)
+			{
+				Evict(static_cast<ContentBase::Types>(i));
+			}
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void ContentManager::UpdateRequests()
+		{
+			float budget = DEFAULT_LOAD_BUDGET_;
+
+			CVarNumber* load_budget = Services::Get<CVarService>().Get<CVarNumber>("load_budget");
+			if (load_budget != nullptr)
+			{
+				budget = load_budget->value();
+			}
+
+			Timer timer("Content requests");
+			ContentRequest* request = nullptr;
+
+			while (true)
+			{
+				{
+					std::lock_guard<std::mutex> lock(requests_mutex_);
+
+					if (decompiled_.empty() == true)
+					{
+						break;
+					}
+
+					request = decompiled_.front();
+					decompiled_.pop();
+				}
+
+				FinishRequest(request);
+
+				if (timer.Elapsed(Timer::Unit::kMilliseconds) >= budget)
+				{
+					break;
+				}
+			}
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void ContentManager::FinishRequest(ContentRequest* request)
+		{
+			ContentHandle handle;
+
+			for (size_t i = 0; i < requests_.size(); ++i)
+			{
+				if (requests_.at(i).get() == request)
+				{
+					handle = requests_.at(i);
+					requests_.erase(requests_.begin() + i);
+					break;
+				}
+			}
+
+			if (request->state() == ContentRequest::States::kDecompiled)
+			{
+				ContentMap& map = loaded_content_[request->type_];
+				ContentMap::iterator it = map.find(request->full_path_);
+				ContentBase* content = request->pending_;
+
+				if (it != map.end())
+				{
+					request->content_ = it->second;
+					request->state_ = ContentRequest::States::kLoaded;
+				}
+				else if (content->Create(this) == true)
+				{
+					request->content_ = InsertContent(request->full_path_, content, request->type_);
+					request->pending_ = nullptr;
+
+					request->state_ = ContentRequest::States::kLoaded;
+
+					Services::Get<LogService>().Log(console::LogSeverity::kDebug, "Loaded '{0}' asynchronously", request->path_);
+				}
+				else
+				{
+					request->state_ = ContentRequest::States::kFailed;
+				}
+			}
+
+			if (request->pending_ != nullptr)
+			{
+				DestroyContent(request->pending_, request->type_);
+				request->pending_ = nullptr;
+			}
+
+			if (request->state() == ContentRequest::States::kFailed)
+			{
+				request->content_ = ContentPtr<ContentBase>();
+				Services::Get<LogService>().Log(console::LogSeverity::kError, "Could not load '{0}' asynchronously", request->path_);
+			}
+
+			for (size_t i = 0; i < request->callbacks_.size(); ++i)
+			{
+				request->callbacks_.at(i)(request);
+			}
+
+			request->callbacks_.clear();
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void ContentManager::WaitForRequests()
+		{
+			std::unique_lock<std::mutex> lock(requests_mutex_);
+			requests_condition_.wait(lock, [this]()
+			{
+				return in_flight_ == 0;
+			});
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void ContentManager::Evict(ContentBase::Types type)
+		{
+			Stats& stats = stats_[type];
+			stats.budget = 0;
+
+			CVarNumber* budget = Services::Get<CVarService>().Get<CVarNumber>(BUDGET_CVARS_[type]);
+			if (budget != nullptr && budget->value() > 0.0f)
+			{
+				stats.budget = static_cast<size_t>(budget->value() * 1024.0f);
+			}
+
+			if (stats.budget == 0)
+			{
+				return;
+			}
+
+			ContentMap& map = loaded_content_[type];
+			Vector<Recent>& heap = recent_[type];
+			Vector<Recent> pinned;
+
+			while (stats.used > stats.budget && heap.empty() == false)
+			{
+				eastl::pop_heap(heap.begin(), heap.end(), UsedLater);
+				Recent recent = heap.back();
+				heap.pop_back();
+
+				if (ContentTable::Find(recent.handle) == nullptr)
+				{
+					continue;
+				}
+
+				uint32_t used = ContentTable::LastUsed(recent.handle);
+
+				if (used != recent.used)
+				{
+					recent.used = used;
+					heap.push_back(recent);
+					eastl::push_heap(heap.begin(), heap.end(), UsedLater);
+
+					continue;
+				}
+
+				if (ContentTable::Pins(recent.handle) > 0)
+				{
+					pinned.push_back(recent);
+					continue;
+				}
+
+				ContentMap::iterator it = map.find(recent.full_path);
+
+				if (it == map.end())
+				{
+					continue;
+				}
+
+				watch_.Remove(recent.full_path);
+				ReleaseContent(it->second, type);
+				map.erase(it);
+
+				evicted_[type].emplace(recent.full_path, true);
+				++stats.evictions;
+
+				Services::Get<LogService>().Log(console::LogSeverity::kDebug, "Evicted '{0}', {1} of {2} bytes in use", recent.full_path, stats.used, stats.budget);
+			}
+
+			for (size_t i = 0; i < pinned.size(); ++i)
+			{
+				heap.push_back(pinned.at(i));
+				eastl::push_heap(heap.begin(), heap.end(), UsedLater);
+			}
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void ContentManager::PushRecent(const String& full_path, const ContentPtr<ContentBase>& handle, ContentBase::Types type)
+		{
+			Vector<Recent>& heap = recent_[type];
+
+			if (heap.size() > 2 * loaded_content_[type].size() + 16)
+			{
+				size_t kept = 0;
+
+				for (size_t i = 0; i < heap.size(); ++i)
+				{
+					if (ContentTable::Find(heap.at(i).handle) != nullptr)
+					{
+						heap.at(kept++) = heap.at(i);
+					}
+				}
+
+				heap.resize(kept);
+				eastl::make_heap(heap.begin(), heap.end(), UsedLater);
+			}
+
+			Recent recent;
+			recent.used = ContentTable::LastUsed(handle);
+			recent.full_path = full_path;
+			recent.handle = handle;
+
+			heap.push_back(recent);
+			eastl::push_heap(heap.begin(), heap.end(), UsedLater);
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		bool ContentManager::UsedLater(const Recent& a, const Recent& b)
+		{
+			return a.used > b.used;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		ContentBase* ContentManager::CreateContent(ContentBase::Types type)
+		{
+			ContentBase* content = nullptr;
+			
+			switch (type)
+			{
+			case ContentBase::Types::kScript:
+				content = Memory::default_allocator().Construct<Script>();
+				break;
+
+			case ContentBase::Types::kShader:
+				content = Memory::default_allocator().Construct<Shader>();
+				break;
+
+			default:
+				break;
+			}
+
+			return content;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void ContentManager::DestroyContent(ContentBase* content, ContentBase::Types type)
+		{
+			switch (type)
+			{
+			case ContentBase::Types::kScript:
+				Memory::default_allocator().Destruct<Script>(static_cast<Script*>(content));
+				break;
+
+			case ContentBase::Types::kShader:
+				Memory::default_allocator().Destruct<Shader>(static_cast<Shader*>(content));
+				break;
+
+			default:
+				break;
+			}
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		ContentPtr<ContentBase> ContentManager::InsertContent(const String& full_path, ContentBase* content, ContentBase::Types type)
+		{
+			ContentPtr<ContentBase> handle = ContentTable::Insert(content, type);
+
+			loaded_content_[type].emplace(full_path, handle);
+			watch_.Add(full_path);
+
+			if (content->evictable() == true)
+			{
+				PushRecent(full_path, handle, type);
+			}
+
+			Stats& stats = stats_[type];
+			stats.used += content->size();
+
+			if (evicted_[type].erase(full_path) > 0)
+			{
+				++stats.reloads;
+			}
+
+			Evict(type);
+
+			return handle;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void ContentManager::ReleaseContent(const ContentPtr<ContentBase>& handle, ContentBase::Types type)
+		{
+			ContentBase* content = ContentTable::Remove(handle);
+
+			if (content == nullptr)
+			{
+				return;
+			}
+
+			stats_[type].used -= content->size();
+
+			content->Unload(this);
+			DestroyContent(content, type);
 		}
 
 		//-----------------------------------------------------------------------------------------------
@@ -97,6 +535,12 @@ namespace snuffbox
 				return it->second;
 			}
 
+			if (evicted_[type].find(full_path) != evicted_[type].end())
+			{
+				LoadContentAsync(path, type, nullptr);
+				return ContentPtr<ContentBase>();
+			}
+
 			if (quiet == false)
 			{
 				log.Log(console::LogSeverity::kError, "Content with path '{0}' could not be found\nAre you sure it has been loaded correctly and the type is correct?", path);
@@ -130,44 +574,213 @@ namespace snuffbox
 				return it->second;
 			}
 
-			ContentPtr<ContentBase> content = nullptr;
-			
-			switch (type)
-			{
-			case ContentBase::Types::kScript:
-				content = Memory::default_allocator().Construct<Script>();
-				break;
-
-			case ContentBase::Types::kShader:
-				content = Memory::default_allocator().Construct<Shader>();
-				break;
-
-			default:
-				break;
-			}
+			ContentBase* content = CreateContent(type);
 
-			log.Assert(content.ptr() != nullptr, "Content to be loaded from path '{0}' with type '{1}' was null after file reading", path, type);
+			log.Assert(content != nullptr, "Content to be loaded from path '{0}' with type '{1}' was null after file reading", path, type);
 
-			File* f = File::Open(full_path, File::AccessFlags::kRead | File::AccessFlags::kBinary);
-			bool success = content.ptr()->Load(f, this);
+			File* f = File::Open(full_path, File::AccessFlags::kRead | File::AccessFlags::kBinary | File::AccessFlags::kMapped);
+			bool success = content->Load(f, this);
 			File::Close(f);
 
 			if (success == false)
 			{
+				DestroyContent(content, type);
 				return ContentPtr<ContentBase>();
 			}
 
-			content.ptr()->set_is_valid(true);
-			map.emplace(full_path, content);
-			
-			watch_.Add(full_path);
+			ContentPtr<ContentBase> handle = InsertContent(full_path, content, type);
 
 			if (quiet == false)
 			{
 				log.Log(console::LogSeverity::kDebug, "Loaded '{0}'", path);
 			}
 
-			return content;
+			return handle;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		ContentHandle ContentManager::LoadContentAsync(const String& path, ContentBase::Types type, const ContentRequest::Callback& callback)
+		{
+			String full_path = FullPath(path);
+
+			for (size_t i = 0; i < requests_.size(); ++i)
+			{
+				const ContentHandle& pending = requests_.at(i);
+
+				if (pending->type_ == type && pending->full_path_ == full_path)
+				{
+					if (callback != nullptr)
+					{
+						pending->callbacks_.push_back(callback);
+					}
+
+					return pending;
+				}
+			}
+
+			ContentHandle request = Memory::ConstructShared<ContentRequest>();
+			request->path_ = path;
+			request->full_path_ = full_path;
+			request->type_ = type;
+
+			if (callback != nullptr)
+			{
+				request->callbacks_.push_back(callback);
+			}
+
+			requests_.push_back(request);
+
+			ContentMap& map = loaded_content_[type];
+			ContentMap::iterator it = map.find(full_path);
+
+			if (it != map.end())
+			{
+				request->content_ = it->second;
+				request->state_ = ContentRequest::States::kLoaded;
+
+				std::lock_guard<std::mutex> lock(requests_mutex_);
+				decompiled_.push(request.get());
+
+				return request;
+			}
+
+			request->pending_ = CreateContent(type);
+
+			if (request->pending_ == nullptr)
+			{
+				request->state_ = ContentRequest::States::kFailed;
+
+				std::lock_guard<std::mutex> lock(requests_mutex_);
+				decompiled_.push(request.get());
+
+				return request;
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(requests_mutex_);
+				++in_flight_;
+			}
+
+			ContentRequest* decompiling = request.get();
+
+			ThreadPool::Task task = [this, decompiling]()
+			{
+				File* f = File::Open(decompiling->full_path_, File::AccessFlags::kRead | File::AccessFlags::kBinary | File::AccessFlags::kMapped);
+				bool success = decompiling->pending_->Decompile(f);
+				File::Close(f);
+
+				decompiling->state_ = success == true ? ContentRequest::States::kDecompiled : ContentRequest::States::kFailed;
+
+				{
+					std::lock_guard<std::mutex> lock(requests_mutex_);
+					decompiled_.push(decompiling);
+					--in_flight_;
+				}
+
+				requests_condition_.notify_all();
+			};
+
+			if (thread_pool_ != nullptr)
+			{
+				thread_pool_->Schedule(task);
+			}
+			else
+			{
+				task();
+			}
+
+			return request;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		unsigned int ContentManager::Preload(const ContentManifest& manifest, const ContentManifest::Callback& progress)
+		{
+			struct Pending
+			{
+				const ContentManifest::Entry* entry;
+				String full_path;
+				uint64_t locality;
+			};
+
+			const Vector<ContentManifest::Entry>& entries = manifest.entries();
+			Vector<Pending> pending;
+			pending.reserve(entries.size());
+
+			for (size_t i = 0; i < entries.size(); ++i)
+			{
+				Pending p;
+				p.entry = &entries.at(i);
+				p.full_path = FullPath(p.entry->path);
+				p.locality = Locality(p.full_path);
+
+				pending.push_back(p);
+			}
+
+			eastl::sort(pending.begin(), pending.end(), [](const Pending& a, const Pending& b)
+			{
+				if (a.locality != b.locality)
+				{
+					return a.locality < b.locality;
+				}
+
+				return a.full_path < b.full_path;
+			});
+
+			SharedPtr<ContentManifest::Progress> state = Memory::ConstructShared<ContentManifest::Progress>();
+			state->loaded = 0;
+			state->failed = 0;
+			state->total = static_cast<unsigned int>(pending.size());
+
+			Services::Get<LogService>().Log(console::LogSeverity::kDebug, "Preloading {0} files", state->total);
+
+			for (size_t i = 0; i < pending.size(); ++i)
+			{
+				const ContentManifest::Entry* entry = pending.at(i).entry;
+
+				LoadContentAsync(entry->path, entry->type, [state, progress](ContentRequest* request)
+				{
+					if (request->state() == ContentRequest::States::kLoaded)
+					{
+						++state->loaded;
+					}
+					else
+					{
+						++state->failed;
+					}
+
+					if (progress != nullptr)
+					{
+						progress(*state);
+					}
+				});
+			}
+
+			return state->total;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		uint64_t ContentManager::Locality(const String& full_path) const
+		{
+			if (archive_.mounted() == true)
+			{
+				size_t size;
+				const unsigned char* data = archive_.Find(full_path, &size);
+
+				if (data != nullptr)
+				{
+					return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(data));
+				}
+			}
+
+#ifdef SNUFF_LINUX
+			struct stat attributes;
+			if (stat(full_path.c_str(), &attributes) == 0)
+			{
+				return static_cast<uint64_t>(attributes.st_ino);
+			}
+#endif
+
+			return 0;
 		}
 
 		//-----------------------------------------------------------------------------------------------
@@ -183,12 +796,16 @@ namespace snuffbox
 			if (it != map.end())
 			{
 				watch_.Remove(full_path);
-				it->second.Get()->set_is_valid(false);
-				it->second.Get()->Unload(this);
+				ReleaseContent(it->second, type);
 				map.erase(it);
 				return;
 			}
 
+			if (evicted_[type].erase(full_path) > 0)
+			{
+				return;
+			}
+
 			if (quiet == false)
 			{
 				log.Log(console::LogSeverity::kWarning, "Content with path '{0}' was never loaded, skipping unload", path);
@@ -198,9 +815,26 @@ namespace snuffbox
 		//-----------------------------------------------------------------------------------------------
 		void ContentManager::UnloadAll()
 		{
+			WaitForRequests();
+
+			while (decompiled_.empty() == false)
+			{
+				ContentRequest* request = decompiled_.front();
+				decompiled_.pop();
+
+				if (request->state() == ContentRequest::States::kDecompiled)
+				{
+					request->state_ = ContentRequest::States::kFailed;
+				}
+
+				FinishRequest(request);
+			}
+
 			for (int i = 0; i < ContentBase::Types::kCount; ++i)
 			{
 				ContentMap& map = loaded_content_[i];
+				evicted_[i].clear();
+				recent_[i].clear();
 
 				if (map.empty() == true)
 				{
@@ -209,14 +843,36 @@ namespace snuffbox
 
 				for (ContentMap::iterator it = map.begin(); it != map.end(); ++it)
 				{
-					it->second->Unload(this);
-					it->second->set_is_valid(false);
+					ReleaseContent(it->second, static_cast<ContentBase::Types>(i));
 				}
 
 				map.clear();
 			}
 		}
 
+		//-----------------------------------------------------------------------------------------------
+		void ContentManager::Watch(const String& path)
+		{
+			watch_.Add(FullPath(path));
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void ContentManager::Depend(const String& path, const String& dependency)
+		{
+			String full_path = FullPath(path);
+			Vector<String>& dependents = dependents_[FullPath(dependency)];
+
+			for (size_t i = 0; i < dependents.size(); ++i)
+			{
+				if (dependents.at(i) == full_path)
+				{
+					return;
+				}
+			}
+
+			dependents.push_back(full_path);
+		}
+
 		//-----------------------------------------------------------------------------------------------
 		String ContentManager::FullPath(const String& path) const
 		{
@@ -229,15 +885,30 @@ namespace snuffbox
 			return renderer_;
 		}
 
+		//-----------------------------------------------------------------------------------------------
+		const ContentManager::Stats& ContentManager::stats(ContentBase::Types type) const
+		{
+			return stats_[type];
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		ContentManager::~ContentManager()
+		{
+			File::Mount(nullptr);
+		}
+
 		//-----------------------------------------------------------------------------------------------
 		JS_REGISTER_IMPL_SINGLE(ContentManager, JS_BODY(
 		{
 			JSFunctionRegister funcs[] =
 			{
 				JS_FUNCTION_REG(load),
+				JS_FUNCTION_REG(loadAsync),
+				JS_FUNCTION_REG(preload),
 				JS_FUNCTION_REG(get),
 				JS_FUNCTION_REG(unload),
 				JS_FUNCTION_REG(unloadAll),
+				JS_FUNCTION_REG(stats),
 				JS_FUNCTION_REG_END
 			};
 
@@ -252,7 +923,7 @@ namespace snuffbox
 		{
 			JSWrapper wrapper(args);
 
-			if (wrapper.Check("SN") == true)
+			if (wrapper.Check<JSWrapper::kString, JSWrapper::kNumber>() == true)
 			{
 				String path = wrapper.GetValue<String>(0, "");
 				ContentBase::Types type = static_cast<ContentBase::Types>(wrapper.GetValue<int>(1, static_cast<int>(ContentBase::Types::kCount)));
@@ -260,17 +931,171 @@ namespace snuffbox
 
 				ContentManager& cm = static_cast<ContentManager&>(cs);
 
-				v8::Local<v8::Object> ptr = JSWrapper::New<ContentPtr<ContentBase>>(cm.LoadContent(path, type, false));
+				v8::Local<v8::Object> ptr = JSWrapper::New<ContentObject>(cm.LoadContent(path, type, false));
 				wrapper.ReturnValue<v8::Local<v8::Object>>(ptr);
 			}
 		}));
 
+		//-----------------------------------------------------------------------------------------------
+		JS_FUNCTION_IMPL(ContentManager, loadAsync, JS_BODY(
+		{
+			JSWrapper wrapper(args);
+
+			if (wrapper.Check<JSWrapper::kString, JSWrapper::kNumber>() == true)
+			{
+				String path = wrapper.GetValue<String>(0, "");
+				ContentBase::Types type = static_cast<ContentBase::Types>(wrapper.GetValue<int>(1, static_cast<int>(ContentBase::Types::kCount)));
+				ContentService& cs = Services::Get<ContentService>();
+
+				ContentManager& cm = static_cast<ContentManager&>(cs);
+
+				v8::Isolate* isolate = args.GetIsolate();
+				v8::Local<v8::Promise::Resolver> resolver;
+
+				if (v8::Promise::Resolver::New(isolate->GetCurrentContext()).ToLocal(&resolver) == false)
+				{
+					return;
+				}
+
+				typedef v8::Persistent<v8::Promise::Resolver> Persistent;
+				Persistent* persistent = Memory::default_allocator().Construct<Persistent>(isolate, resolver);
+
+				cm.LoadContentAsync(path, type, [persistent](ContentRequest* request)
+				{
+					JSStateWrapper* state = JSStateWrapper::Instance();
+					v8::Isolate* isolate = state->isolate();
+
+					{
+						JSStateWrapper::IsolateLock lock(isolate);
+
+						v8::Local<v8::Context> ctx = state->Context();
+						v8::Local<v8::Promise::Resolver> resolver = v8::Local<v8::Promise::Resolver>::New(isolate, *persistent);
+
+						if (request->state() == ContentRequest::States::kLoaded)
+						{
+							resolver->Resolve(ctx, JSWrapper::New<ContentObject>(request->content()));
+						}
+						else
+						{
+							resolver->Reject(ctx, JSWrapper::CreateString("Could not load '" + request->path() + "'"));
+						}
+
+						isolate->RunMicrotasks();
+					}
+
+					persistent->Reset();
+					Memory::default_allocator().Destruct(persistent);
+				});
+
+				wrapper.ReturnValue<v8::Local<v8::Promise>>(resolver->GetPromise());
+			}
+		}));
+
+		//-----------------------------------------------------------------------------------------------
+		JS_FUNCTION_IMPL(ContentManager, preload, JS_BODY(
+		{
+			JSWrapper wrapper(args);
+
+			if (wrapper.Check<JSWrapper::kArray>() == true)
+			{
+				v8::Isolate* isolate = args.GetIsolate();
+				v8::Local<v8::Context> ctx = isolate->GetCurrentContext();
+				v8::Local<v8::Array> list = v8::Local<v8::Array>::Cast(args[0]);
+
+				ContentManifest manifest;
+				v8::Local<v8::Value> value, path, type;
+
+				for (uint32_t i = 0; i < list->Length(); ++i)
+				{
+					if (list->Get(ctx, i).ToLocal(&value) == false || value->IsObject() == false)
+					{
+						continue;
+					}
+
+					v8::Local<v8::Object> entry = value.As<v8::Object>();
+
+					if (entry->Get(ctx, JSWrapper::CreateString("path")).ToLocal(&path) == false || path->IsString() == false ||
+						entry->Get(ctx, JSWrapper::CreateString("type")).ToLocal(&type) == false || type->IsNumber() == false)
+					{
+						continue;
+					}
+
+					v8::String::Utf8Value utf8(path);
+					manifest.Add(*utf8, static_cast<ContentBase::Types>(static_cast<int>(type.As<v8::Number>()->Value())));
+				}
+
+				v8::Local<v8::Promise::Resolver> resolver;
+
+				if (v8::Promise::Resolver::New(ctx).ToLocal(&resolver) == false)
+				{
+					return;
+				}
+
+				typedef JSCallback<unsigned int, unsigned int, unsigned int> Callback;
+				SharedPtr<Callback> on_progress;
+
+				if (args.Length() > 1 && args[1]->IsFunction() == true)
+				{
+					on_progress = Memory::ConstructShared<Callback>();
+					on_progress->Set(args[1]);
+				}
+
+				typedef v8::Persistent<v8::Promise::Resolver> Persistent;
+				SharedPtr<Persistent> persistent = Memory::ConstructShared<Persistent>(isolate, resolver);
+
+				ContentManifest::Callback progress = [on_progress, persistent](const ContentManifest::Progress& p)
+				{
+					if (on_progress != nullptr)
+					{
+						on_progress->Call(p.loaded, p.failed, p.total);
+					}
+
+					if (p.loaded + p.failed < p.total)
+					{
+						return;
+					}
+
+					JSStateWrapper* state = JSStateWrapper::Instance();
+					v8::Isolate* isolate = state->isolate();
+
+					{
+						JSStateWrapper::IsolateLock lock(isolate);
+
+						v8::Local<v8::Context> ctx = state->Context();
+						v8::Local<v8::Promise::Resolver> resolver = v8::Local<v8::Promise::Resolver>::New(isolate, *persistent);
+
+						v8::Local<v8::Object> result = JSWrapper::CreateObject();
+						JSWrapper::SetObjectValue(result, "loaded", p.loaded);
+						JSWrapper::SetObjectValue(result, "failed", p.failed);
+						JSWrapper::SetObjectValue(result, "total", p.total);
+
+						resolver->Resolve(ctx, result);
+						isolate->RunMicrotasks();
+					}
+
+					persistent->Reset();
+				};
+
+				ContentService& cs = Services::Get<ContentService>();
+
+				if (cs.Preload(manifest, progress) == 0)
+				{
+					ContentManifest::Progress empty;
+					empty.loaded = empty.failed = empty.total = 0;
+
+					progress(empty);
+				}
+
+				wrapper.ReturnValue<v8::Local<v8::Promise>>(resolver->GetPromise());
+			}
+		}));
+
 		//-----------------------------------------------------------------------------------------------
 		JS_FUNCTION_IMPL(ContentManager, get, JS_BODY(
 		{
 			JSWrapper wrapper(args);
 
-			if (wrapper.Check("SN") == true)
+			if (wrapper.Check<JSWrapper::kString, JSWrapper::kNumber>() == true)
 			{
 				String path = wrapper.GetValue<String>(0, "");
 				ContentBase::Types type = static_cast<ContentBase::Types>(wrapper.GetValue<int>(1, static_cast<int>(ContentBase::Types::kCount)));
@@ -278,7 +1103,7 @@ namespace snuffbox
 
 				ContentManager& cm = static_cast<ContentManager&>(cs);
 
-				v8::Local<v8::Object> ptr = JSWrapper::New<ContentPtr<ContentBase>>(cm.GetContent(path, type, false));
+				v8::Local<v8::Object> ptr = JSWrapper::New<ContentObject>(cm.GetContent(path, type, false));
 				wrapper.ReturnValue<v8::Local<v8::Object>>(ptr);
 			}
 		}));
@@ -288,7 +1113,7 @@ namespace snuffbox
 		{
 			JSWrapper wrapper(args);
 
-			if (wrapper.Check("SN") == true)
+			if (wrapper.Check<JSWrapper::kString, JSWrapper::kNumber>() == true)
 			{
 				String path = wrapper.GetValue<String>(0, "");
 				ContentBase::Types type = static_cast<ContentBase::Types>(wrapper.GetValue<int>(1, static_cast<int>(ContentBase::Types::kCount)));
@@ -305,5 +1130,35 @@ namespace snuffbox
 		{
 			Services::Get<ContentService>().UnloadAll();
 		}));
+
+		//-----------------------------------------------------------------------------------------------
+		JS_FUNCTION_IMPL(ContentManager, stats, JS_BODY(
+		{
+			JSWrapper wrapper(args);
+
+			if (wrapper.Check<JSWrapper::kNumber>() == true)
+			{
+				int type = wrapper.GetValue<int>(0, static_cast<int>(ContentBase::Types::kCount));
+
+				if (type < 0 || type >= ContentBase::Types::kCount)
+				{
+					return;
+				}
+
+				ContentService& cs = Services::Get<ContentService>();
+				ContentManager& cm = static_cast<ContentManager&>(cs);
+
+				const Stats& stats = cm.stats(static_cast<ContentBase::Types>(type));
+
+				v8::Local<v8::Object> to_return = JSWrapper::CreateObject();
+
+				JSWrapper::SetObjectValue(to_return, "used", static_cast<double>(stats.used));
+				JSWrapper::SetObjectValue(to_return, "budget", static_cast<double>(stats.budget));
+				JSWrapper::SetObjectValue(to_return, "evictions", stats.evictions);
+				JSWrapper::SetObjectValue(to_return, "reloads", stats.reloads);
+
+				wrapper.ReturnValue<v8::Local<v8::Object>>(to_return);
+			}
+		}));
 	}
 }
\ No newline at end of file
@@ -5,6 +5,11 @@
 
 #include "../js/js_defines.h"
 #include "file_watch.h"
+#include "content_request.h"
+#include "archive.h"
+
+#include <mutex>
+#include <condition_variable>
 
 namespace snuffbox
 {
@@ -18,6 +23,7 @@ namespace snuffbox
 		class CVar;
 		class SnuffboxApp;
 		class FileWatch;
+		class ThreadPool;
 
 		/**
 		* @class snuffbox::engine::ContentManager : [JSObject] public snuffbox::engine::ContentService
@@ -31,6 +37,21 @@ namespace snuffbox
 			friend class Allocator;
 			friend class FileWatch;
 
+		public:
+
+			/**
+			* @struct snuffbox::engine::ContentManager::Stats
+			* @brief The memory usage and eviction statistics of a single content type
+			* @author Daniel Konings
+			*/
+			struct Stats
+			{
+				size_t used; //!< The number of bytes the loaded content of this type occupies
+				size_t budget; //!< The number of bytes the content of this type may occupy, 0 if unlimited
+				unsigned int evictions; //!< The number of times content of this type was evicted
+				unsigned int reloads; //!< The number of times evicted content of this type was loaded again
+			};
+
 		protected:
 
 			/**
@@ -43,20 +64,92 @@ namespace snuffbox
 			* @param[in] cvar (snuffbox::engine::CVar*) The CVar system
 			* @param[in] renderer (snuffbox::graphics::Renderer*) The current renderer
 			* @param[in] app (snuffbox::engine::SnuffboxApp*) The current application
+			* @param[in] thread_pool (snuffbox::engine::ThreadPool*) The thread pool to decompile asynchronously loaded content on
+			*/
+			void Initialise(CVar* cvar, graphics::Renderer* renderer, SnuffboxApp* app, ThreadPool* thread_pool);
+
+			/**
+			* @brief Mounts the content archive in the source directory, unless the 'archive' CVar is false or hot-reloading is enabled
+			* @param[in] cvar (snuffbox::engine::CVar*) The CVar system
+			* @remarks Files that are not in the archive are still loaded from disk
 			*/
-			void Initialise(CVar* cvar, graphics::Renderer* renderer, SnuffboxApp* app);
+			void MountArchive(CVar* cvar);
 
 			/**
-			* @brief Reloads a loaded file in the content manager
-			* @param[in] path (const snuffbox::engine::String&) The path to the file to reload as stored in the content map
+			* @brief Reloads a batch of changed files together with every file that depends on them, then notifies the application once
+			* @param[in] changed (const snuffbox::engine::Vector<snuffbox::engine::String>&) The full paths to the files that changed on disk
 			*/
-			void Reload(const String& path);
+			void Reload(const Vector<String>& changed);
 
 			/**
-			* @brief Updates the file watch
+			* @brief Collects the files that are affected by a batch of changes, following the dependency graph transitively
+			* @param[in] changed (const snuffbox::engine::Vector<snuffbox::engine::String>&) The full paths to the files that changed on disk
+			* @return (snuffbox::engine::Vector<snuffbox::engine::String>) The changed files followed by the files that depend on them, without duplicates
+			*/
+			Vector<String> Affected(const Vector<String>& changed) const;
+
+			/**
+			* @brief Updates the file watch and finishes the asynchronous requests that were decompiled
 			*/
 			void Update();
 
+			/**
+			* @brief Creates the content of decompiled requests and calls their callbacks, until the 'load_budget' is spent
+			* @remarks At least one request is finished per call, so that loading always makes progress
+			*/
+			void UpdateRequests();
+
+			/**
+			* @brief Creates the content of a single decompiled request on the main thread and calls its callbacks
+			* @param[in] request (snuffbox::engine::ContentRequest*) The request to finish
+			* @remarks The request is owned by the list of unfinished requests until it is finished here, so that its last reference is always released on the main thread
+			*/
+			void FinishRequest(ContentRequest* request);
+
+			/**
+			* @brief Blocks until every request that is being decompiled on the thread pool has finished
+			*/
+			void WaitForRequests();
+
+			/**
+			* @brief Evicts the least recently used content of a type until it fits within the budget of that type again
+			* @remarks The evictable content of every type is kept in a heap by the frame it was last used in when it was pushed,
+			* entries that were used since are pushed again with their new frame when they reach the top, so an eviction costs O(log n)
+			* @param[in] type (snuffbox::engine::ContentBase::Types) The type of content to evict
+			* @remarks Content that is pinned by a script object is never evicted, handles held elsewhere are simply invalidated
+			*/
+			void Evict(ContentBase::Types type);
+
+			/**
+			* @brief Constructs empty content of a specific type
+			* @param[in] type (snuffbox::engine::ContentBase::Types) The type of content to construct
+			* @return (snuffbox::engine::ContentBase*) The constructed content, or nullptr for an unknown type
+			*/
+			ContentBase* CreateContent(ContentBase::Types type);
+
+			/**
+			* @brief Destructs content that was constructed with snuffbox::engine::ContentManager::CreateContent
+			* @param[in] content (snuffbox::engine::ContentBase*) The content to destruct
+			* @param[in] type (snuffbox::engine::ContentBase::Types) The type the content was constructed with
+			*/
+			void DestroyContent(ContentBase* content, ContentBase::Types type);
+
+			/**
+			* @brief Inserts created content into the content table and starts tracking it, evicting other content if its budget is exceeded
+			* @param[in] full_path (const snuffbox::engine::String&) The path to the content, including the source directory
+			* @param[in] content (snuffbox::engine::ContentBase*) The created content
+			* @param[in] type (snuffbox::engine::ContentBase::Types) The type of the content
+			* @return (snuffbox::engine::ContentPtr<snuffbox::engine::ContentBase>) The handle to the inserted content
+			*/
+			ContentPtr<ContentBase> InsertContent(const String& full_path, ContentBase* content, ContentBase::Types type);
+
+			/**
+			* @brief Removes loaded content from the content table, unloads it and destructs it
+			* @param[in] handle (const snuffbox::engine::ContentPtr<snuffbox::engine::ContentBase>&) The handle to the content
+			* @param[in] type (snuffbox::engine::ContentBase::Types) The type of the content
+			*/
+			void ReleaseContent(const ContentPtr<ContentBase>& handle, ContentBase::Types type);
+
 			/**
 			* @see snuffbox::engine::ContentService::GetContent
 			*/
@@ -67,6 +160,24 @@ namespace snuffbox
 			*/
 			ContentPtr<ContentBase> LoadContent(const String& path, ContentBase::Types type, bool quiet) override;
 
+			/**
+			* @see snuffbox::engine::ContentService::LoadContentAsync
+			*/
+			ContentHandle LoadContentAsync(const String& path, ContentBase::Types type, const ContentRequest::Callback& callback) override;
+
+			/**
+			* @see snuffbox::engine::ContentService::Preload
+			*/
+			unsigned int Preload(const ContentManifest& manifest, const ContentManifest::Callback& progress) override;
+
+			/**
+			* @brief Retrieves a key that orders files by where they are stored on disk
+			* @param[in] full_path (const snuffbox::engine::String&) The path to the file, including the source directory
+			* @return (uint64_t) The address in the mounted archive, the inode number for loose files on Linux or 0 if neither is known
+			* @remarks Keys of packed and loose files don't compare meaningfully, but a batch is usually either one or the other
+			*/
+			uint64_t Locality(const String& full_path) const;
+
 			/**
 			* @see snuffbox::engine::ContentService::UnloadContent
 			*/
@@ -77,6 +188,16 @@ namespace snuffbox
 			*/
 			void UnloadAll() override;
 
+			/**
+			* @see snuffbox::engine::ContentService::Watch
+			*/
+			void Watch(const String& path) override;
+
+			/**
+			* @see snuffbox::engine::ContentService::Depend
+			*/
+			void Depend(const String& path, const String& dependency) override;
+
 			/**
 			* @brief Concatenates a full path string from a relative path
 			* @param[in] path (const snuffbox::engine::String&) The path to concatenate
@@ -91,24 +212,84 @@ namespace snuffbox
 			*/
 			graphics::Renderer* renderer() const;
 
+			/**
+			* @param[in] type (snuffbox::engine::ContentBase::Types) The type of content to retrieve the statistics of
+			* @return (const snuffbox::engine::ContentManager::Stats&) The memory usage and eviction statistics of the type
+			*/
+			const Stats& stats(ContentBase::Types type) const;
+
+			/**
+			* @brief Default destructor, unmounts the content archive from file reading
+			*/
+			~ContentManager();
+
 		private:
 
+			/**
+			* @struct snuffbox::engine::ContentManager::Recent
+			* @brief An entry in the heap of evictable content
+			* @author Daniel Konings
+			*/
+			struct Recent
+			{
+				uint32_t used; //!< The frame the content was last used in, when it was pushed
+				String full_path; //!< The full path of the content
+				ContentPtr<ContentBase> handle; //!< The handle to the content, which is invalid once the content is unloaded
+			};
+
+			/**
+			* @brief Pushes content onto the heap of evictable content of its type, dropping entries of unloaded content when the heap has grown too large
+			* @param[in] full_path (const snuffbox::engine::String&) The full path of the content
+			* @param[in] handle (const snuffbox::engine::ContentPtr<snuffbox::engine::ContentBase>&) The handle to the content
+			* @param[in] type (snuffbox::engine::ContentBase::Types) The type of the content
+			*/
+			void PushRecent(const String& full_path, const ContentPtr<ContentBase>& handle, ContentBase::Types type);
+
+			/**
+			* @brief Orders the heap of evictable content so that the least recently used content is on top
+			* @param[in] a (const snuffbox::engine::ContentManager::Recent&) The left hand side
+			* @param[in] b (const snuffbox::engine::ContentManager::Recent&) The right hand side
+			* @return (bool) Was the left hand side used later than the right hand side?
+			*/
+			static bool UsedLater(const Recent& a, const Recent& b);
+
 			typedef Map<String, ContentPtr<ContentBase>> ContentMap;
-			ContentMap loaded_content_[ContentBase::Types::kCount]; //!< The currently loaded content per content type
+			ContentMap loaded_content_[ContentBase::Types::kCount]; //!< The handles of the currently loaded content per content type, by full path
 
 			String src_directory_; //!< The working directory
 			FileWatch watch_; //!< The file watch
+			Map<String, Vector<String>> dependents_; //!< The files that depend on a file, by the full path of the file they depend on
+			Archive archive_; //!< The mounted content archive
+
+			Stats stats_[ContentBase::Types::kCount]; //!< The memory usage and eviction statistics per content type
+			Vector<Recent> recent_[ContentBase::Types::kCount]; //!< The heap of evictable content per content type, least recently used on top
+			Map<String, bool> evicted_[ContentBase::Types::kCount]; //!< The full paths of the evicted content per content type, which is loaded again once it's requested
 
 			graphics::Renderer* renderer_; //!< The current renderer
 			SnuffboxApp* application_; //!< The current application
+			ThreadPool* thread_pool_; //!< The thread pool to decompile asynchronously loaded content on
+
+			Vector<ContentHandle> requests_; //!< The asynchronous requests that have not finished yet, only accessed from the main thread
+			Queue<ContentRequest*> decompiled_; //!< The requests that were decompiled and wait to be finished on the main thread, owned by the unfinished requests
+
+			std::mutex requests_mutex_; //!< The mutex that guards the decompiled queue and the number of requests in flight
+			std::condition_variable requests_condition_; //!< Signaled when a request has been decompiled
+			unsigned int in_flight_; //!< The number of requests that are being decompiled on the thread pool
+
+			static const char* ARCHIVE_NAME_; //!< The file name of the content archive in the source directory
+			static const float DEFAULT_LOAD_BUDGET_; //!< The default number of milliseconds that may be spent finishing requests per frame
+			static const char* BUDGET_CVARS_[ContentBase::Types::kCount]; //!< The names of the CVars that hold the budget per content type, in kilobytes
 
 		public:
 
 			JS_NAME_SINGLE(ContentManager);
 			JS_FUNCTION_DECL(load);
+			JS_FUNCTION_DECL(loadAsync);
+			JS_FUNCTION_DECL(preload);
 			JS_FUNCTION_DECL(get);
 			JS_FUNCTION_DECL(unload);
 			JS_FUNCTION_DECL(unloadAll);
+			JS_FUNCTION_DECL(stats);
 		};
 	}
 }
\ No newline at end of file
@@ -0,0 +1,41 @@
+#include "content_manifest.h"
+
+namespace snuffbox
+{
+	namespace engine
+	{
+		//-----------------------------------------------------------------------------------------------
+		ContentManifest::ContentManifest()
+		{
+
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		bool ContentManifest::Add(const String& path, ContentBase::Types type)
+		{
+			if (type < 0 || type >= ContentBase::Types::kCount)
+			{
+				return false;
+			}
+
+			if (added_[type].emplace(path, true).second == false)
+			{
+				return false;
+			}
+
+			Entry entry;
+			entry.path = path;
+			entry.type = type;
+
+			entries_.push_back(entry);
+
+			return true;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		const Vector<ContentManifest::Entry>& ContentManifest::entries() const
+		{
+			return entries_;
+		}
+	}
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "content.h"
+#include "../core/eastl.h"
+
+#include <functional>
+
+namespace snuffbox
+{
+	namespace engine
+	{
+		/**
+		* @class snuffbox::engine::ContentManifest
+		* @brief A list of content to preload as a single batch, e.g. everything a level needs at startup
+		* @remarks Entries are deduplicated as they are added, the order they are added in does not matter
+		* @author Daniel Konings
+		*/
+		class ContentManifest
+		{
+
+		public:
+
+			/**
+			* @struct snuffbox::engine::ContentManifest::Entry
+			* @brief A single piece of content in the manifest
+			* @author Daniel Konings
+			*/
+			struct Entry
+			{
+				String path; //!< The path to the content, relative to the source directory
+				ContentBase::Types type; //!< The type of the content
+			};
+
+			/**
+			* @struct snuffbox::engine::ContentManifest::Progress
+			* @brief The progress of a preload, which is reported every time a piece of content has either loaded or failed
+			* @author Daniel Konings
+			*/
+			struct Progress
+			{
+				unsigned int loaded; //!< The number of entries that were loaded succesfully
+				unsigned int failed; //!< The number of entries that could not be loaded
+				unsigned int total; //!< The total number of entries in the preload
+			};
+
+			/**
+			* @brief The callback that is called on the main thread with the progress of a preload
+			*/
+			typedef std::function<void(const Progress&)> Callback;
+
+			/**
+			* @brief Default constructor
+			*/
+			ContentManifest();
+
+			/**
+			* @brief Adds a piece of content to the manifest, unless it was already added
+			* @param[in] path (const snuffbox::engine::String&) The path to the content, relative to the source directory
+			* @param[in] type (snuffbox::engine::ContentBase::Types) The type of the content
+			* @return (bool) Was the entry added? False if it is a duplicate or the type is invalid
+			*/
+			bool Add(const String& path, ContentBase::Types type);
+
+			/**
+			* @return (const snuffbox::engine::Vector<snuffbox::engine::ContentManifest::Entry>&) The entries in the manifest
+			*/
+			const Vector<Entry>& entries() const;
+
+		private:
+
+			Vector<Entry> entries_; //!< The entries in the manifest
+			Map<String, bool> added_[ContentBase::Types::kCount]; //!< The paths that were added per content type
+		};
+	}
+}
@@ -0,0 +1,49 @@
+#include "content_request.h"
+
+namespace snuffbox
+{
+	namespace engine
+	{
+		//-----------------------------------------------------------------------------------------------
+		ContentRequest::ContentRequest() :
+			path_(""),
+			full_path_(""),
+			type_(ContentBase::Types::kCount),
+			state_(States::kPending),
+			pending_(nullptr)
+		{
+
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		ContentRequest::States ContentRequest::state() const
+		{
+			return static_cast<States>(state_.load());
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		bool ContentRequest::done() const
+		{
+			States current = state();
+			return current == States::kLoaded || current == States::kFailed;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		const String& ContentRequest::path() const
+		{
+			return path_;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		ContentBase::Types ContentRequest::type() const
+		{
+			return type_;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		const ContentPtr<ContentBase>& ContentRequest::content() const
+		{
+			return content_;
+		}
+	}
+}
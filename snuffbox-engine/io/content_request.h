@@ -0,0 +1,91 @@
+#pragma once
+
+#include "content.h"
+#include "../core/eastl.h"
+
+#include <atomic>
+#include <functional>
+
+namespace snuffbox
+{
+	namespace engine
+	{
+		class ContentManager;
+
+		/**
+		* @class snuffbox::engine::ContentRequest
+		* @brief The handle of an asynchronous content load, which can be polled or which calls back once the load has finished
+		* @author Daniel Konings
+		*/
+		class ContentRequest
+		{
+
+			friend class ContentManager;
+			friend class Allocator;
+
+		public:
+
+			/**
+			* @brief The different states of a content request
+			*/
+			enum States : int
+			{
+				kPending, //!< The file is being read and decompiled on the thread pool
+				kDecompiled, //!< The file was decompiled and waits to be created on the main thread
+				kLoaded, //!< The content was loaded succesfully
+				kFailed //!< The content could not be loaded
+			};
+
+			/**
+			* @brief The callback that is called on the main thread once a request has either loaded or failed
+			*/
+			typedef std::function<void(ContentRequest*)> Callback;
+
+		protected:
+
+			/**
+			* @brief Default constructor
+			*/
+			ContentRequest();
+
+		public:
+
+			/**
+			* @return (snuffbox::engine::ContentRequest::States) The current state of the request
+			*/
+			States state() const;
+
+			/**
+			* @return (bool) Has the request either loaded or failed?
+			*/
+			bool done() const;
+
+			/**
+			* @return (const snuffbox::engine::String&) The path of the requested content
+			*/
+			const String& path() const;
+
+			/**
+			* @return (snuffbox::engine::ContentBase::Types) The type of the requested content
+			*/
+			ContentBase::Types type() const;
+
+			/**
+			* @return (const snuffbox::engine::ContentPtr<snuffbox::engine::ContentBase>&) The loaded content, which is invalid until the request has loaded
+			*/
+			const ContentPtr<ContentBase>& content() const;
+
+		private:
+
+			String path_; //!< The path of the requested content
+			String full_path_; //!< The path including the source directory
+			ContentBase::Types type_; //!< The type of the requested content
+			std::atomic<int> state_; //!< The current state of the request
+			ContentBase* pending_; //!< The content that is being decompiled, owned by the request until it is inserted in the content table
+			ContentPtr<ContentBase> content_; //!< The handle to the loaded content
+			Vector<Callback> callbacks_; //!< The callbacks to call once the request is done
+		};
+
+		typedef SharedPtr<ContentRequest> ContentHandle;
+	}
+}
@@ -1,20 +1,34 @@
 #include "file.h"
+#include "archive.h"
 
 #include "../services/log_service.h"
 #include "../services/cvar_service.h"
 
 #include "../memory/memory.h"
 
+#ifdef SNUFF_JAVASCRIPT
+#include "../js/js_state_wrapper.h"
+#include "../js/js_worker.h"
+#endif
+
 namespace snuffbox
 {
 	namespace engine
 	{
+		//-----------------------------------------------------------------------------------------------
+		const Archive* File::archive_ = nullptr;
+
 		//-----------------------------------------------------------------------------------------------
 		File::File() :
 			file_(nullptr),
 			path_(""),
 			relative_(false),
-			buffer_(nullptr)
+			buffer_(nullptr),
+			size_(0),
+			mapped_(false)
+#ifdef SNUFF_JAVASCRIPT
+			, external_size_(0)
+#endif
 		{
 
 		}
@@ -22,16 +36,12 @@ namespace snuffbox
 		//-----------------------------------------------------------------------------------------------
 		void File::Read(bool null_terminated)
 		{
-			if (file_ == nullptr)
+			if (mapped_ == true || file_ == nullptr)
 			{
 				return;
 			}
 
-			if (buffer_ != nullptr)
-			{
-				Memory::default_allocator().Free(buffer_);
-				buffer_ = nullptr;
-			}
+			ReleaseBuffer();
 
             fseek(file_, 0, SEEK_END);
 			size_t size = ftell(file_);
@@ -52,8 +62,69 @@ namespace snuffbox
 			{
 				memset(buffer_ + size, '\0', sizeof(char));
 			}
+
+			size_ = size;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void File::ReleaseBuffer()
+		{
+#ifdef SNUFF_JAVASCRIPT
+			Neuter();
+#endif
+
+			if (buffer_ != nullptr && mapped_ == false)
+			{
+				Memory::default_allocator().Free(buffer_);
+			}
+
+			buffer_ = nullptr;
+			size_ = 0;
+			mapped_ = false;
+
+			mapping_.Unmap();
 		}
 
+		//-----------------------------------------------------------------------------------------------
+		void File::Detach()
+		{
+			if (mapped_ == false)
+			{
+				return;
+			}
+
+			unsigned char* copy = reinterpret_cast<unsigned char*>(Memory::default_allocator().Malloc(size_ + 1));
+			memcpy(copy, buffer_, size_ + 1);
+
+			buffer_ = copy;
+			mapped_ = false;
+
+			mapping_.Unmap();
+		}
+
+#ifdef SNUFF_JAVASCRIPT
+		//-----------------------------------------------------------------------------------------------
+		void File::Neuter()
+		{
+			if (external_size_ == 0)
+			{
+				return;
+			}
+
+			v8::Isolate* isolate = JSStateWrapper::Instance()->isolate();
+
+			if (array_buffer_.IsEmpty() == false && object().IsEmpty() == false)
+			{
+				JSStateWrapper::IsolateLock lock(isolate);
+				v8::Local<v8::ArrayBuffer>::New(isolate, array_buffer_)->Neuter();
+			}
+
+			array_buffer_.Reset();
+			isolate->AdjustAmountOfExternalAllocatedMemory(-external_size_);
+			external_size_ = 0;
+		}
+#endif
+
 		//-----------------------------------------------------------------------------------------------
 		File* File::Open(const engine::String& path, unsigned int flags, bool relative, File* opened)
 		{
@@ -65,8 +136,52 @@ namespace snuffbox
 			mode += (flags & AccessFlags::kWrite) == AccessFlags::kWrite ? "w" : "";
 			mode += (flags & AccessFlags::kBinary) == AccessFlags::kBinary ? "b" : "";
 
-			CVarString* src = Services::Get<CVarService>().Get<CVarString>("src_directory");
-			engine::String full_path = relative == false ? path : (src == nullptr || src->value() == "" ? path : src->value() + '/' + path);
+			engine::String full_path = path;
+
+			if (relative == true)
+			{
+				CVarString* src = Services::Get<CVarService>().Get<CVarString>("src_directory");
+				full_path = src == nullptr || src->value() == "" ? path : src->value() + '/' + path;
+			}
+
+			size_t size = 0;
+			const unsigned char* view = nullptr;
+
+			if (archive_ != nullptr && (flags & AccessFlags::kWrite) == 0)
+			{
+				view = archive_->Find(full_path, &size);
+
+				if (view != nullptr)
+				{
+					file->ReleaseBuffer();
+				}
+			}
+
+			if (view == nullptr && (flags & AccessFlags::kMapped) == AccessFlags::kMapped && (flags & AccessFlags::kWrite) == 0)
+			{
+				file->ReleaseBuffer();
+
+				if (file->mapping_.Map(full_path) == true && file->mapping_.null_terminated() == true)
+				{
+					view = file->mapping_.data();
+					size = file->mapping_.size();
+				}
+				else
+				{
+					file->mapping_.Unmap();
+				}
+			}
+
+			if (view != nullptr)
+			{
+				file->buffer_ = const_cast<unsigned char*>(view);
+				file->size_ = size;
+				file->mapped_ = true;
+				file->path_ = path;
+				file->relative_ = relative;
+
+				return file;
+			}
 
 			fopen(file->file_, path.c_str(), mode.c_str());
 
@@ -81,6 +196,12 @@ namespace snuffbox
 			return file;
 		}
 
+		//-----------------------------------------------------------------------------------------------
+		void File::Mount(const Archive* archive)
+		{
+			archive_ = archive;
+		}
+
 		//-----------------------------------------------------------------------------------------------
 		void File::Close(File* file)
 		{
@@ -101,6 +222,12 @@ namespace snuffbox
 			return reinterpret_cast<const char*>(buffer_);
 		}
 
+		//-----------------------------------------------------------------------------------------------
+		size_t File::size() const
+		{
+			return size_;
+		}
+
 		//-----------------------------------------------------------------------------------------------
 		bool File::Write(const unsigned char* data, size_t size)
 		{
@@ -136,12 +263,10 @@ namespace snuffbox
 			if (file_ != nullptr)
 			{
 				fclose(file_);
+				file_ = nullptr;
 			}
 
-			if (buffer_ != nullptr)
-			{
-				Memory::default_allocator().Free(buffer_);
-			}
+			ReleaseBuffer();
 		}
 
 		//-----------------------------------------------------------------------------------------------
@@ -151,6 +276,7 @@ namespace snuffbox
 			{
 				JS_FUNCTION_REG(open),
 				JS_FUNCTION_REG(read),
+				JS_FUNCTION_REG(readBinary),
 				JS_FUNCTION_REG(write),
 				JS_FUNCTION_REG(close),
 				JS_FUNCTION_REG_END
@@ -171,6 +297,9 @@ namespace snuffbox
 			file_ = nullptr;
 			path_ = "";
 			buffer_ = nullptr;
+			size_ = 0;
+			mapped_ = false;
+			external_size_ = 0;
 			relative_ = false;
 
 		}));
@@ -180,12 +309,21 @@ namespace snuffbox
 		{
 			JS_SETUP(File);
 
-			if (wrapper.Check("SN") == true)
+			if (wrapper.Check<JSWrapper::kString, JSWrapper::kNumber>() == true)
 			{
 				engine::String path = wrapper.GetValue<engine::String>(0, "");
 				unsigned int flags = wrapper.GetValue<unsigned int>(1, static_cast<unsigned int>(File::AccessFlags::kRead));
+				bool relative = wrapper.GetValue<bool>(2, false);
+
+				JSWorker* worker = JSStateWrapper::Instance()->worker();
 
-				File::Open(path, flags, wrapper.GetValue<bool>(2, false), self);
+				if (relative == true && worker != nullptr)
+				{
+					path = worker->src_directory().size() > 0 ? worker->src_directory() + "/" + path : path;
+					relative = false;
+				}
+
+				File::Open(path, flags, relative, self);
 			}
 		}));
 
@@ -195,7 +333,6 @@ namespace snuffbox
 			JS_SETUP(File);
 
 			const char* buffer = self->String();
-			engine::String contents = buffer;
 
 			if (buffer == nullptr)
 			{
@@ -203,7 +340,37 @@ namespace snuffbox
 				return;
 			}
 
-			wrapper.ReturnValue<engine::String>(contents);
+			v8::Isolate* isolate = JSStateWrapper::Instance()->isolate();
+			v8::Local<v8::String> contents = v8::String::NewFromUtf8(isolate, buffer, v8::NewStringType::kNormal, static_cast<int>(self->size())).ToLocalChecked();
+
+			wrapper.ReturnValue<v8::Local<v8::String>>(contents);
+		}));
+
+		//-----------------------------------------------------------------------------------------------
+		JS_FUNCTION_IMPL(File, readBinary, JS_BODY(
+		{
+			JS_SETUP(File);
+
+			const unsigned char* buffer = self->Binary();
+
+			if (buffer == nullptr)
+			{
+				wrapper.ReturnValue<bool>(false);
+				return;
+			}
+
+			self->Detach();
+
+			v8::Isolate* isolate = JSStateWrapper::Instance()->isolate();
+			v8::Local<v8::ArrayBuffer> array_buffer = JSWrapper::CreateArrayBuffer(self->buffer_, self->size_, args.This());
+
+			self->array_buffer_.Reset(isolate, array_buffer);
+			self->array_buffer_.SetWeak();
+
+			self->external_size_ = static_cast<int64_t>(self->size_);
+			isolate->AdjustAmountOfExternalAllocatedMemory(self->external_size_);
+
+			wrapper.ReturnValue<v8::Local<v8::Uint8Array>>(v8::Uint8Array::New(array_buffer, 0, self->size_));
 		}));
 
 		//-----------------------------------------------------------------------------------------------
@@ -211,10 +378,29 @@ namespace snuffbox
 		{
 			JS_SETUP(File);
 
-			if (wrapper.Check("S") == true)
+			switch (wrapper.ArgumentType(0))
+			{
+			case JSWrapper::kString:
 			{
 				engine::String to_write = wrapper.GetValue<engine::String>(0, "");
 				self->Write(reinterpret_cast<const unsigned char*>(to_write.c_str()), to_write.size());
+				break;
+			}
+
+			default:
+			{
+				size_t size = 0;
+				const unsigned char* data = wrapper.GetBuffer(0, &size);
+
+				if (data == nullptr)
+				{
+					wrapper.Check<JSWrapper::kString>();
+					break;
+				}
+
+				self->Write(data, size);
+				break;
+			}
 			}
 		}));
 
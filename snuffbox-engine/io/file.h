@@ -6,6 +6,7 @@
 #include <time.h>
 
 #include "../js/js_defines.h"
+#include "mapped_file.h"
 
 #ifdef SNUFF_WIN32
 #define fopen(out, path, flags) fopen_s(&out, path, flags);
@@ -20,6 +21,7 @@ namespace snuffbox
 	namespace engine
 	{
 		class Allocator;
+		class Archive;
 
 		/**
 		* @class snuffbox::engine::File : [JSObject]
@@ -49,6 +51,26 @@ namespace snuffbox
 			*/
 			void Read(bool null_terminated);
 
+			/**
+			* @brief Frees the file buffer, neutering any ArrayBuffer that was still exposing it
+			* @remarks A view into a mapping is only dropped, the mapping itself is unmapped
+			*/
+			void ReleaseBuffer();
+
+			/**
+			* @brief Copies a view into a mapping into a buffer owned by the file
+			* @remarks This is required before the buffer can be handed out as writable memory
+			*/
+			void Detach();
+
+#ifdef SNUFF_JAVASCRIPT
+			/**
+			* @brief Neuters the ArrayBuffer exposing the file buffer to JavaScript, if any
+			* @remarks Scripts holding on to the buffer will see an empty buffer instead of freed memory
+			*/
+			void Neuter();
+#endif
+
 		public:
 
 			/**
@@ -58,7 +80,8 @@ namespace snuffbox
 			{
 				kRead = 0x1, //!< Read access
 				kWrite = 0x2, //!< Write access
-				kBinary = 0x4 //!< Binary read
+				kBinary = 0x4, //!< Binary read
+				kMapped = 0x8 //!< Map the file into memory read-only instead of reading it into a buffer, ignored when writing
 			};
 
 			/**
@@ -66,11 +89,19 @@ namespace snuffbox
 			* @param[in] path (const snuffbox::engine::String&) The path to load the file from
 			* @param[in] flags (unsigned int) The access flags to open the file with
 			* @param[in] relative (bool) Should the path be relative to the current 'src_directory' CVar?
+			* @remarks Only relative paths read the CVar, so callers on other threads should pass paths that were resolved on the main thread
 			* @param[in] opened (snuffbox::engine::File*) If there's a file to be re-opened, use this file instead, default = nullptr
 			* @return (snuffbox::engine::File*) The opened file, File::file_ will be nullptr if opening failed
 			*/
 			static File* Open(const engine::String& path, unsigned int flags, bool relative = false, File* opened = nullptr);
 
+			/**
+			* @brief Mounts an archive to look up files opened for reading in, before looking on disk
+			* @param[in] archive (const snuffbox::engine::Archive*) The archive to mount, or nullptr to only read from disk
+			* @remarks Files found in the archive are zero-copy views into its mapping
+			*/
+			static void Mount(const Archive* archive);
+
 			/**
 			* @brief Closes the file and deallocates all used memory
 			* @param[in] file (snuffbox::engine::File*) The file to close
@@ -87,6 +118,11 @@ namespace snuffbox
 			*/
 			const char* String();
 
+			/**
+			* @return (size_t) The size of the file's buffer in bytes, excluding the null-terminator
+			*/
+			size_t size() const;
+
 			/**
 			* @brief Writes data into the opened file
 			* @remarks The file will be emptied (removed and readded) first, before writing to it
@@ -113,6 +149,16 @@ namespace snuffbox
 			bool relative_; //!< Was the file loaded relatively to the source directory?
 
 			unsigned char* buffer_; //!< The buffer to allocate the file data in
+			size_t size_; //!< The size of the buffer, excluding the null-terminator
+			bool mapped_; //!< Is the buffer a read-only view into either the mapped file or the mounted archive?
+			MappedFile mapping_; //!< The mapping of the file, when it was opened with File::AccessFlags::kMapped
+
+			static const Archive* archive_; //!< The mounted archive, if any
+
+#ifdef SNUFF_JAVASCRIPT
+			v8::Persistent<v8::ArrayBuffer> array_buffer_; //!< A weak handle to the ArrayBuffer exposing the buffer to JavaScript
+			int64_t external_size_; //!< The amount of external memory reported to V8 for the ArrayBuffer
+#endif
 
 		public:
 
@@ -120,6 +166,7 @@ namespace snuffbox
 
 			JS_FUNCTION_DECL(open);
 			JS_FUNCTION_DECL(read);
+			JS_FUNCTION_DECL(readBinary);
 			JS_FUNCTION_DECL(write);
 			JS_FUNCTION_DECL(close);
 		};
@@ -12,6 +12,12 @@
 	#define localtime(out, time) { out = *localtime(time); }
 #endif
 
+#ifdef SNUFF_LINUX
+	#include <sys/inotify.h>
+	#include <unistd.h>
+	#include <errno.h>
+#endif
+
 namespace snuffbox
 {
 	namespace engine
@@ -20,6 +26,9 @@ namespace snuffbox
 		FileWatch::FileWatch(ContentManager* cm) :
 			content_manager_(cm),
 			reload_timer_("Reload timer")
+#ifdef SNUFF_LINUX
+			, inotify_(inotify_init1(IN_NONBLOCK | IN_CLOEXEC))
+#endif
 		{
 			reload_timer_.Start();
 		}
@@ -61,15 +70,262 @@ namespace snuffbox
 		//-----------------------------------------------------------------------------------------------
 		void FileWatch::Add(const String& path)
 		{
+#ifdef SNUFF_LINUX
+			if (inotify_ != -1)
+			{
+				if (file_times_.find(path) != file_times_.end())
+				{
+					return;
+				}
+
+				String directory, name;
+				Split(path, &directory, &name);
+
+				Map<String, Directory>::iterator it = directories_.find(directory);
+
+				if (it == directories_.end())
+				{
+					Map<String, unsigned int>::iterator unwatched = unwatched_.find(directory);
+
+					if (unwatched != unwatched_.end())
+					{
+						++unwatched->second;
+						file_times_.emplace(path, tm());
+
+						return;
+					}
+
+					if (Watch(directory, 0) == false)
+					{
+						Services::Get<LogService>().Log(console::LogSeverity::kWarning, "Could not watch directory '{0}' for changes", directory);
+						return;
+					}
+
+					it = directories_.find(directory);
+				}
+
+				++it->second.count;
+				file_times_.emplace(path, tm());
+
+				return;
+			}
+#endif
+
 			file_times_.emplace(path, GetFileTime(path));
 		}
 
 		//-----------------------------------------------------------------------------------------------
 		void FileWatch::Remove(const String& path)
 		{
+#ifdef SNUFF_LINUX
+			if (inotify_ != -1 && file_times_.find(path) != file_times_.end())
+			{
+				String directory, name;
+				Split(path, &directory, &name);
+
+				changed_.erase(path);
+
+				Map<String, Directory>::iterator it = directories_.find(directory);
+
+				if (it != directories_.end() && --it->second.count == 0)
+				{
+					inotify_rm_watch(inotify_, it->second.descriptor);
+
+					descriptors_.erase(it->second.descriptor);
+					directories_.erase(it);
+				}
+
+				Map<String, unsigned int>::iterator unwatched = unwatched_.find(directory);
+
+				if (unwatched != unwatched_.end() && --unwatched->second == 0)
+				{
+					unwatched_.erase(unwatched);
+				}
+			}
+#endif
+
 			file_times_.erase(path);
 		}
 
+#ifdef SNUFF_LINUX
+		//-----------------------------------------------------------------------------------------------
+		void FileWatch::ReadEvents()
+		{
+			alignas(inotify_event) char buffer[4096];
+			float now = reload_timer_.Elapsed(Timer::Unit::kMilliseconds);
+
+			while (true)
+			{
+				ssize_t length = read(inotify_, buffer, sizeof(buffer));
+
+				if (length <= 0)
+				{
+					break;
+				}
+
+				for (char* ptr = buffer; ptr < buffer + length; ptr += sizeof(inotify_event) + reinterpret_cast<inotify_event*>(ptr)->len)
+				{
+					const inotify_event* evt = reinterpret_cast<const inotify_event*>(ptr);
+
+					if ((evt->mask & IN_Q_OVERFLOW) != 0)
+					{
+						Services::Get<LogService>().Log(console::LogSeverity::kWarning, "The file watch missed changes, as too many files were changed at once");
+						continue;
+					}
+
+					if ((evt->mask & IN_IGNORED) != 0)
+					{
+						Map<int, String>::iterator it = descriptors_.find(evt->wd);
+
+						if (it != descriptors_.end())
+						{
+							Unwatch(it->second);
+						}
+
+						continue;
+					}
+
+					if (evt->len == 0)
+					{
+						continue;
+					}
+
+					Map<int, String>::iterator it = descriptors_.find(evt->wd);
+
+					if (it == descriptors_.end())
+					{
+						continue;
+					}
+
+					String path = it->second.empty() == true ? String(evt->name) : it->second + '/' + evt->name;
+
+					if (file_times_.find(path) != file_times_.end())
+					{
+						changed_[path] = now;
+					}
+				}
+			}
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		bool FileWatch::Watch(const String& directory, unsigned int count)
+		{
+			int descriptor = inotify_add_watch(inotify_, directory.empty() == true ? "." : directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+
+			if (descriptor == -1)
+			{
+				return false;
+			}
+
+			Directory watched;
+			watched.descriptor = descriptor;
+			watched.count = count;
+
+			directories_.emplace(directory, watched);
+			descriptors_[descriptor] = directory;
+
+			return true;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void FileWatch::Unwatch(const String& directory)
+		{
+			Map<String, Directory>::iterator it = directories_.find(directory);
+
+			if (it == directories_.end())
+			{
+				return;
+			}
+
+			unwatched_[directory] = it->second.count;
+
+			descriptors_.erase(it->second.descriptor);
+			directories_.erase(it);
+
+			String file_directory, name;
+			Vector<String> removed;
+
+			for (Map<String, float>::iterator changed = changed_.begin(); changed != changed_.end(); ++changed)
+			{
+				Split(changed->first, &file_directory, &name);
+
+				if (file_directory == directory)
+				{
+					removed.push_back(changed->first);
+				}
+			}
+
+			for (size_t i = 0; i < removed.size(); ++i)
+			{
+				changed_.erase(removed.at(i));
+			}
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void FileWatch::Rewatch()
+		{
+			if (unwatched_.empty() == true)
+			{
+				return;
+			}
+
+			float now = reload_timer_.Elapsed(Timer::Unit::kMilliseconds);
+			Vector<String> watched;
+
+			for (Map<String, unsigned int>::iterator it = unwatched_.begin(); it != unwatched_.end(); ++it)
+			{
+				if (Watch(it->first, it->second) == true)
+				{
+					watched.push_back(it->first);
+				}
+			}
+
+			if (watched.empty() == true)
+			{
+				return;
+			}
+
+			String directory, name;
+			struct stat attributes;
+
+			for (FileTimeMap::iterator it = file_times_.begin(); it != file_times_.end(); ++it)
+			{
+				Split(it->first, &directory, &name);
+
+				for (size_t i = 0; i < watched.size(); ++i)
+				{
+					if (watched.at(i) == directory && stat(it->first.c_str(), &attributes) == 0)
+					{
+						changed_[it->first] = now;
+						break;
+					}
+				}
+			}
+
+			for (size_t i = 0; i < watched.size(); ++i)
+			{
+				unwatched_.erase(watched.at(i));
+			}
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void FileWatch::Split(const String& path, String* directory, String* name)
+		{
+			size_t slash = path.find_last_of('/');
+
+			if (slash == String::npos)
+			{
+				*directory = "";
+				*name = path;
+
+				return;
+			}
+
+			*directory = path.substr(0, slash);
+			*name = path.substr(slash + 1);
+		}
+#endif
+
 		//-----------------------------------------------------------------------------------------------
 		void FileWatch::Update()
 		{
@@ -86,11 +342,48 @@ namespace snuffbox
 				reload_after = freq->As<unsigned int>();
 			}
 
+#ifdef SNUFF_LINUX
+			if (inotify_ != -1)
+			{
+				ReadEvents();
+				Rewatch();
+
+				if (changed_.empty() == true)
+				{
+					return;
+				}
+
+				float now = reload_timer_.Elapsed(Timer::Unit::kMilliseconds);
+				Vector<String> settled;
+
+				for (Map<String, float>::iterator it = changed_.begin(); it != changed_.end(); ++it)
+				{
+					if (now - it->second >= static_cast<float>(reload_after))
+					{
+						settled.push_back(it->first);
+					}
+				}
+
+				for (size_t i = 0; i < settled.size(); ++i)
+				{
+					changed_.erase(settled.at(i));
+				}
+
+				if (settled.empty() == false)
+				{
+					content_manager_->Reload(settled);
+				}
+
+				return;
+			}
+#endif
+
 			unsigned int elapsed = static_cast<unsigned int>(reload_timer_.Elapsed());
 			if (elapsed > reload_after)
 			{
 				tm last, now;
 				String path;
+				Vector<String> changed;
 
                 for (FileTimeMap::iterator it = file_times_.begin(); it != file_times_.end(); ++it)
 				{
@@ -101,14 +394,31 @@ namespace snuffbox
 
 					if (Compare(last, now) == true)
 					{
-						content_manager_->Reload(path);
+						changed.push_back(path);
 						it->second = now;
 					}
 				}
 
+				if (changed.empty() == false)
+				{
+					content_manager_->Reload(changed);
+				}
+
 				reload_timer_.Stop();
 				reload_timer_.Start(true);
 			}
 		}
+
+		//-----------------------------------------------------------------------------------------------
+		FileWatch::~FileWatch()
+		{
+#ifdef SNUFF_LINUX
+			if (inotify_ != -1)
+			{
+				close(inotify_);
+				inotify_ = -1;
+			}
+#endif
+		}
 	}
-}
+}
\ No newline at end of file
@@ -15,6 +15,7 @@ namespace snuffbox
 		/**
 		* @class snuffbox::engine::FileWatch
 		* @brief A file watcher that watches for files that have been modified and reloads them through the content manager
+		* @remarks On Linux the watched directories are monitored with inotify, elsewhere the watched files are polled every 'reload_freq' milliseconds
 		* @author Daniel Konings
 		*/
 		class FileWatch
@@ -58,9 +59,52 @@ namespace snuffbox
 
 			/**
 			* @brief Updates the file watch and reloads any files where necessary
+			* @remarks On Linux this drains the pending inotify events without blocking, 
+			* a changed file is reloaded once it hasn't been written to for 'reload_freq' milliseconds
 			*/
 			void Update();
 
+#ifdef SNUFF_LINUX
+			/**
+			* @brief Reads all pending inotify events and marks the watched files they concern as changed
+			*/
+			void ReadEvents();
+
+			/**
+			* @brief Starts watching a directory with inotify
+			* @param[in] directory (const snuffbox::engine::String&) The directory to watch
+			* @param[in] count (unsigned int) The number of watched files in the directory
+			* @return (bool) Could the directory be watched?
+			*/
+			bool Watch(const String& directory, unsigned int count);
+
+			/**
+			* @brief Forgets the watch of a directory that was deleted or moved, and remembers its files so that they are watched again once it exists
+			* @param[in] directory (const snuffbox::engine::String&) The directory whose watch was removed by the kernel
+			*/
+			void Unwatch(const String& directory);
+
+			/**
+			* @brief Tries to watch every directory that was deleted or moved again, files in a directory that exists again are reloaded
+			*/
+			void Rewatch();
+
+			/**
+			* @brief Splits a path into its directory and file name
+			* @param[in] path (const snuffbox::engine::String&) The path to split
+			* @param[out] directory (snuffbox::engine::String*) The directory, '.' if the path has none
+			* @param[out] name (snuffbox::engine::String*) The file name
+			*/
+			static void Split(const String& path, String* directory, String* name);
+#endif
+
+		public:
+
+			/**
+			* @brief Default destructor, closes the inotify instance on Linux
+			*/
+			~FileWatch();
+
 		private:
 
 			typedef Map<String, tm> FileTimeMap;
@@ -69,6 +113,25 @@ namespace snuffbox
 			ContentManager* content_manager_; //!< The current content manager that owns this file watch
 
 			Timer reload_timer_; //!< The timer to reload with
+
+#ifdef SNUFF_LINUX
+			/**
+			* @struct snuffbox::engine::FileWatch::Directory
+			* @brief A directory that is watched with inotify
+			* @author Daniel Konings
+			*/
+			struct Directory
+			{
+				int descriptor; //!< The inotify watch descriptor
+				unsigned int count; //!< The number of watched files in the directory
+			};
+
+			int inotify_; //!< The inotify instance, or -1 if it could not be created
+			Map<String, Directory> directories_; //!< The watched directories by path
+			Map<int, String> descriptors_; //!< The watched directories by watch descriptor
+			Map<String, float> changed_; //!< The changed files that wait to be reloaded, with the time of their last write
+			Map<String, unsigned int> unwatched_; //!< The deleted or moved directories, with the number of watched files in them
+#endif
 		};
 	}
 }
\ No newline at end of file
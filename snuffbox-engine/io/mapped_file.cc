@@ -0,0 +1,164 @@
+#include "mapped_file.h"
+
+#ifdef SNUFF_WIN32
+	#include <Windows.h>
+#else
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+namespace snuffbox
+{
+	namespace engine
+	{
+		//-----------------------------------------------------------------------------------------------
+		MappedFile::MappedFile() :
+			data_(nullptr),
+			size_(0),
+#ifdef SNUFF_WIN32
+			file_(INVALID_HANDLE_VALUE),
+			mapping_(nullptr)
+#else
+			file_(-1)
+#endif
+		{
+
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		bool MappedFile::Map(const String& path)
+		{
+			Unmap();
+
+#ifdef SNUFF_WIN32
+			file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, nullptr);
+
+			if (file_ == INVALID_HANDLE_VALUE)
+			{
+				return false;
+			}
+
+			LARGE_INTEGER size;
+			if (GetFileSizeEx(file_, &size) == FALSE || size.QuadPart == 0)
+			{
+				Unmap();
+				return false;
+			}
+
+			mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+			if (mapping_ == nullptr)
+			{
+				Unmap();
+				return false;
+			}
+
+			data_ = reinterpret_cast<const unsigned char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+			size_ = static_cast<size_t>(size.QuadPart);
+#else
+			file_ = open(path.c_str(), O_RDONLY);
+
+			if (file_ == -1)
+			{
+				return false;
+			}
+
+			struct stat attributes;
+			if (fstat(file_, &attributes) != 0 || attributes.st_size == 0)
+			{
+				Unmap();
+				return false;
+			}
+
+			void* mapped = mmap(nullptr, static_cast<size_t>(attributes.st_size), PROT_READ, MAP_SHARED, file_, 0);
+
+			data_ = mapped == MAP_FAILED ? nullptr : reinterpret_cast<const unsigned char*>(mapped);
+			size_ = static_cast<size_t>(attributes.st_size);
+#endif
+
+			if (data_ == nullptr)
+			{
+				Unmap();
+				return false;
+			}
+
+			return true;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void MappedFile::Unmap()
+		{
+#ifdef SNUFF_WIN32
+			if (data_ != nullptr)
+			{
+				UnmapViewOfFile(data_);
+			}
+
+			if (mapping_ != nullptr)
+			{
+				CloseHandle(mapping_);
+				mapping_ = nullptr;
+			}
+
+			if (file_ != INVALID_HANDLE_VALUE)
+			{
+				CloseHandle(file_);
+				file_ = INVALID_HANDLE_VALUE;
+			}
+#else
+			if (data_ != nullptr)
+			{
+				munmap(const_cast<unsigned char*>(data_), size_);
+			}
+
+			if (file_ != -1)
+			{
+				close(file_);
+				file_ = -1;
+			}
+#endif
+
+			data_ = nullptr;
+			size_ = 0;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		const unsigned char* MappedFile::data() const
+		{
+			return data_;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		size_t MappedFile::size() const
+		{
+			return size_;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		bool MappedFile::null_terminated() const
+		{
+			return data_ != nullptr && size_ % PageSize() != 0;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		size_t MappedFile::PageSize()
+		{
+#ifdef SNUFF_WIN32
+			SYSTEM_INFO info;
+			GetSystemInfo(&info);
+
+			return static_cast<size_t>(info.dwPageSize);
+#else
+			return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		MappedFile::~MappedFile()
+		{
+			Unmap();
+		}
+	}
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "../core/eastl.h"
+
+namespace snuffbox
+{
+	namespace engine
+	{
+		/**
+		* @class snuffbox::engine::MappedFile
+		* @brief A file that is mapped into memory read-only, using mmap on Linux and CreateFileMapping on Windows
+		* @author Daniel Konings
+		*/
+		class MappedFile
+		{
+
+		public:
+
+			/**
+			* @brief Default constructor
+			*/
+			MappedFile();
+
+			/**
+			* @brief Remove copy constructor
+			*/
+			MappedFile(const MappedFile& other) = delete;
+
+			/**
+			* @brief Maps a file into memory, any previously mapped file is unmapped first
+			* @param[in] path (const snuffbox::engine::String&) The path to the file
+			* @return (bool) Was the file mapped succesfully? Empty files can't be mapped
+			*/
+			bool Map(const String& path);
+
+			/**
+			* @brief Unmaps the file, the data becomes invalid
+			*/
+			void Unmap();
+
+			/**
+			* @return (const unsigned char*) The mapped data, or nullptr if nothing is mapped
+			*/
+			const unsigned char* data() const;
+
+			/**
+			* @return (size_t) The size of the mapped data
+			*/
+			size_t size() const;
+
+			/**
+			* @return (bool) Is the mapped data followed by a null byte?
+			* @remarks This is the case when the size is not a multiple of the page size, as the rest of the last page is zero-filled
+			*/
+			bool null_terminated() const;
+
+			/**
+			* @return (size_t) The page size of the system
+			*/
+			static size_t PageSize();
+
+			/**
+			* @brief Default destructor, unmaps the file
+			*/
+			~MappedFile();
+
+		private:
+
+			const unsigned char* data_; //!< The mapped data
+			size_t size_; //!< The size of the mapped data
+
+#ifdef SNUFF_WIN32
+			void* file_; //!< The file handle
+			void* mapping_; //!< The file mapping handle
+#else
+			int file_; //!< The file descriptor
+#endif
+		};
+	}
+}
@@ -14,12 +14,11 @@ namespace snuffbox
 	namespace engine
 	{
 		//-----------------------------------------------------------------------------------------------
-		bool Script::Load(File* file, ContentManager* cm)
+		bool Script::Decompile(File* file)
 		{
 			LogService& log = Services::Get<LogService>();
 
-#ifdef SNUFF_JAVASCRIPT
-			const unsigned char* buffer = reinterpret_cast<const unsigned char*>(file->String());
+			const unsigned char* buffer = file->Binary();
 			if (buffer == nullptr)
 			{
 				return false;
@@ -32,7 +31,7 @@ namespace snuffbox
 			const unsigned char* output;
 			size_t size;
 
-			bool decompiled = c.Decompile(buffer, &output, &size, nullptr);
+			bool decompiled = c.Decompile(buffer, file->size(), &output, &size, nullptr);
 
 			if (decompiled == false)
 			{
@@ -40,9 +39,30 @@ namespace snuffbox
 				return false;
 			}
 
+			source_ = reinterpret_cast<const char*>(output);
+			path_ = file->path();
+
+			return true;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		bool Script::Create(ContentManager* cm)
+		{
+#ifdef SNUFF_JAVASCRIPT
+			LogService& log = Services::Get<LogService>();
+
 			JSStateWrapper* wrapper = JSStateWrapper::Instance();
+
+			if (wrapper->worker() == nullptr)
+			{
+				wrapper->modules().Precompile(path_, source_);
+			}
+
 			String error;
-			bool success = wrapper->Run(reinterpret_cast<const char*>(output), file->path(), nullptr, &error);
+			bool success = wrapper->Run(source_, path_, nullptr, &error);
+
+			set_size(source_.size());
+			source_.clear();
 
 			if (success == false)
 			{
@@ -55,5 +75,11 @@ namespace snuffbox
 			return false;
 #endif
 		}
+
+		//-----------------------------------------------------------------------------------------------
+		bool Script::evictable() const
+		{
+			return false;
+		}
 	}
-}
\ No newline at end of file
+}
@@ -16,9 +16,26 @@ namespace snuffbox
 		public:
 
 			/**
-			* @see snuffbox::engine::ContentBase::Load
+			* @see snuffbox::engine::ContentBase::Decompile
 			*/
-			bool Load(File* file, ContentManager* cm) override;
+			bool Decompile(File* file) override;
+
+			/**
+			* @see snuffbox::engine::ContentBase::Create
+			* @remarks In the main state the modules the script requires are precompiled from its decompiled source before it is ran
+			*/
+			bool Create(ContentManager* cm) override;
+
+			/**
+			* @see snuffbox::engine::ContentBase::evictable
+			* @remarks Scripts are never evicted, as loading a script runs it
+			*/
+			bool evictable() const override;
+
+		private:
+
+			String source_; //!< The decompiled source, until the script is ran
+			String path_; //!< The path of the file the source was read from
 		};
 	}
-}
\ No newline at end of file
+}
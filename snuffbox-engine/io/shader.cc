@@ -13,13 +13,14 @@ namespace snuffbox
 	{
 		//-----------------------------------------------------------------------------------------------
 		Shader::Shader() :
-			blob_(nullptr)
+			blob_(nullptr),
+			type_(0)
 		{
 
 		}
 
 		//-----------------------------------------------------------------------------------------------
-		bool Shader::Load(File* file, ContentManager* cm)
+		bool Shader::Decompile(File* file)
 		{
 			LogService& log = Services::Get<LogService>();
 
@@ -31,7 +32,7 @@ namespace snuffbox
 			const unsigned char* output;
 			size_t size;
 
-			bool decompiled = c.Decompile(buffer, &output, &size, nullptr);
+			bool decompiled = c.Decompile(buffer, file->size(), &output, &size, nullptr);
 
 			if (decompiled == false)
 			{
@@ -39,9 +40,36 @@ namespace snuffbox
 				return false;
 			}
 
+			if (size < sizeof(compilers::ShaderCompiler::Header))
+			{
+				log.Log(console::LogSeverity::kError, "Could not decompile shader '{0}'\n\tThe shader header is truncated", file->path());
+				return false;
+			}
+
 			compilers::ShaderCompiler::Header h = *reinterpret_cast<const compilers::ShaderCompiler::Header*>(output);
+			const unsigned char* byte_code = output + sizeof(compilers::ShaderCompiler::Header);
+
+			if (h.size > size - sizeof(compilers::ShaderCompiler::Header))
+			{
+				log.Log(console::LogSeverity::kError, "Could not decompile shader '{0}'\n\tThe byte code is truncated", file->path());
+				return false;
+			}
+
+			byte_code_.assign(byte_code, byte_code + h.size);
+			type_ = h.type;
+
+			return true;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		bool Shader::Create(ContentManager* cm)
+		{
+			bool created = cm->renderer()->CreateShader(byte_code_.data(), byte_code_.size(), type_, &blob_);
+			set_size(byte_code_.size());
+
+			Vector<unsigned char>().swap(byte_code_);
 
-			return cm->renderer()->CreateShader(output + sizeof(compilers::ShaderCompiler::Header), h.size, h.type, &blob_);
+			return created;
 		}
 
 		//-----------------------------------------------------------------------------------------------
@@ -22,9 +22,14 @@ namespace snuffbox
 			Shader();
 
 			/**
-			* @see snuffbox::engine::ContentBase::Load
+			* @see snuffbox::engine::ContentBase::Decompile
 			*/
-			bool Load(File* file, ContentManager* cm) override;
+			bool Decompile(File* file) override;
+
+			/**
+			* @see snuffbox::engine::ContentBase::Create
+			*/
+			bool Create(ContentManager* cm) override;
 
 			/**
 			* @see snuffbox::engine::ContentBase::Reload
@@ -47,6 +52,9 @@ namespace snuffbox
 		private:
 
 			void* blob_; //!< The platform specific shader blob
+
+			Vector<unsigned char> byte_code_; //!< The decompiled byte code, until the shader is created
+			char type_; //!< The type of the decompiled shader
 		};
 	}
 }
\ No newline at end of file
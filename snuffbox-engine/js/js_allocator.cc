@@ -7,7 +7,10 @@ namespace snuffbox
     {
 		//-----------------------------------------------------------------------------------------------
         JSAllocator::JSAllocator(engine::Allocator& allocator) :
-			allocator_(allocator)
+			allocator_(allocator),
+			allocated_(0),
+			peak_(0),
+			count_(0)
 		{
 
 		}
@@ -22,13 +25,68 @@ namespace snuffbox
 		//-----------------------------------------------------------------------------------------------
 		void* JSAllocator::AllocateUninitialized(size_t length)
 		{ 
-			return allocator_.Malloc(length);
+			void* data = allocator_.Malloc(length);
+
+			if (data == nullptr)
+			{
+				return data;
+			}
+
+			Track(length);
+
+			return data;
 		}
 
 		//-----------------------------------------------------------------------------------------------
 		void JSAllocator::Free(void* data, size_t length) 
 		{ 
+			if (data == nullptr)
+			{
+				return;
+			}
+
 			allocator_.Free(data);
+
+			Untrack(length);
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void JSAllocator::Track(size_t length)
+		{
+			size_t allocated = allocated_.fetch_add(length) + length;
+			size_t peak = peak_.load();
+
+			while (allocated > peak && peak_.compare_exchange_weak(peak, allocated) == false)
+			{
+
+			}
+
+			++count_;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void JSAllocator::Untrack(size_t length)
+		{
+			allocated_ -= length;
+			--count_;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		size_t JSAllocator::allocated() const
+		{
+			return allocated_.load();
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		size_t JSAllocator::peak() const
+		{
+			return peak_.load();
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		size_t JSAllocator::count() const
+		{
+			return count_.load();
 		}
     }
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <v8.h>
+#include <atomic>
 
 #include "../memory/memory.h"
 
@@ -55,9 +56,42 @@ namespace snuffbox
             */
             void Free(void* data, size_t length) override;
 
+        public:
+
+            /**
+            * @brief Starts tracking a block that was allocated by another JavaScript state and transferred to this one
+            * @param[in] length (size_t) The length of the block
+            */
+            void Track(size_t length);
+
+            /**
+            * @brief Stops tracking a block that is transferred to another JavaScript state
+            * @param[in] length (size_t) The length of the block
+            */
+            void Untrack(size_t length);
+
+            /**
+            * @return (size_t) The number of bytes currently allocated for ArrayBuffers
+            */
+            size_t allocated() const;
+
+            /**
+            * @return (size_t) The highest number of bytes that were allocated for ArrayBuffers at once
+            */
+            size_t peak() const;
+
+            /**
+            * @return (size_t) The number of ArrayBuffer allocations that are currently alive
+            */
+            size_t count() const;
+
         private:
 
             engine::Allocator& allocator_; //!< The snuffbox allocator used for allocations
+
+            std::atomic<size_t> allocated_; //!< The number of bytes currently allocated
+            std::atomic<size_t> peak_; //!< The peak number of bytes allocated
+            std::atomic<size_t> count_; //!< The number of live allocations
         };
     }
 }
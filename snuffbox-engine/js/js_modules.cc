@@ -0,0 +1,610 @@
+#include "js_modules.h"
+#include "js_state_wrapper.h"
+#include "js_wrapper.h"
+
+#include "../core/thread_pool.h"
+#include "../core/timer.h"
+
+#include "../io/file.h"
+
+#include "../logging/cvar.h"
+#include "../services/log_service.h"
+#include "../services/cvar_service.h"
+#include "../services/content_service.h"
+
+#include <snuffbox-compilers/compilers/script_compiler.h>
+
+#include <cctype>
+
+using namespace v8;
+
+namespace snuffbox
+{
+	namespace engine
+	{
+		//-----------------------------------------------------------------------------------------------
+		const char* JSModules::PREFIX_ = "(function (exports, require, module, __filename, __dirname) {";
+
+		//-----------------------------------------------------------------------------------------------
+		const char* JSModules::SUFFIX_ = "\n})";
+
+		//-----------------------------------------------------------------------------------------------
+		JSModules::SourceStream::SourceStream(const engine::String& source) :
+			source_(source),
+			streamed_(false)
+		{
+
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		size_t JSModules::SourceStream::GetMoreData(const uint8_t** src)
+		{
+			if (streamed_ == true)
+			{
+				return 0;
+			}
+
+			streamed_ = true;
+
+			uint8_t* chunk = new uint8_t[source_.size()];
+			memcpy(chunk, source_.c_str(), source_.size());
+
+			*src = chunk;
+			return source_.size();
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		JSModules::JSModules() :
+			pending_(0)
+		{
+
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		bool JSModules::Read(Module* module)
+		{
+			LogService& log = Services::Get<LogService>();
+
+			File* file = File::Open(module->full_path, File::AccessFlags::kRead | File::AccessFlags::kBinary | File::AccessFlags::kMapped);
+			const unsigned char* buffer = file->Binary();
+
+			if (buffer == nullptr)
+			{
+				File::Close(file);
+				return false;
+			}
+
+			compilers::ScriptCompiler c(
+				[](size_t size) { return Memory::default_allocator().Malloc(size); },
+				[](void* ptr) { Memory::default_allocator().Free(ptr); });
+
+			const unsigned char* output;
+			size_t size;
+
+			if (c.Decompile(buffer, file->size(), &output, &size, nullptr) == false)
+			{
+				log.Log(console::LogSeverity::kError, "Could not decompile module '{0}'\n\t{1}", module->path, c.GetError());
+				File::Close(file);
+
+				return false;
+			}
+
+			engine::String source = reinterpret_cast<const char*>(output);
+			File::Close(file);
+
+			module->dependencies.clear();
+			Scan(source, &module->dependencies);
+
+			for (size_t i = 0; i < module->dependencies.size(); ++i)
+			{
+				module->dependencies.at(i) = Normalize(module->dependencies.at(i), module->path);
+			}
+
+			module->source = PREFIX_ + source + SUFFIX_;
+			module->state = States::kRead;
+
+			return true;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void JSModules::Scan(const engine::String& source, Vector<engine::String>* dependencies)
+		{
+			const char* keyword = "require";
+			const size_t length = strlen(keyword);
+
+			size_t i = 0;
+			size_t size = source.size();
+
+			while (i < size)
+			{
+				char c = source.at(i);
+
+				if (c == '/' && i + 1 < size && source.at(i + 1) == '/')
+				{
+					while (i < size && source.at(i) != '\n')
+					{
+						++i;
+					}
+
+					continue;
+				}
+
+				if (c == '/' && i + 1 < size && source.at(i + 1) == '*')
+				{
+					size_t end = source.find("*/", i + 2);
+					i = end == engine::String::npos ? size : end + 2;
+
+					continue;
+				}
+
+				bool boundary = i == 0 || (std::isalnum(source.at(i - 1)) == 0 && source.at(i - 1) != '_' && source.at(i - 1) != '.' && source.at(i - 1) != '$');
+
+				if (boundary == false || source.compare(i, length, keyword) != 0)
+				{
+					++i;
+					continue;
+				}
+
+				size_t j = i + length;
+
+				while (j < size && std::isspace(source.at(j)) != 0)
+				{
+					++j;
+				}
+
+				if (j >= size || source.at(j) != '(')
+				{
+					i = j;
+					continue;
+				}
+
+				++j;
+
+				while (j < size && std::isspace(source.at(j)) != 0)
+				{
+					++j;
+				}
+
+				if (j >= size || (source.at(j) != '"' && source.at(j) != '\''))
+				{
+					i = j;
+					continue;
+				}
+
+				char quote = source.at(j);
+				size_t end = source.find(quote, j + 1);
+
+				if (end == engine::String::npos)
+				{
+					break;
+				}
+
+				dependencies->push_back(source.substr(j + 1, end - j - 1));
+				i = end + 1;
+			}
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void JSModules::RequireFrom(const FunctionCallbackInfo<Value>& args)
+		{
+			JSWrapper wrapper(args);
+			if (wrapper.Check<JSWrapper::kString>() == false)
+			{
+				return;
+			}
+
+			engine::String from = *v8::String::Utf8Value(args.Data());
+
+			Local<Value> exports;
+			if (JSStateWrapper::Instance()->modules_.Require(wrapper.GetValue<engine::String>(0, ""), &exports, from) == true)
+			{
+				wrapper.ReturnValue<Local<Value>>(exports);
+			}
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		engine::String JSModules::Normalize(const engine::String& path, const engine::String& from)
+		{
+			engine::String joined = path;
+
+			if (path.compare(0, 2, "./") == 0 || path.compare(0, 3, "../") == 0 || path == "." || path == "..")
+			{
+				size_t separator = from.find_last_of('/');
+				joined = separator == engine::String::npos ? path : from.substr(0, separator) + "/" + path;
+			}
+
+			Vector<engine::String> segments;
+			size_t start = 0;
+
+			while (start <= joined.size())
+			{
+				size_t end = joined.find_first_of("/\\", start);
+				end = end == engine::String::npos ? joined.size() : end;
+
+				engine::String segment = joined.substr(start, end - start);
+				start = end + 1;
+
+				if (segment.empty() == true || segment == ".")
+				{
+					continue;
+				}
+
+				if (segment == ".." && segments.empty() == false && segments.back() != "..")
+				{
+					segments.pop_back();
+					continue;
+				}
+
+				segments.push_back(segment);
+			}
+
+			engine::String result;
+
+			for (size_t i = 0; i < segments.size(); ++i)
+			{
+				result += i == 0 ? segments.at(i) : "/" + segments.at(i);
+			}
+
+			return result;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void JSModules::StartCompile(Module* module)
+		{
+			Isolate* isolate = JSStateWrapper::Instance()->isolate();
+
+			module->streamed = Memory::default_allocator().Construct<ScriptCompiler::StreamedSource>(
+				new SourceStream(module->source),
+				ScriptCompiler::StreamedSource::UTF8);
+
+			ScriptCompiler::ScriptStreamingTask* task = ScriptCompiler::StartStreamingScript(isolate, module->streamed);
+
+			if (task == nullptr)
+			{
+				Memory::default_allocator().Destruct(module->streamed);
+				module->streamed = nullptr;
+				return;
+			}
+
+			Dispatch([task]()
+			{
+				task->Run();
+				delete task;
+			});
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		bool JSModules::Execute(Module* module)
+		{
+			JSStateWrapper* state = JSStateWrapper::Instance();
+			Isolate* isolate = state->isolate();
+			Local<v8::Context> ctx = state->Context();
+
+			Local<v8::String> source = JSWrapper::CreateString(module->source);
+			Local<v8::String> file_name = JSWrapper::CreateString(module->full_path);
+			ScriptOrigin origin(file_name);
+
+			TryCatch try_catch(isolate);
+
+			MaybeLocal<v8::Script> maybe_script;
+
+			if (module->streamed != nullptr)
+			{
+				maybe_script = ScriptCompiler::Compile(ctx, module->streamed, source, origin);
+
+				Memory::default_allocator().Destruct(module->streamed);
+				module->streamed = nullptr;
+			}
+			else
+			{
+				maybe_script = v8::Script::Compile(ctx, source, &origin);
+			}
+
+			Local<v8::Script> script;
+			Local<Value> result;
+
+			bool compiled = maybe_script.ToLocal(&script) == true && script->Run(ctx).ToLocal(&result) == true && result->IsFunction() == true;
+
+			if (compiled == true)
+			{
+				size_t separator = module->full_path.find_last_of('/');
+				engine::String directory = separator == engine::String::npos ? "" : module->full_path.substr(0, separator);
+
+				Local<v8::Object> object = JSWrapper::CreateObject();
+				Local<v8::Object> exports = JSWrapper::CreateObject();
+				JSWrapper::SetObjectValue<Local<Value>>(object, "exports", exports);
+
+				module->module.Reset(isolate, object);
+				module->state = States::kExecuting;
+
+				Local<Value> require = Function::New(ctx, RequireFrom, JSWrapper::CreateString(module->path)).ToLocalChecked();
+
+				Local<Value> argv[] =
+				{
+					exports,
+					require,
+					object,
+					file_name,
+					JSWrapper::CreateString(directory)
+				};
+
+				if (result.As<Function>()->Call(ctx, state->Global(), 5, argv).IsEmpty() == false)
+				{
+					module->state = States::kLoaded;
+					return true;
+				}
+			}
+
+			engine::String error;
+			if (state->GetException(&try_catch, &error) == false)
+			{
+				error = "Module '" + module->path + "' did not compile to a function";
+			}
+
+			Services::Get<LogService>().Log(console::LogSeverity::kError, error);
+
+			return false;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		JSModules::Module* JSModules::Create(const engine::String& path)
+		{
+			CVarString* src = Services::Get<CVarService>().Get<CVarString>("src_directory");
+
+			Module* module = Memory::default_allocator().Construct<Module>();
+			module->path = path;
+			module->full_path = src == nullptr || src->value().size() == 0 ? path : src->value() + "/" + path;
+			module->state = States::kUnread;
+			module->streamed = nullptr;
+
+			modules_.emplace(path, module);
+
+			return module;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void JSModules::Remove(const engine::String& path)
+		{
+			Map<engine::String, Module*>::iterator it = modules_.find(path);
+
+			if (it == modules_.end())
+			{
+				return;
+			}
+
+			Module* module = it->second;
+
+			if (module->streamed != nullptr)
+			{
+				Memory::default_allocator().Destruct(module->streamed);
+			}
+
+			module->module.Reset();
+			Memory::default_allocator().Destruct(module);
+
+			modules_.erase(it);
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void JSModules::Dispatch(const std::function<void()>& task)
+		{
+			ThreadPool* thread_pool = JSStateWrapper::Instance()->thread_pool_;
+
+			if (thread_pool == nullptr)
+			{
+				task();
+				return;
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(pending_mutex_);
+				++pending_;
+			}
+
+			thread_pool->Schedule([this, task]()
+			{
+				task();
+
+				{
+					std::lock_guard<std::mutex> lock(pending_mutex_);
+					--pending_;
+				}
+
+				pending_condition_.notify_all();
+			});
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void JSModules::Wait()
+		{
+			std::unique_lock<std::mutex> lock(pending_mutex_);
+			pending_condition_.wait(lock, [this]()
+			{
+				return pending_ == 0;
+			});
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void JSModules::Clear()
+		{
+			Wait();
+
+			while (modules_.empty() == false)
+			{
+				Remove(modules_.begin()->first);
+			}
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		bool JSModules::Require(const engine::String& path, Local<Value>* exports, const engine::String& from)
+		{
+			engine::String canonical = Normalize(path, from);
+
+			Map<engine::String, Module*>::iterator it = modules_.find(canonical);
+			Module* module = it != modules_.end() ? it->second : Create(canonical);
+
+			if (module->state == States::kUnread)
+			{
+				if (Read(module) == false)
+				{
+					Remove(canonical);
+					return false;
+				}
+			}
+
+			if (module->state == States::kRead)
+			{
+				ContentService& content_service = Services::Get<ContentService>();
+				content_service.Watch(canonical);
+
+				for (size_t i = 0; i < module->dependencies.size(); ++i)
+				{
+					content_service.Depend(canonical, module->dependencies.at(i));
+				}
+
+				if (Execute(module) == false)
+				{
+					Remove(canonical);
+					return false;
+				}
+			}
+
+			JSStateWrapper* state = JSStateWrapper::Instance();
+
+			Local<v8::Object> object = Local<v8::Object>::New(state->isolate(), module->module);
+			return object->Get(state->Context(), JSWrapper::CreateString("exports")).ToLocal(exports);
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void JSModules::Precompile(const engine::String& full_path, const engine::String& source)
+		{
+			Timer timer("Module precompilation");
+
+			engine::String entry = full_path;
+
+			CVarString* src = Services::Get<CVarService>().Get<CVarString>("src_directory");
+			if (src != nullptr && src->value().size() > 0 && entry.size() > src->value().size() &&
+				entry.compare(0, src->value().size(), src->value()) == 0 && entry.at(src->value().size()) == '/')
+			{
+				entry = entry.substr(src->value().size() + 1);
+			}
+
+			entry = Normalize(entry, "");
+
+			Vector<engine::String> pending;
+			Scan(source, &pending);
+
+			if (pending.empty() == true)
+			{
+				return;
+			}
+
+			for (size_t i = 0; i < pending.size(); ++i)
+			{
+				pending.at(i) = Normalize(pending.at(i), entry);
+			}
+
+			Vector<Module*> wave;
+
+			unsigned int count = 0;
+
+			while (pending.empty() == false)
+			{
+				wave.clear();
+
+				for (size_t i = 0; i < pending.size(); ++i)
+				{
+					if (modules_.find(pending.at(i)) == modules_.end())
+					{
+						wave.push_back(Create(pending.at(i)));
+					}
+				}
+
+				pending.clear();
+
+				for (size_t i = 0; i < wave.size(); ++i)
+				{
+					Module* module = wave.at(i);
+					Dispatch([module]()
+					{
+						Read(module);
+					});
+				}
+
+				Wait();
+
+				JSStateWrapper::IsolateLock lock(JSStateWrapper::Instance()->isolate());
+
+				for (size_t i = 0; i < wave.size(); ++i)
+				{
+					Module* module = wave.at(i);
+
+					if (module->state != States::kRead)
+					{
+						Remove(module->path);
+						continue;
+					}
+
+					StartCompile(module);
+					++count;
+
+					pending.insert(pending.end(), module->dependencies.begin(), module->dependencies.end());
+				}
+			}
+
+			Wait();
+
+			Services::Get<LogService>().Log(console::LogSeverity::kDebug, "Precompiled {0} module(s) in {1}ms", count, timer.Stop(Timer::Unit::kMilliseconds));
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void JSModules::Reload(const Vector<engine::String>& full_paths)
+		{
+			Vector<engine::String> reload;
+			Vector<engine::String> removed;
+
+			for (size_t i = 0; i < full_paths.size(); ++i)
+			{
+				for (Map<engine::String, Module*>::iterator it = modules_.begin(); it != modules_.end(); ++it)
+				{
+					if (it->second->full_path != full_paths.at(i))
+					{
+						continue;
+					}
+
+					if (it->second->state == States::kLoaded)
+					{
+						reload.push_back(it->first);
+					}
+
+					removed.push_back(it->first);
+					break;
+				}
+			}
+
+			for (size_t i = 0; i < removed.size(); ++i)
+			{
+				Remove(removed.at(i));
+			}
+
+			if (reload.empty() == true)
+			{
+				return;
+			}
+
+			JSStateWrapper::IsolateLock lock(JSStateWrapper::Instance()->isolate());
+
+			for (size_t i = 0; i < reload.size(); ++i)
+			{
+				Local<Value> exports;
+				Require(reload.at(i), &exports);
+			}
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		JSModules::~JSModules()
+		{
+			Clear();
+		}
+	}
+}
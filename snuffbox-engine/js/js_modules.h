@@ -0,0 +1,205 @@
+#pragma once
+
+#include "../core/eastl.h"
+
+#include <v8.h>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+namespace snuffbox
+{
+	namespace engine
+	{
+		class JSStateWrapper;
+
+		/**
+		* @class snuffbox::engine::JSModules
+		* @brief The module table of a JavaScript state, every required file runs once in its own function scope and is cached by path
+		* @remarks Modules receive 'exports', 'require', 'module', '__filename' and '__dirname' like CommonJS modules do
+		* @author Daniel Konings
+		*/
+		class JSModules
+		{
+
+			friend class JSStateWrapper;
+
+		protected:
+
+			/**
+			* @brief The different states a module can be in
+			*/
+			enum States
+			{
+				kUnread, //!< The module's source has not been read yet
+				kRead, //!< The module's source was read and decrypted, but it was never executed
+				kExecuting, //!< The module is executing, requiring it again returns its partial exports
+				kLoaded //!< The module was executed and its exports are final
+			};
+
+			/**
+			* @struct snuffbox::engine::JSModules::Module
+			* @brief A single module in the module table
+			* @author Daniel Konings
+			*/
+			struct Module
+			{
+				String path; //!< The canonical path of the module, relative to the source directory
+				String full_path; //!< The path including the source directory
+				String source; //!< The decrypted source, wrapped in the module function
+				Vector<String> dependencies; //!< The paths of the modules that are required with a string literal
+				States state; //!< The state of the module
+				v8::ScriptCompiler::StreamedSource* streamed; //!< The source that is being compiled in the background, if any
+				v8::Persistent<v8::Object> module; //!< The 'module' object that holds the exports
+			};
+
+			/**
+			* @class snuffbox::engine::JSModules::SourceStream : public v8::ScriptCompiler::ExternalSourceStream
+			* @brief Streams a module's source, which is already in memory, to the V8 background compiler in a single chunk
+			* @author Daniel Konings
+			*/
+			class SourceStream : public v8::ScriptCompiler::ExternalSourceStream
+			{
+
+			public:
+
+				/**
+				* @brief Construct by specifying the source to stream
+				* @param[in] source (const snuffbox::engine::String&) The source, which should outlive the stream
+				*/
+				SourceStream(const String& source);
+
+				/**
+				* @see v8::ScriptCompiler::ExternalSourceStream::GetMoreData
+				*/
+				size_t GetMoreData(const uint8_t** src) override;
+
+			private:
+
+				const String& source_; //!< The source to stream
+				bool streamed_; //!< Was the source streamed already?
+			};
+
+			/**
+			* @brief Default constructor
+			*/
+			JSModules();
+
+			/**
+			* @brief Reads and decrypts the source of a module and scans it for its dependencies
+			* @param[in] module (snuffbox::engine::JSModules::Module*) The module to read
+			* @return (bool) Was the module read succesfully?
+			* @remarks This can be called from any thread
+			*/
+			static bool Read(Module* module);
+
+			/**
+			* @brief Collects every string literal that is passed to 'require' in a piece of source
+			* @param[in] source (const snuffbox::engine::String&) The source to scan
+			* @param[out] dependencies (snuffbox::engine::Vector<snuffbox::engine::String>*) The required paths
+			*/
+			static void Scan(const String& source, Vector<String>* dependencies);
+
+			/**
+			* @brief The 'require' function that is passed to a module, which resolves relative paths from the module's directory
+			* @param[in] args (const v8::FunctionCallbackInfo<v8::Value>&) The arguments, with the canonical path of the requiring module as data
+			*/
+			static void RequireFrom(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+			/**
+			* @brief Starts compiling a module that was read on a background thread
+			* @param[in] module (snuffbox::engine::JSModules::Module*) The module to compile
+			*/
+			void StartCompile(Module* module);
+
+			/**
+			* @brief Compiles and executes a module that was read, in the current context
+			* @param[in] module (snuffbox::engine::JSModules::Module*) The module to execute
+			* @return (bool) Was the module executed succesfully?
+			*/
+			bool Execute(Module* module);
+
+			/**
+			* @brief Creates a module entry in the table
+			* @param[in] path (const snuffbox::engine::String&) The path of the module
+			* @return (snuffbox::engine::JSModules::Module*) The created module
+			*/
+			Module* Create(const String& path);
+
+			/**
+			* @brief Removes a module from the table and releases it
+			* @param[in] path (const snuffbox::engine::String&) The path of the module
+			*/
+			void Remove(const String& path);
+
+			/**
+			* @brief Runs a task on the thread pool of the current state, or directly if there is none
+			* @param[in] task (const std::function<void()>&) The task to run
+			*/
+			void Dispatch(const std::function<void()>& task);
+
+			/**
+			* @brief Waits for all dispatched tasks to finish
+			*/
+			void Wait();
+
+			/**
+			* @brief Releases every module
+			* @remarks This should be called before the isolate is disposed
+			*/
+			void Clear();
+
+		public:
+
+			/**
+			* @brief Converts a required path to the canonical path of a module, relative to the source directory
+			* @param[in] path (const snuffbox::engine::String&) The required path
+			* @param[in] from (const snuffbox::engine::String&) The canonical path of the requiring module, empty for the entry script
+			* @return (snuffbox::engine::String) The canonical path, with forward slashes and without '.' or '..' segments that can be resolved
+			* @remarks Paths that start with './' or '../' are relative to the directory of the requiring module, other paths are relative to the source directory
+			*/
+			static String Normalize(const String& path, const String& from);
+
+			/**
+			* @brief Requires a module, executing it the first time it is required
+			* @param[in] path (const snuffbox::engine::String&) The required path to the module, see snuffbox::engine::JSModules::Normalize
+			* @param[out] exports (v8::Local<v8::Value>*) The exports of the module
+			* @param[in] from (const snuffbox::engine::String&) The canonical path of the requiring module, empty for the entry script
+			* @return (bool) Was the module required succesfully?
+			* @remarks The caller should have a handle scope for the exports to live in
+			*/
+			bool Require(const String& path, v8::Local<v8::Value>* exports, const String& from = "");
+
+			/**
+			* @brief Reads, decrypts and compiles all modules that are reachable from an entry script in parallel
+			* @param[in] full_path (const snuffbox::engine::String&) The path to the entry script including the source directory, the entry is not a module itself
+			* @param[in] source (const snuffbox::engine::String&) The decrypted source of the entry script, which is scanned for requires instead of being read again
+			* @remarks Execution still happens on the main thread, in dependency order, as the modules are required
+			*/
+			void Precompile(const String& full_path, const String& source);
+
+			/**
+			* @brief Executes a batch of loaded modules again after their files, or the files they depend on, have changed
+			* @param[in] full_paths (const snuffbox::engine::Vector<snuffbox::engine::String>&) The paths to the affected files, including the source directory
+			* @remarks Every affected module is removed before any is executed again, so dependents receive the new exports of their dependencies
+			*/
+			void Reload(const Vector<String>& full_paths);
+
+			/**
+			* @brief Default destructor
+			*/
+			~JSModules();
+
+		private:
+
+			Map<String, Module*> modules_; //!< The module table, by canonical path
+
+			std::mutex pending_mutex_; //!< The mutex that guards the number of pending tasks
+			std::condition_variable pending_condition_; //!< Signaled when a dispatched task finishes
+			unsigned int pending_; //!< The number of dispatched tasks that have not finished yet
+
+			static const char* PREFIX_; //!< The code that is prepended to a module's source
+			static const char* SUFFIX_; //!< The code that is appended to a module's source
+		};
+	}
+}
@@ -1,4 +1,5 @@
 #include "js_object_register.h"
+#include "js_worker.h"
 
 #include "../logging/logger.h"
 #include "../logging/cvar.h"
@@ -19,6 +20,12 @@ namespace snuffbox
 		void JSRegister::RegisterSingletons(const v8::Local<v8::Object>& ns)
 		{
 			JSObjectRegister<Logger>::RegisterSingleton(ns);
+
+			if (JSStateWrapper::Instance()->worker() != nullptr)
+			{
+				return;
+			}
+
 			JSObjectRegister<CVar>::RegisterSingleton(ns);
 			JSObjectRegister<ContentManager>::RegisterSingleton(ns);
 			JSObjectRegister<Window>::RegisterSingleton(ns);
@@ -30,6 +37,11 @@ namespace snuffbox
 		{
 			JSObjectRegister<File>::Register(ns);
 			JSObjectRegister<Timer>::Register(ns);
+
+			if (JSStateWrapper::Instance()->worker() == nullptr)
+			{
+				JSObjectRegister<JSWorker>::Register(ns);
+			}
 		}
 
 		//-----------------------------------------------------------------------------------------------
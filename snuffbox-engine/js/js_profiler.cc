@@ -0,0 +1,247 @@
+#include "js_profiler.h"
+#include "js_state_wrapper.h"
+#include "js_wrapper.h"
+
+#include "../io/file.h"
+
+#include "../logging/cvar.h"
+#include "../services/log_service.h"
+#include "../services/cvar_service.h"
+
+using namespace v8;
+
+namespace snuffbox
+{
+	namespace engine
+	{
+		//-----------------------------------------------------------------------------------------------
+		const char* JSProfiler::TITLE_ = "snuffbox";
+
+		//-----------------------------------------------------------------------------------------------
+		const char* JSProfiler::DEFAULT_PATH_ = "profile.folded";
+
+		//-----------------------------------------------------------------------------------------------
+		const int JSProfiler::DEFAULT_INTERVAL_ = 1000;
+
+		//-----------------------------------------------------------------------------------------------
+		JSProfiler::JSProfiler() :
+			profiler_(nullptr),
+			profiling_(false),
+			frames_(0),
+			frame_(0),
+			path_(""),
+			start_requested_(false),
+			stop_requested_(false),
+			requested_frames_(0),
+			requested_path_("")
+		{
+
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void JSProfiler::Update()
+		{
+			CVarService& cvar = Services::Get<CVarService>();
+
+			CVarNumber* cvprofile = cvar.Get<CVarNumber>("profile");
+			if (cvprofile != nullptr && cvprofile->value() > 0.0f)
+			{
+				CVarString* cvfile = cvar.Get<CVarString>("profile_file");
+				Profile(cvprofile->As<unsigned int>(), cvfile != nullptr ? cvfile->value() : DEFAULT_PATH_);
+
+				cvar.Set<CVarNumber>("profile", 0.0f);
+			}
+
+			bool start = false;
+			bool stop = false;
+			unsigned int frames = 0;
+			String path;
+
+			{
+				std::lock_guard<std::mutex> lock(request_mutex_);
+
+				start = start_requested_;
+				stop = stop_requested_;
+				frames = requested_frames_;
+				path = requested_path_;
+
+				start_requested_ = false;
+				stop_requested_ = false;
+			}
+
+			if (profiling_ == true && (stop == true || frame_ >= frames_))
+			{
+				Finish();
+			}
+
+			if (start == true)
+			{
+				if (profiling_ == true)
+				{
+					Services::Get<LogService>().Log(console::LogSeverity::kWarning, "A profile is already running, ignoring the request to profile {0} frame(s)", frames);
+				}
+				else
+				{
+					Start(frames, path);
+				}
+			}
+
+			if (profiling_ == true)
+			{
+				++frame_;
+			}
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void JSProfiler::Start(unsigned int frames, const String& path)
+		{
+			JSStateWrapper* state = JSStateWrapper::Instance();
+			Isolate* isolate = state->isolate();
+
+			JSStateWrapper::IsolateLock lock(isolate);
+
+			int interval = DEFAULT_INTERVAL_;
+
+			CVarNumber* cvinterval = Services::Get<CVarService>().Get<CVarNumber>("profile_interval");
+			if (cvinterval != nullptr && cvinterval->value() > 0.0f)
+			{
+				interval = cvinterval->As<int>();
+			}
+
+			profiler_ = CpuProfiler::New(isolate);
+			profiler_->SetSamplingInterval(interval);
+			profiler_->StartProfiling(JSWrapper::CreateString(TITLE_), false);
+
+			frames_ = frames;
+			frame_ = 0;
+			path_ = path.size() > 0 ? path : DEFAULT_PATH_;
+			profiling_ = true;
+
+			Services::Get<LogService>().Log(console::LogSeverity::kInfo, "Profiling the scripts for {0} frame(s), sampling every {1}us", frames_, interval);
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void JSProfiler::Finish()
+		{
+			LogService& log = Services::Get<LogService>();
+
+			JSStateWrapper::IsolateLock lock(JSStateWrapper::Instance()->isolate());
+
+			CpuProfile* profile = profiler_->StopProfiling(JSWrapper::CreateString(TITLE_));
+
+			profiler_->Dispose();
+			profiler_ = nullptr;
+			profiling_ = false;
+
+			if (profile == nullptr)
+			{
+				log.Log(console::LogSeverity::kError, "The profiler did not return a profile");
+				return;
+			}
+
+			String output;
+			unsigned int samples = Collapse(profile->GetTopDownRoot(), "", &output);
+			float duration = static_cast<float>(profile->GetEndTime() - profile->GetStartTime()) * 1e-3f;
+
+			profile->Delete();
+
+			File* file = File::Open(path_, File::AccessFlags::kWrite | File::AccessFlags::kBinary);
+			bool written = file->Write(reinterpret_cast<const unsigned char*>(output.c_str()), output.size());
+			File::Close(file);
+
+			if (written == false)
+			{
+				log.Log(console::LogSeverity::kError, "Could not write the profile to '{0}'", path_);
+				return;
+			}
+
+			log.Log(console::LogSeverity::kSuccess, "Profiled {0} frame(s) in {1}ms with {2} sample(s), written to '{3}'", frame_, duration, samples, path_);
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		unsigned int JSProfiler::Collapse(const CpuProfileNode* node, const String& stack, String* output)
+		{
+			String name = node->GetFunctionNameStr();
+
+			if (name.size() == 0)
+			{
+				name = "(anonymous)";
+			}
+
+			String script = node->GetScriptResourceNameStr();
+
+			if (script.size() > 0)
+			{
+				name += " " + script + ":" + std::to_string(node->GetLineNumber()).c_str();
+			}
+
+			for (size_t i = 0; i < name.size(); ++i)
+			{
+				if (name.at(i) == ';')
+				{
+					name.at(i) = ':';
+				}
+			}
+
+			String frame = stack.size() > 0 ? stack + ";" + name : name;
+
+			unsigned int samples = node->GetHitCount();
+
+			if (samples > 0)
+			{
+				*output += frame + " " + std::to_string(samples).c_str() + "\n";
+			}
+
+			for (int i = 0; i < node->GetChildrenCount(); ++i)
+			{
+				samples += Collapse(node->GetChild(i), frame, output);
+			}
+
+			return samples;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void JSProfiler::Profile(unsigned int frames, const String& path)
+		{
+			std::lock_guard<std::mutex> lock(request_mutex_);
+
+			start_requested_ = true;
+			requested_frames_ = frames;
+			requested_path_ = path;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void JSProfiler::Stop()
+		{
+			std::lock_guard<std::mutex> lock(request_mutex_);
+			stop_requested_ = true;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		bool JSProfiler::IsProfiling() const
+		{
+			return profiling_;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		JSProfiler::~JSProfiler()
+		{
+			if (profiler_ == nullptr)
+			{
+				return;
+			}
+
+			JSStateWrapper::IsolateLock lock(JSStateWrapper::Instance()->isolate());
+
+			CpuProfile* profile = profiler_->StopProfiling(JSWrapper::CreateString(TITLE_));
+
+			if (profile != nullptr)
+			{
+				profile->Delete();
+			}
+
+			profiler_->Dispose();
+			profiler_ = nullptr;
+		}
+	}
+}
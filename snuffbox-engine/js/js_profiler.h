@@ -0,0 +1,103 @@
+#pragma once
+
+#include "../services/profiler_service.h"
+
+#include <v8-profiler.h>
+#include <atomic>
+#include <mutex>
+
+namespace snuffbox
+{
+	namespace engine
+	{
+		class SnuffboxApp;
+
+		/**
+		* @class snuffbox::engine::JSProfiler : public snuffbox::engine::ProfilerService
+		* @brief Samples the JavaScript state with the V8 CPU profiler over a number of frames and writes the result as collapsed stacks
+		* @remarks The output can be fed directly into flame graph tools, e.g. 'flamegraph.pl' or speedscope
+		* @author Daniel Konings
+		*/
+		class JSProfiler : public ProfilerService
+		{
+
+			friend class SnuffboxApp;
+			friend class Allocator;
+
+		protected:
+
+			/**
+			* @brief Default constructor
+			*/
+			JSProfiler();
+
+			/**
+			* @brief Starts a profile when requested through the CVars or the service and stops it after the requested number of frames
+			* @remarks This should be called on the main thread, once per frame
+			*/
+			void Update();
+
+			/**
+			* @brief Starts the V8 CPU profiler
+			* @param[in] frames (unsigned int) The number of frames to profile
+			* @param[in] path (const snuffbox::engine::String&) The path to write the collapsed stacks to
+			*/
+			void Start(unsigned int frames, const String& path);
+
+			/**
+			* @brief Stops the V8 CPU profiler and writes the results
+			*/
+			void Finish();
+
+			/**
+			* @brief Appends the collapsed stacks of a profile node and all of its children
+			* @param[in] node (const v8::CpuProfileNode*) The node to append
+			* @param[in] stack (const snuffbox::engine::String&) The collapsed stack of the node's parent
+			* @param[out] output (snuffbox::engine::String*) The output to append to
+			* @return (unsigned int) The total number of samples in the node and its children
+			*/
+			static unsigned int Collapse(const v8::CpuProfileNode* node, const String& stack, String* output);
+
+		public:
+
+			/**
+			* @see snuffbox::engine::ProfilerService::Profile
+			*/
+			void Profile(unsigned int frames, const String& path) override;
+
+			/**
+			* @see snuffbox::engine::ProfilerService::Stop
+			*/
+			void Stop() override;
+
+			/**
+			* @see snuffbox::engine::ProfilerService::IsProfiling
+			*/
+			bool IsProfiling() const override;
+
+			/**
+			* @brief Default destructor, stops a running profile without writing it
+			*/
+			~JSProfiler();
+
+		private:
+
+			v8::CpuProfiler* profiler_; //!< The V8 CPU profiler, only alive while profiling
+			std::atomic<bool> profiling_; //!< Is a profile currently running?
+
+			unsigned int frames_; //!< The number of frames to profile
+			unsigned int frame_; //!< The number of frames that were profiled so far
+			String path_; //!< The path to write the current profile to
+
+			std::mutex request_mutex_; //!< The mutex that guards the requests from other threads
+			bool start_requested_; //!< Was a profile requested?
+			bool stop_requested_; //!< Was the running profile requested to stop?
+			unsigned int requested_frames_; //!< The number of frames of the requested profile
+			String requested_path_; //!< The path of the requested profile
+
+			static const char* TITLE_; //!< The title of the V8 profile
+			static const char* DEFAULT_PATH_; //!< The default path to write profiles to
+			static const int DEFAULT_INTERVAL_; //!< The default sampling interval in microseconds
+		};
+	}
+}
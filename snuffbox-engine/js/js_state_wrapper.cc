@@ -6,13 +6,11 @@
 #include "js_defines.h"
 #include "js_function_register.h"
 #include "js_object_register.h"
+#include "js_worker.h"
 
 #include "../services/log_service.h"
-#include "../services/content_service.h"
 #include "../services/window_service.h"
 
-#include "../io/script.h"
-
 using namespace v8;
 
 namespace snuffbox
@@ -20,11 +18,20 @@ namespace snuffbox
 	namespace engine
 	{
 		//-----------------------------------------------------------------------------------------------
-		JSStateWrapper* JSStateWrapper::instance_ = nullptr;
+		thread_local JSStateWrapper* JSStateWrapper::instance_ = nullptr;
+
+		//-----------------------------------------------------------------------------------------------
+		JSStateWrapper* JSStateWrapper::main_ = nullptr;
+
+		//-----------------------------------------------------------------------------------------------
+		Platform* JSStateWrapper::platform_ = nullptr;
 
 		//-----------------------------------------------------------------------------------------------
 		const unsigned int JSStateWrapper::STACK_LIMIT_ = 1024 * 1024 * 2;
 
+		//-----------------------------------------------------------------------------------------------
+		const unsigned int JSStateWrapper::GC_PAUSE_COUNT_;
+
 		//-----------------------------------------------------------------------------------------------
 		JSStateWrapper::IsolateLock::IsolateLock(Isolate* isolate) :
 			lock_(isolate),
@@ -41,29 +48,58 @@ namespace snuffbox
 		}
 
 		//-----------------------------------------------------------------------------------------------
-		JSStateWrapper::JSStateWrapper(Allocator& allocator) :
+		JSStateWrapper::JSStateWrapper(Allocator& allocator, JSWorker* worker) :
             allocator_(allocator),
 			isolate_(nullptr),
-			platform_(nullptr)
+			worker_(worker),
+			thread_pool_(nullptr),
+			gc_start_(0.0),
+			gc_time_(0.0),
+			gc_count_(0),
+			start_time_(0.0),
+			gc_total_time_(0.0),
+			gc_total_count_(0)
 		{
 
 		}
 
 		//-----------------------------------------------------------------------------------------------
-		void JSStateWrapper::Initialise()
+		void JSStateWrapper::Initialise(ThreadPool* thread_pool)
 		{
-			assert(instance_ == nullptr);
+			assert(main_ == nullptr);
 
-			LogService& log = Services::Get<LogService>();
+			thread_pool_ = thread_pool;
+
+			InitialiseV8();
+			CreateState();
+
+			main_ = this;
 
+			Services::Get<LogService>().Log(console::LogSeverity::kSuccess, "Successfully initialised V8");
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void JSStateWrapper::InitialiseV8()
+		{
 			V8::Initialize();
-			platform_ = platform::CreateDefaultPlatform();
+			platform_ = platform::CreateDefaultPlatform(0, platform::IdleTaskSupport::kEnabled);
 			V8::InitializePlatform(platform_);
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void JSStateWrapper::CreateState()
+		{
+			start_time_ = platform_->MonotonicallyIncreasingTime();
 
 			Isolate::CreateParams params;
             params.array_buffer_allocator = &allocator_;
 			isolate_ = Isolate::New(params);
+			isolate_->SetData(0, this);
 
+			isolate_->AddGCPrologueCallback(OnGCPrologue);
+			isolate_->AddGCEpilogueCallback(OnGCEpilogue);
+
+			Locker locker(isolate_);
 			HandleScope scope(isolate_);
 
             Local<ObjectTemplate> global = CreateGlobal();
@@ -80,8 +116,6 @@ namespace snuffbox
 
 			RegisterGlobal("Application", JSWrapper::CreateObject());
 
-			log.Log(console::LogSeverity::kSuccess, "Successfully initialised V8");
-
 			Exit();
 		}
 
@@ -222,26 +256,224 @@ namespace snuffbox
 			log.Log(console::LogSeverity::kDebug, "Collected all JavaScript garbage");
 		}
 
+		//-----------------------------------------------------------------------------------------------
+		void JSStateWrapper::IdleNotification(double idle_time)
+		{
+			IsolateLock lock(isolate_);
+
+			double deadline = platform_->MonotonicallyIncreasingTime() + idle_time;
+
+			PumpMessageLoop();
+
+			double remaining = deadline - platform_->MonotonicallyIncreasingTime();
+
+			if (remaining <= 0.0)
+			{
+				return;
+			}
+
+			platform::RunIdleTasks(platform_, isolate_, remaining);
+			isolate_->IdleNotificationDeadline(deadline);
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void JSStateWrapper::PumpMessageLoop()
+		{
+			while (platform::PumpMessageLoop(platform_, isolate_) == true)
+			{
+
+			}
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		float JSStateWrapper::ConsumeGCPauses(unsigned int* count)
+		{
+			float time = static_cast<float>(gc_time_ * 1e3);
+
+			if (count != nullptr)
+			{
+				*count = gc_count_;
+			}
+
+			gc_time_ = 0.0;
+			gc_count_ = 0;
+
+			return time;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void JSStateWrapper::OnGCPrologue(Isolate* isolate, GCType type, GCCallbackFlags flags)
+		{
+			JSStateWrapper* state = static_cast<JSStateWrapper*>(isolate->GetData(0));
+
+			if (state == nullptr)
+			{
+				return;
+			}
+
+			state->gc_start_ = platform_->MonotonicallyIncreasingTime();
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void JSStateWrapper::OnGCEpilogue(Isolate* isolate, GCType type, GCCallbackFlags flags)
+		{
+			JSStateWrapper* state = static_cast<JSStateWrapper*>(isolate->GetData(0));
+
+			if (state == nullptr)
+			{
+				return;
+			}
+
+			double duration = platform_->MonotonicallyIncreasingTime() - state->gc_start_;
+
+			GCPause& pause = state->gc_pauses_[state->gc_total_count_ % GC_PAUSE_COUNT_];
+			pause.type = type;
+			pause.time = static_cast<float>(state->gc_start_ - state->start_time_);
+			pause.duration = static_cast<float>(duration * 1e3);
+
+			state->gc_time_ += duration;
+			state->gc_total_time_ += duration;
+
+			++state->gc_count_;
+			++state->gc_total_count_;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		JSStateWrapper::HeapStats JSStateWrapper::GetHeapStats()
+		{
+			IsolateLock lock(isolate_);
+
+			HeapStatistics heap;
+			isolate_->GetHeapStatistics(&heap);
+
+			HeapStats stats;
+
+			stats.total_heap_size = heap.total_heap_size();
+			stats.total_physical_size = heap.total_physical_size();
+			stats.total_available_size = heap.total_available_size();
+			stats.used_heap_size = heap.used_heap_size();
+			stats.heap_size_limit = heap.heap_size_limit();
+			stats.malloced_memory = heap.malloced_memory();
+			stats.peak_malloced_memory = heap.peak_malloced_memory();
+
+			stats.array_buffer_size = allocator_.allocated();
+			stats.array_buffer_peak = allocator_.peak();
+			stats.array_buffer_count = allocator_.count();
+
+			stats.gc_count = gc_total_count_;
+			stats.gc_time = static_cast<float>(gc_total_time_ * 1e3);
+
+			return stats;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		Vector<JSStateWrapper::HeapSpaceStats> JSStateWrapper::GetHeapSpaceStats()
+		{
+			IsolateLock lock(isolate_);
+
+			size_t count = isolate_->NumberOfHeapSpaces();
+
+			Vector<HeapSpaceStats> spaces;
+			spaces.reserve(count);
+
+			HeapSpaceStatistics space;
+			HeapSpaceStats stats;
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				if (isolate_->GetHeapSpaceStatistics(&space, i) == false)
+				{
+					continue;
+				}
+
+				stats.name = space.space_name();
+				stats.size = space.space_size();
+				stats.used_size = space.space_used_size();
+				stats.available_size = space.space_available_size();
+				stats.physical_size = space.physical_space_size();
+
+				spaces.push_back(stats);
+			}
+
+			return spaces;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		Vector<JSStateWrapper::GCPause> JSStateWrapper::GetGCPauses(unsigned int max)
+		{
+			IsolateLock lock(isolate_);
+
+			unsigned int count = std::min(std::min(max, GC_PAUSE_COUNT_), gc_total_count_);
+
+			Vector<GCPause> pauses;
+			pauses.reserve(count);
+
+			for (unsigned int i = 1; i <= count; ++i)
+			{
+				pauses.push_back(gc_pauses_[(gc_total_count_ - i) % GC_PAUSE_COUNT_]);
+			}
+
+			return pauses;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		const char* JSStateWrapper::GCTypeToString(GCType type)
+		{
+			switch (type)
+			{
+			case GCType::kGCTypeScavenge:
+				return "scavenge";
+			case GCType::kGCTypeMarkSweepCompact:
+				return "mark-sweep-compact";
+			case GCType::kGCTypeIncrementalMarking:
+				return "incremental-marking";
+			case GCType::kGCTypeProcessWeakCallbacks:
+				return "weak-callbacks";
+			default:
+				return "unknown";
+			}
+		}
+
 		//-----------------------------------------------------------------------------------------------
 		void JSStateWrapper::Dispose()
 		{
-			LogService& log = Services::Get<LogService>();
+			isolate_->RemoveGCPrologueCallback(OnGCPrologue);
+			isolate_->RemoveGCEpilogueCallback(OnGCEpilogue);
+
+			{
+				Locker locker(isolate_);
+				isolate_->LowMemoryNotification();
+			}
 
-			isolate_->LowMemoryNotification();
 			isolate_->Dispose();
+			isolate_ = nullptr;
+		}
 
+		//-----------------------------------------------------------------------------------------------
+		void JSStateWrapper::ShutdownV8()
+		{
 			V8::Dispose();
 			V8::ShutdownPlatform();
 
-			log.Log(console::LogSeverity::kSuccess, "Successfully cleaned up V8");
+			delete platform_;
+			platform_ = nullptr;
+
+			Services::Get<LogService>().Log(console::LogSeverity::kSuccess, "Successfully cleaned up V8");
 		}
 
 		//-----------------------------------------------------------------------------------------------
 		void JSStateWrapper::Shutdown()
 		{
 			CollectGarbage();
+			modules_.Clear();
 			Dispose();
 
+			if (worker_ == nullptr)
+			{
+				ShutdownV8();
+				main_ = nullptr;
+			}
+
 			instance_ = nullptr;
 		}
 
@@ -269,6 +501,12 @@ namespace snuffbox
 			return isolate_;
 		}
 
+		//-----------------------------------------------------------------------------------------------
+		JSWorker* JSStateWrapper::worker() const
+		{
+			return worker_;
+		}
+
 		//-----------------------------------------------------------------------------------------------
 		bool JSStateWrapper::Run(const engine::String& src, const engine::String& file_name, engine::String* output, engine::String* error)
 		{
@@ -304,11 +542,19 @@ namespace snuffbox
 			return true;
 		}
 
+		//-----------------------------------------------------------------------------------------------
+		JSModules& JSStateWrapper::modules()
+		{
+			return modules_;
+		}
+
 		//-----------------------------------------------------------------------------------------------
 		JSStateWrapper* JSStateWrapper::Instance()
 		{
-			assert(instance_ != nullptr);
-			return instance_;
+			JSStateWrapper* instance = instance_ != nullptr ? instance_ : main_;
+			assert(instance != nullptr);
+
+			return instance;
 		}
 
 		//-----------------------------------------------------------------------------------------------
@@ -318,6 +564,7 @@ namespace snuffbox
 				JS_FUNCTION_REG(require),
 				JS_FUNCTION_REG(assert),
 				JS_FUNCTION_REG(forcegc),
+				JS_FUNCTION_REG(heapstats),
 				JS_FUNCTION_REG_END
 			};
 
@@ -331,10 +578,21 @@ namespace snuffbox
 		JS_FUNCTION_IMPL(JSStateWrapper, require, JS_BODY(
 		{
 			JSWrapper wrapper(args);
-			if (wrapper.Check("S") == true)
+			if (wrapper.Check<JSWrapper::kString>() == true)
 			{
 				engine::String path = wrapper.GetValue<engine::String>(0, "");
-				Services::Get<ContentService>().Load<engine::Script>(path, true);
+
+				if (JSStateWrapper::Instance()->worker() != nullptr)
+				{
+					JSWorker::Require(path);
+					return;
+				}
+
+				v8::Local<v8::Value> exports;
+				if (JSStateWrapper::Instance()->modules_.Require(path, &exports) == true)
+				{
+					wrapper.ReturnValue<v8::Local<v8::Value>>(exports);
+				}
 			}
 		}));
 
@@ -342,7 +600,7 @@ namespace snuffbox
 		JS_FUNCTION_IMPL(JSStateWrapper, assert, JS_BODY(
 		{
 			JSWrapper wrapper(args);
-			if (wrapper.Check("BS") == true)
+			if (wrapper.Check<JSWrapper::kBoolean, JSWrapper::kString>() == true)
 			{
 				Services::Get<LogService>().Assert(wrapper.GetValue<bool>(0, true), wrapper.GetValue<engine::String>(1, ""));
 			}
@@ -353,5 +611,66 @@ namespace snuffbox
 		{
 			JSStateWrapper::Instance()->isolate()->LowMemoryNotification();
 		}));
+
+		//-----------------------------------------------------------------------------------------------
+		JS_FUNCTION_IMPL(JSStateWrapper, heapstats, JS_BODY(
+		{
+			JSWrapper wrapper(args);
+			JSStateWrapper* state = JSStateWrapper::Instance();
+
+			HeapStats stats = state->GetHeapStats();
+			v8::Local<v8::Object> result = JSWrapper::CreateObject();
+
+			JSWrapper::SetObjectValue<double>(result, "totalHeapSize", static_cast<double>(stats.total_heap_size));
+			JSWrapper::SetObjectValue<double>(result, "totalPhysicalSize", static_cast<double>(stats.total_physical_size));
+			JSWrapper::SetObjectValue<double>(result, "totalAvailableSize", static_cast<double>(stats.total_available_size));
+			JSWrapper::SetObjectValue<double>(result, "usedHeapSize", static_cast<double>(stats.used_heap_size));
+			JSWrapper::SetObjectValue<double>(result, "heapSizeLimit", static_cast<double>(stats.heap_size_limit));
+			JSWrapper::SetObjectValue<double>(result, "mallocedMemory", static_cast<double>(stats.malloced_memory));
+			JSWrapper::SetObjectValue<double>(result, "peakMallocedMemory", static_cast<double>(stats.peak_malloced_memory));
+			JSWrapper::SetObjectValue<double>(result, "arrayBufferSize", static_cast<double>(stats.array_buffer_size));
+			JSWrapper::SetObjectValue<double>(result, "arrayBufferPeak", static_cast<double>(stats.array_buffer_peak));
+			JSWrapper::SetObjectValue<double>(result, "arrayBufferCount", static_cast<double>(stats.array_buffer_count));
+			JSWrapper::SetObjectValue<unsigned int>(result, "gcCount", stats.gc_count);
+			JSWrapper::SetObjectValue<float>(result, "gcTime", stats.gc_time);
+
+			Vector<HeapSpaceStats> spaces = state->GetHeapSpaceStats();
+			v8::Local<v8::Array> space_array = v8::Array::New(state->isolate(), static_cast<int>(spaces.size()));
+
+			for (size_t i = 0; i < spaces.size(); ++i)
+			{
+				const HeapSpaceStats& space = spaces.at(i);
+				v8::Local<v8::Object> obj = JSWrapper::CreateObject();
+
+				JSWrapper::SetObjectValue<engine::String>(obj, "name", space.name);
+				JSWrapper::SetObjectValue<double>(obj, "size", static_cast<double>(space.size));
+				JSWrapper::SetObjectValue<double>(obj, "usedSize", static_cast<double>(space.used_size));
+				JSWrapper::SetObjectValue<double>(obj, "availableSize", static_cast<double>(space.available_size));
+				JSWrapper::SetObjectValue<double>(obj, "physicalSize", static_cast<double>(space.physical_size));
+
+				space_array->Set(state->Context(), static_cast<uint32_t>(i), obj);
+			}
+
+			JSWrapper::SetObjectValue<v8::Local<v8::Value>>(result, "spaces", space_array);
+
+			Vector<GCPause> pauses = state->GetGCPauses(GC_PAUSE_COUNT_);
+			v8::Local<v8::Array> pause_array = v8::Array::New(state->isolate(), static_cast<int>(pauses.size()));
+
+			for (size_t i = 0; i < pauses.size(); ++i)
+			{
+				const GCPause& pause = pauses.at(i);
+				v8::Local<v8::Object> obj = JSWrapper::CreateObject();
+
+				JSWrapper::SetObjectValue<engine::String>(obj, "type", GCTypeToString(pause.type));
+				JSWrapper::SetObjectValue<float>(obj, "time", pause.time);
+				JSWrapper::SetObjectValue<float>(obj, "duration", pause.duration);
+
+				pause_array->Set(state->Context(), static_cast<uint32_t>(i), obj);
+			}
+
+			JSWrapper::SetObjectValue<v8::Local<v8::Value>>(result, "pauses", pause_array);
+
+			wrapper.ReturnValue<v8::Local<v8::Value>>(result);
+		}));
 	}
 }
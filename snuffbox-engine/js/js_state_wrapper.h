@@ -4,6 +4,7 @@
 
 #include "js_allocator.h"
 #include "js_object.h"
+#include "js_modules.h"
 
 #include <mutex>
 
@@ -26,6 +27,11 @@ namespace snuffbox
 		class JSCallback;
 
         class Script;
+        class File;
+        class JSWorker;
+        class JSProfiler;
+        class ContentManager;
+        class ThreadPool;
 
         /**
         * @class snuffbox::engine::JSStateWrapper
@@ -50,6 +56,11 @@ namespace snuffbox
 			friend class JSCallback;
 
             friend class Script;
+            friend class File;
+            friend class JSWorker;
+            friend class JSProfiler;
+            friend class JSModules;
+            friend class ContentManager;
 
         protected:
 
@@ -84,13 +95,26 @@ namespace snuffbox
             /**
             * @brief Default constructor
             * @param[in] allocator (snuffbox::engine::Allocator&) The allocator to use for the JavaScript state
+            * @param[in] worker (snuffbox::engine::JSWorker*) The worker this state runs for, nullptr for the main state, default = nullptr
             */
-            JSStateWrapper(Allocator& allocator);
+            JSStateWrapper(Allocator& allocator, JSWorker* worker = nullptr);
 
             /**
-            * @brief Initialises V8 and the JavaScript context
+            * @brief Initialises V8 and the JavaScript context of the main state
+            * @param[in] thread_pool (snuffbox::engine::ThreadPool*) The thread pool to run worker states on
             */
-            void Initialise();
+            void Initialise(ThreadPool* thread_pool);
+
+            /**
+            * @brief Initialises the V8 platform, this is done once for the process by the main state
+            */
+            static void InitialiseV8();
+
+            /**
+            * @brief Creates the isolate and the context for this state and registers all native functions
+            * @remarks This sets the current instance for the calling thread to this state
+            */
+            void CreateState();
 
             /**
             * @brief Creates the global scope and returns it
@@ -143,16 +167,55 @@ namespace snuffbox
             void CollectGarbage();
 
             /**
-            * @brief Disposes V8
+            * @brief Runs pending V8 tasks and hands the remaining idle time of a frame to the garbage collector
+            * @param[in] idle_time (double) The idle time left in the current frame, in seconds
+            */
+            void IdleNotification(double idle_time);
+
+            /**
+            * @brief Retrieves the garbage collection pauses since the last call and resets them
+            * @param[out] count (unsigned int*) The number of collections that occurred
+            * @return (float) The total time spent in garbage collection pauses, in milliseconds
+            */
+            float ConsumeGCPauses(unsigned int* count);
+
+            /**
+            * @brief Called by V8 before a garbage collection starts
+            * @param[in] isolate (v8::Isolate*) The isolate that is being collected
+            * @param[in] type (v8::GCType) The type of garbage collection
+            * @param[in] flags (v8::GCCallbackFlags) The garbage collection flags
+            */
+            static void OnGCPrologue(v8::Isolate* isolate, v8::GCType type, v8::GCCallbackFlags flags);
+
+            /**
+            * @brief Called by V8 after a garbage collection has finished
+            * @param[in] isolate (v8::Isolate*) The isolate that was collected
+            * @param[in] type (v8::GCType) The type of garbage collection
+            * @param[in] flags (v8::GCCallbackFlags) The garbage collection flags
+            */
+            static void OnGCEpilogue(v8::Isolate* isolate, v8::GCType type, v8::GCCallbackFlags flags);
+
+            /**
+            * @brief Disposes the isolate of this state
             */
             void Dispose();
 
             /**
-            * @brief Shuts down and disposes V8
+            * @brief Disposes V8 and the V8 platform, this is done once for the process by the main state
+            */
+            static void ShutdownV8();
+
+            /**
+            * @brief Shuts down and disposes the state, V8 itself is only shut down by the main state
             * @remarks This also garbage collects any remaining memory
             */
             void Shutdown();
 
+            /**
+            * @brief Runs all pending foreground tasks that V8 posted for this state's isolate
+            */
+            void PumpMessageLoop();
+
             /**
             * @return (v8::Local::v8::Object>) The global scope of this JavaScript state
             */
@@ -173,8 +236,86 @@ namespace snuffbox
             */
             v8::Isolate* isolate() const;
 
+            /**
+            * @return (snuffbox::engine::JSWorker*) The worker this state runs for, nullptr for the main state
+            */
+            JSWorker* worker() const;
+
         public:
 
+            /**
+            * @struct snuffbox::engine::JSStateWrapper::HeapStats
+            * @brief Heap statistics of the JavaScript state, combined with the ArrayBuffer allocations of the snuffbox::engine::JSAllocator
+            * @author Daniel Konings
+            */
+            struct HeapStats
+            {
+                size_t total_heap_size; //!< The total size of the heap
+                size_t total_physical_size; //!< The physical memory committed for the heap
+                size_t total_available_size; //!< The size that is still available to the heap
+                size_t used_heap_size; //!< The size of the heap that is in use
+                size_t heap_size_limit; //!< The maximum size of the heap
+                size_t malloced_memory; //!< The memory V8 allocated outside of the heap
+                size_t peak_malloced_memory; //!< The peak memory V8 allocated outside of the heap
+                size_t array_buffer_size; //!< The bytes currently allocated for ArrayBuffers
+                size_t array_buffer_peak; //!< The peak bytes allocated for ArrayBuffers
+                size_t array_buffer_count; //!< The number of ArrayBuffer allocations that are alive
+                unsigned int gc_count; //!< The number of garbage collections since initialisation
+                float gc_time; //!< The total time spent in garbage collection pauses since initialisation, in milliseconds
+            };
+
+            /**
+            * @struct snuffbox::engine::JSStateWrapper::HeapSpaceStats
+            * @brief The statistics of a single space in the JavaScript heap
+            * @author Daniel Konings
+            */
+            struct HeapSpaceStats
+            {
+                engine::String name; //!< The name of the space
+                size_t size; //!< The size of the space
+                size_t used_size; //!< The size of the space that is in use
+                size_t available_size; //!< The size that is still available in the space
+                size_t physical_size; //!< The physical memory committed for the space
+            };
+
+            /**
+            * @struct snuffbox::engine::JSStateWrapper::GCPause
+            * @brief A single garbage collection pause, recorded by the GC callbacks
+            * @author Daniel Konings
+            */
+            struct GCPause
+            {
+                v8::GCType type; //!< The type of garbage collection
+                float time; //!< The time since initialisation at which the pause started, in seconds
+                float duration; //!< The duration of the pause, in milliseconds
+            };
+
+            /**
+            * @brief Collects the heap statistics of the JavaScript state
+            * @return (snuffbox::engine::JSStateWrapper::HeapStats) The collected statistics
+            */
+            HeapStats GetHeapStats();
+
+            /**
+            * @brief Collects the statistics of every space in the JavaScript heap
+            * @return (snuffbox::engine::Vector<snuffbox::engine::JSStateWrapper::HeapSpaceStats>) The statistics per space
+            */
+            Vector<HeapSpaceStats> GetHeapSpaceStats();
+
+            /**
+            * @brief Retrieves the most recent garbage collection pauses, newest first
+            * @param[in] max (unsigned int) The maximum number of pauses to retrieve, capped by GC_PAUSE_COUNT_
+            * @return (snuffbox::engine::Vector<snuffbox::engine::JSStateWrapper::GCPause>) The recorded pauses
+            */
+            Vector<GCPause> GetGCPauses(unsigned int max);
+
+            /**
+            * @brief Converts a garbage collection type to a string value
+            * @param[in] type (v8::GCType) The type to convert
+            * @return (const char*) The converted string value
+            */
+            static const char* GCTypeToString(v8::GCType type);
+
             /**
             * @brief Runs a specified piece of code from a virtual file
             * @param[in] src (const snuffbox::engine::String&) The JavaScript code to execute
@@ -186,7 +327,12 @@ namespace snuffbox
             bool Run(const engine::String& src, const engine::String& file_name, engine::String* output = nullptr, engine::String* error = nullptr);
 
             /**
-            * @return (snuffbox::engine::JSStateWrapper*) The current instance
+            * @return (snuffbox::engine::JSModules&) The module table of this JavaScript state
+            */
+            JSModules& modules();
+
+            /**
+            * @return (snuffbox::engine::JSStateWrapper*) The current instance of the calling thread, or the main state if the thread runs none
             */
             static JSStateWrapper* Instance();
 
@@ -214,9 +360,27 @@ namespace snuffbox
             v8::Persistent<v8::Context> context_; //!< The context we will use for this JavaScript state
             v8::Persistent<v8::ObjectTemplate> global_; //!< The global scope for use with the JavaScript state
 			v8::Persistent<v8::Object> namespace_; //!< The 'snuff' namespace
-            v8::Platform* platform_; //!< The V8 platform
 
-            static JSStateWrapper* instance_; //!< The current instance
+            JSModules modules_; //!< The module table of this JavaScript state
+
+            JSWorker* worker_; //!< The worker this state runs for, nullptr for the main state
+            ThreadPool* thread_pool_; //!< The thread pool worker states are run on
+
+            static v8::Platform* platform_; //!< The V8 platform, shared by every state
+
+            double gc_start_; //!< The platform time at which the current garbage collection started
+            double gc_time_; //!< The time spent in garbage collection pauses since the last consume, in seconds
+            unsigned int gc_count_; //!< The number of garbage collections since the last consume
+
+            double start_time_; //!< The platform time at which the JavaScript state was initialised
+            double gc_total_time_; //!< The time spent in garbage collection pauses since initialisation, in seconds
+            unsigned int gc_total_count_; //!< The number of garbage collections since initialisation
+
+            static const unsigned int GC_PAUSE_COUNT_ = 64; //!< The number of garbage collection pauses to keep track of
+            GCPause gc_pauses_[GC_PAUSE_COUNT_]; //!< The ring buffer of the most recent garbage collection pauses
+
+            static thread_local JSStateWrapper* instance_; //!< The current instance of the calling thread
+            static JSStateWrapper* main_; //!< The main state, used by threads that don't run a state of their own
 			static const unsigned int STACK_LIMIT_; //!< The stack limit for each isolate
 
         public:
@@ -234,6 +398,9 @@ namespace snuffbox
 
 			static void JSforcegc(const v8::FunctionCallbackInfo<v8::Value>& args);
 			static const char* js_forcegc_name_;
+
+			static void JSheapstats(const v8::FunctionCallbackInfo<v8::Value>& args);
+			static const char* js_heapstats_name_;
         };
 
         //-----------------------------------------------------------------------------------------------
@@ -247,7 +414,7 @@ namespace snuffbox
             ptr->object().Reset(isolate, obj);
             ptr->object().SetWeak(ptr, Destroy<T>, v8::WeakCallbackType::kParameter);
             ptr->object().MarkIndependent();
-			obj->SetPrivate(instance_->Context(),
+			obj->SetPrivate(Instance()->Context(),
 				v8::Private::ForApi(isolate, v8::String::NewFromUtf8(isolate, "__ptr", v8::NewStringType::kNormal).ToLocalChecked()),
                 v8::External::New(isolate, static_cast<void*>(ptr)));
 
@@ -269,7 +436,7 @@ namespace snuffbox
 
             Memory::default_allocator().Destruct<T>(ptr);
 
-            instance_->isolate()->AdjustAmountOfExternalAllocatedMemory(-size);
+            data.GetIsolate()->AdjustAmountOfExternalAllocatedMemory(-size);
         }
     }
 }
@@ -0,0 +1,530 @@
+#include "js_worker.h"
+#include "js_state_wrapper.h"
+#include "js_wrapper.h"
+#include "js_function_register.h"
+
+#include "../core/thread_pool.h"
+
+#include "../io/file.h"
+#include "../io/script.h"
+
+#include "../logging/cvar.h"
+#include "../services/log_service.h"
+#include "../services/cvar_service.h"
+
+#include <cstdlib>
+
+using namespace v8;
+
+namespace snuffbox
+{
+	namespace engine
+	{
+		//-----------------------------------------------------------------------------------------------
+		Vector<JSWorker*> JSWorker::workers_;
+
+		//-----------------------------------------------------------------------------------------------
+		void JSWorker::Update()
+		{
+			for (size_t i = 0; i < workers_.size(); ++i)
+			{
+				if (workers_.at(i) != nullptr)
+				{
+					workers_.at(i)->Deliver();
+				}
+			}
+
+			for (size_t i = workers_.size(); i > 0; --i)
+			{
+				if (workers_.at(i - 1) == nullptr)
+				{
+					workers_.erase(workers_.begin() + (i - 1));
+				}
+			}
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void JSWorker::TerminateAll()
+		{
+			for (size_t i = 0; i < workers_.size(); ++i)
+			{
+				if (workers_.at(i) != nullptr)
+				{
+					workers_.at(i)->Terminate();
+				}
+			}
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		bool JSWorker::Require(const engine::String& path)
+		{
+			JSWorker* worker = JSStateWrapper::Instance()->worker();
+			engine::String full_path = worker->src_directory_.size() > 0 ? worker->src_directory_ + "/" + path : path;
+
+			File* file = File::Open(full_path, File::AccessFlags::kRead | File::AccessFlags::kBinary | File::AccessFlags::kMapped);
+
+			Script script;
+			bool success = script.Load(file, nullptr);
+
+			File::Close(file);
+
+			return success;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		const engine::String& JSWorker::src_directory() const
+		{
+			return src_directory_;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void JSWorker::Terminate()
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+
+			if (terminated_ == false)
+			{
+				terminated_ = true;
+
+				while (inbox_.empty() == false)
+				{
+					Release(&inbox_.front());
+					inbox_.pop();
+				}
+
+				if (state_ == nullptr && scheduled_ == false)
+				{
+					disposed_ = true;
+				}
+				else if (scheduled_ == true)
+				{
+					if (state_ != nullptr)
+					{
+						state_->isolate()->TerminateExecution();
+					}
+				}
+				else
+				{
+					Schedule();
+				}
+			}
+
+			condition_.wait(lock, [this]()
+			{
+				return disposed_;
+			});
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		JSWorker::~JSWorker()
+		{
+			Terminate();
+
+			while (outbox_.empty() == false)
+			{
+				Release(&outbox_.front());
+				outbox_.pop();
+			}
+
+			for (size_t i = 0; i < workers_.size(); ++i)
+			{
+				if (workers_.at(i) == this)
+				{
+					workers_.at(i) = nullptr;
+				}
+			}
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		bool JSWorker::Serialize(const Local<Value>& value, const Local<Value>& transfer, Message* message)
+		{
+			JSStateWrapper* state = JSStateWrapper::Instance();
+			Isolate* isolate = state->isolate();
+			Local<v8::Context> ctx = state->Context();
+
+			ValueSerializer serializer(isolate);
+			Vector<Local<ArrayBuffer>> transferred;
+
+			if (transfer.IsEmpty() == false && transfer->IsArray() == true)
+			{
+				Local<Array> array = transfer.As<Array>();
+				Local<Value> element;
+
+				for (uint32_t i = 0; i < array->Length(); ++i)
+				{
+					if (array->Get(ctx, i).ToLocal(&element) == false || element->IsArrayBuffer() == false)
+					{
+						continue;
+					}
+
+					Local<ArrayBuffer> buffer = element.As<ArrayBuffer>();
+
+					if (buffer->IsExternal() == true || buffer->IsNeuterable() == false)
+					{
+						Services::Get<LogService>().Log(console::LogSeverity::kWarning, "An ArrayBuffer that is owned natively cannot be transferred, it will be copied instead");
+						continue;
+					}
+
+					serializer.TransferArrayBuffer(static_cast<uint32_t>(transferred.size()), buffer);
+					transferred.push_back(buffer);
+				}
+			}
+
+			serializer.WriteHeader();
+
+			bool written = false;
+			if (serializer.WriteValue(ctx, value).To(&written) == false || written == false)
+			{
+				return false;
+			}
+
+			message->buffers.clear();
+
+			for (size_t i = 0; i < transferred.size(); ++i)
+			{
+				Local<ArrayBuffer>& buffer = transferred.at(i);
+				ArrayBuffer::Contents contents = buffer->Externalize();
+				buffer->Neuter();
+
+				state->allocator_.Untrack(contents.ByteLength());
+				message->buffers.push_back(contents);
+			}
+
+			std::pair<uint8_t*, size_t> released = serializer.Release();
+			message->data = released.first;
+			message->size = released.second;
+
+			return true;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		bool JSWorker::Deserialize(Message* message, Local<Value>* value)
+		{
+			JSStateWrapper* state = JSStateWrapper::Instance();
+			Isolate* isolate = state->isolate();
+			Local<v8::Context> ctx = state->Context();
+
+			ValueDeserializer deserializer(isolate, message->data, message->size);
+
+			for (size_t i = 0; i < message->buffers.size(); ++i)
+			{
+				ArrayBuffer::Contents& contents = message->buffers.at(i);
+				Local<ArrayBuffer> buffer = ArrayBuffer::New(isolate, contents.Data(), contents.ByteLength(), ArrayBufferCreationMode::kInternalized);
+
+				state->allocator_.Track(contents.ByteLength());
+				deserializer.TransferArrayBuffer(static_cast<uint32_t>(i), buffer);
+			}
+
+			message->buffers.clear();
+
+			bool success = deserializer.ReadHeader(ctx).FromMaybe(false) == true && deserializer.ReadValue(ctx).ToLocal(value) == true;
+
+			free(message->data);
+			message->data = nullptr;
+
+			return success;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void JSWorker::Release(Message* message)
+		{
+			free(message->data);
+			message->data = nullptr;
+
+			for (size_t i = 0; i < message->buffers.size(); ++i)
+			{
+				Memory::default_allocator().Free(message->buffers.at(i).Data());
+			}
+
+			message->buffers.clear();
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void JSWorker::Schedule()
+		{
+			if (scheduled_ == true)
+			{
+				return;
+			}
+
+			scheduled_ = true;
+			thread_pool_->Schedule([this]()
+			{
+				Process();
+			});
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void JSWorker::Process()
+		{
+			JSStateWrapper* previous = JSStateWrapper::instance_;
+
+			bool terminated = false;
+
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				terminated = terminated_;
+			}
+
+			if (state_ == nullptr && terminated == false)
+			{
+				Start();
+			}
+
+			JSStateWrapper::instance_ = state_;
+
+			Message message;
+
+			while (true)
+			{
+				{
+					std::lock_guard<std::mutex> lock(mutex_);
+
+					if (terminated_ == true)
+					{
+						break;
+					}
+
+					if (inbox_.empty() == true)
+					{
+						scheduled_ = false;
+						JSStateWrapper::instance_ = previous;
+
+						return;
+					}
+
+					message = inbox_.front();
+					inbox_.pop();
+				}
+
+				JSStateWrapper::IsolateLock lock(state_->isolate());
+
+				Local<Value> value;
+				if (Deserialize(&message, &value) == true)
+				{
+					on_message_->Call(value);
+				}
+
+				state_->PumpMessageLoop();
+			}
+
+			if (state_ != nullptr)
+			{
+				Stop();
+			}
+
+			JSStateWrapper::instance_ = previous;
+
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				scheduled_ = false;
+				disposed_ = true;
+			}
+
+			condition_.notify_all();
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		bool JSWorker::Start()
+		{
+			Allocator& allocator = Memory::default_allocator();
+			JSStateWrapper* state = allocator.Construct<JSStateWrapper>(allocator, this);
+
+			state->CreateState();
+
+			bool terminated = false;
+
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				state_ = state;
+				terminated = terminated_;
+			}
+
+			on_message_ = allocator.Construct<JSCallback<Local<Value>>>();
+
+			if (terminated == true)
+			{
+				return false;
+			}
+
+			bool success = false;
+
+			{
+				JSStateWrapper::IsolateLock lock(state_->isolate());
+
+				JSFunctionRegister funcs[] =
+				{
+					JS_FUNCTION_REG(postMessage),
+					JS_FUNCTION_REG_END
+				};
+
+				JSFunctionRegister::Register(funcs);
+
+				success = Require(path_);
+
+				if (success == true)
+				{
+					on_message_->Set("onMessage");
+				}
+			}
+
+			return success;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void JSWorker::Stop()
+		{
+			Allocator& allocator = Memory::default_allocator();
+
+			state_->isolate()->CancelTerminateExecution();
+
+			{
+				JSStateWrapper::IsolateLock lock(state_->isolate());
+				allocator.Destruct(on_message_);
+				on_message_ = nullptr;
+			}
+
+			state_->Shutdown();
+
+			JSStateWrapper* state = state_;
+
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				state_ = nullptr;
+			}
+
+			allocator.Destruct(state);
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void JSWorker::Deliver()
+		{
+			Queue<Message> messages;
+
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				messages.swap(outbox_);
+			}
+
+			if (messages.empty() == true)
+			{
+				return;
+			}
+
+			JSStateWrapper::IsolateLock lock(JSStateWrapper::Instance()->isolate());
+
+			Local<Value> value;
+			while (messages.empty() == false)
+			{
+				if (Deserialize(&messages.front(), &value) == true)
+				{
+					callback_->Call(value);
+				}
+
+				messages.pop();
+			}
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		JS_CONSTRUCTOR(JSWorker, JS_BODY(
+		{
+			JSWrapper wrapper(args);
+
+			CVarString* src = Services::Get<CVarService>().Get<CVarString>("src_directory");
+
+			path_ = wrapper.GetValue<engine::String>(0, "");
+			src_directory_ = src != nullptr ? src->value() : "";
+			thread_pool_ = JSStateWrapper::Instance()->thread_pool_;
+			state_ = nullptr;
+			on_message_ = nullptr;
+			callback_ = Memory::ConstructUnique<JSCallback<Local<Value>>>();
+			scheduled_ = false;
+			terminated_ = false;
+			disposed_ = false;
+
+			workers_.push_back(this);
+
+			if (wrapper.Check<JSWrapper::kString>() == false)
+			{
+				terminated_ = true;
+				disposed_ = true;
+				return;
+			}
+
+			std::lock_guard<std::mutex> lock(mutex_);
+			Schedule();
+		}));
+
+		//-----------------------------------------------------------------------------------------------
+		JS_REGISTER_IMPL_TMPL(JSWorker, JS_BODY(
+		{
+			JSFunctionRegister funcs[] =
+			{
+				JS_FUNCTION_REG(post),
+				JS_FUNCTION_REG(onMessage),
+				JS_FUNCTION_REG(terminate),
+				JS_FUNCTION_REG_END
+			};
+
+			JSFunctionRegister::Register(funcs, obj);
+		}));
+
+		//-----------------------------------------------------------------------------------------------
+		JS_FUNCTION_IMPL(JSWorker, post, JS_BODY(
+		{
+			JS_SETUP(JSWorker);
+
+			Message message;
+			if (Serialize(args[0], args[1], &message) == false)
+			{
+				return;
+			}
+
+			std::lock_guard<std::mutex> lock(self->mutex_);
+
+			if (self->terminated_ == true)
+			{
+				Release(&message);
+				return;
+			}
+
+			self->inbox_.push(message);
+			self->Schedule();
+		}));
+
+		//-----------------------------------------------------------------------------------------------
+		JS_FUNCTION_IMPL(JSWorker, onMessage, JS_BODY(
+		{
+			JS_SETUP(JSWorker);
+
+			if (wrapper.Check<JSWrapper::kFunction>() == true)
+			{
+				self->callback_->Set(args[0]);
+			}
+		}));
+
+		//-----------------------------------------------------------------------------------------------
+		JS_FUNCTION_IMPL(JSWorker, terminate, JS_BODY(
+		{
+			JS_SETUP(JSWorker);
+
+			self->Terminate();
+		}));
+
+		//-----------------------------------------------------------------------------------------------
+		JS_FUNCTION_IMPL(JSWorker, postMessage, JS_BODY(
+		{
+			JSWrapper wrapper(args);
+			JSWorker* worker = JSStateWrapper::Instance()->worker();
+
+			Message message;
+			if (Serialize(args[0], args[1], &message) == false)
+			{
+				return;
+			}
+
+			std::lock_guard<std::mutex> lock(worker->mutex_);
+			worker->outbox_.push(message);
+		}));
+	}
+}
@@ -0,0 +1,165 @@
+#pragma once
+
+#include "js_defines.h"
+#include "js_callback.h"
+
+#include "../core/eastl.h"
+
+#include <mutex>
+#include <condition_variable>
+
+namespace snuffbox
+{
+	namespace engine
+	{
+		class JSStateWrapper;
+		class ThreadPool;
+
+		/**
+		* @class snuffbox::engine::JSWorker : [JSObject]
+		* @brief Runs a script in its own isolate on the thread pool, communicating with the main state by message passing
+		* @remarks Messages are structured clones; ArrayBuffers in the transfer list are moved without copying their contents
+		* @author Daniel Konings
+		*/
+		class JSWorker JS_OBJECT
+		{
+
+			friend class Allocator;
+
+		public:
+
+			/**
+			* @struct snuffbox::engine::JSWorker::Message
+			* @brief A serialized value that is passed between two JavaScript states
+			* @author Daniel Konings
+			*/
+			struct Message
+			{
+				uint8_t* data; //!< The serialized value
+				size_t size; //!< The size of the serialized value
+				Vector<v8::ArrayBuffer::Contents> buffers; //!< The contents of the ArrayBuffers that were transferred
+			};
+
+			/**
+			* @brief Delivers all messages that were posted by the workers to their main state callbacks
+			* @remarks This should be called on the main thread, once per frame
+			*/
+			static void Update();
+
+			/**
+			* @brief Terminates every running worker
+			* @remarks This should be called on the main thread, before the main state is shut down
+			*/
+			static void TerminateAll();
+
+			/**
+			* @brief Loads and runs a script in the state of the calling worker thread
+			* @param[in] path (const snuffbox::engine::String&) The path to the script, relative to the source directory
+			* @return (bool) Was the script ran succesfully?
+			*/
+			static bool Require(const engine::String& path);
+
+			/**
+			* @return (const snuffbox::engine::String&) The source directory scripts of this worker are loaded relative to, as it was when the worker was created
+			*/
+			const engine::String& src_directory() const;
+
+			/**
+			* @brief Terminates the worker, interrupting any script that is still running
+			* @remarks Blocks until the worker's isolate has been disposed
+			*/
+			void Terminate();
+
+			/**
+			* @brief Default destructor, terminates the worker
+			*/
+			~JSWorker();
+
+		protected:
+
+			/**
+			* @brief Serializes a value of the current state into a message
+			* @param[in] value (const v8::Local<v8::Value>&) The value to serialize
+			* @param[in] transfer (const v8::Local<v8::Value>&) An array of ArrayBuffers to transfer instead of copy
+			* @param[out] message (snuffbox::engine::JSWorker::Message*) The serialized message
+			* @return (bool) Was the serialization succesful? If not, an exception is pending in the current state
+			*/
+			static bool Serialize(const v8::Local<v8::Value>& value, const v8::Local<v8::Value>& transfer, Message* message);
+
+			/**
+			* @brief Deserializes a message into a value of the current state
+			* @param[in] message (snuffbox::engine::JSWorker::Message*) The message to deserialize, ownership of the transferred buffers is taken
+			* @param[out] value (v8::Local<v8::Value>*) The deserialized value
+			* @return (bool) Was the deserialization succesful?
+			*/
+			static bool Deserialize(Message* message, v8::Local<v8::Value>* value);
+
+			/**
+			* @brief Releases the memory of a message that was never delivered
+			* @param[in] message (snuffbox::engine::JSWorker::Message*) The message to release
+			*/
+			static void Release(Message* message);
+
+			/**
+			* @brief Schedules processing of the inbox on the thread pool, if it wasn't already
+			* @remarks The mutex should be locked before calling this
+			*/
+			void Schedule();
+
+			/**
+			* @brief Processes the worker on a thread pool thread; starts the state, handles the inbox and disposes the state once terminated
+			*/
+			void Process();
+
+			/**
+			* @brief Creates the worker's state and runs its script
+			* @remarks The script is not ran if the worker was terminated before its state was published, as Terminate could not interrupt it then
+			* @return (bool) Was the script ran succesfully?
+			*/
+			bool Start();
+
+			/**
+			* @brief Shuts the worker's state down
+			*/
+			void Stop();
+
+			/**
+			* @brief Delivers all messages in the outbox to the main state callback
+			*/
+			void Deliver();
+
+		private:
+
+			engine::String path_; //!< The path to the worker's script
+			engine::String src_directory_; //!< The source directory scripts are loaded relative to
+			ThreadPool* thread_pool_; //!< The thread pool to process the worker on
+
+			JSStateWrapper* state_; //!< The worker's own JavaScript state
+			JSCallback<v8::Local<v8::Value>>* on_message_; //!< The worker's global 'onMessage' callback, which lives in the worker's state
+			UniquePtr<JSCallback<v8::Local<v8::Value>>> callback_; //!< The main state callback that receives the worker's messages
+
+			Queue<Message> inbox_; //!< The messages posted to the worker
+			Queue<Message> outbox_; //!< The messages posted by the worker
+
+			std::mutex mutex_; //!< The mutex that guards the queues and the flags
+			std::condition_variable condition_; //!< Signaled when the worker stops processing
+			bool scheduled_; //!< Is the worker scheduled or being processed on the thread pool?
+			bool terminated_; //!< Was the worker terminated?
+			bool disposed_; //!< Was the worker's state disposed?
+
+			static Vector<JSWorker*> workers_; //!< The workers that are alive, only accessed from the main thread
+
+		public:
+
+			JS_NAME(Worker);
+			JS_REGISTER_DECL_TMPL;
+			JSWorker(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+			JS_FUNCTION_DECL(post);
+			JS_FUNCTION_DECL(onMessage);
+			JS_FUNCTION_DECL(terminate);
+
+			JS_FUNCTION_DECL(postMessage);
+		};
+	}
+}
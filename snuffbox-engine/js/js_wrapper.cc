@@ -105,6 +105,42 @@ namespace snuffbox
 			return t->NewInstance(wrapper->Context()).ToLocalChecked();
 		}
 
+		//-----------------------------------------------------------------------------------------------
+		Local<ArrayBuffer> JSWrapper::CreateArrayBuffer(void* data, size_t size, const Local<v8::Object>& owner)
+		{
+			JSStateWrapper* wrapper = JSStateWrapper::Instance();
+			Isolate* isolate = wrapper->isolate();
+
+			Local<ArrayBuffer> buffer = ArrayBuffer::New(isolate, data, size, ArrayBufferCreationMode::kExternalized);
+			buffer->SetPrivate(wrapper->Context(),
+				v8::Private::ForApi(isolate, CreateString("__owner")),
+				owner);
+
+			return buffer;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		unsigned char* JSWrapper::GetBuffer(int arg, size_t* size)
+		{
+			Local<Value> value = args_[arg];
+
+			if (value->IsArrayBufferView() == true)
+			{
+				Local<ArrayBufferView> view = value.As<ArrayBufferView>();
+				*size = view->ByteLength();
+				return static_cast<unsigned char*>(view->Buffer()->GetContents().Data()) + view->ByteOffset();
+			}
+			else if (value->IsArrayBuffer() == true)
+			{
+				ArrayBuffer::Contents contents = value.As<ArrayBuffer>()->GetContents();
+				*size = contents.ByteLength();
+				return static_cast<unsigned char*>(contents.Data());
+			}
+
+			*size = 0;
+			return nullptr;
+		}
+
 		//-----------------------------------------------------------------------------------------------
 		void JSWrapper::SetPointer(const v8::Local<v8::Object>& obj, void* ptr)
 		{
@@ -129,68 +165,6 @@ namespace snuffbox
 			SetObjectValue<v8::Local<v8::Value>>(wrapper->Namespace(), name, val);
 		}
 
-		//-----------------------------------------------------------------------------------------------
-		bool JSWrapper::Check(const char* format, bool force)
-		{
-#ifdef SNUFF_RELEASE
-			if (force == false)
-			{
-				return true;
-			}
-#endif
-			size_t len = strlen(format);
-			if (len == 0)
-			{
-				return true;
-			}
-
-			char f = 'V';
-			Types expected, got;
-			for (unsigned int i = 0; i < static_cast<unsigned int>(len); ++i)
-			{
-				f = tolower(format[i]);
-
-				switch (f)
-				{
-				case 'v':
-					expected = Types::kVoid;
-					break;
-				case 'n':
-					expected = Types::kNumber;
-					break;
-				case 'b':
-					expected = Types::kBoolean;
-					break;
-				case 's':
-					expected = Types::kString;
-					break;
-				case 'o':
-					expected = Types::kObject;
-					break;
-				case 'a':
-					expected = Types::kArray;
-					break;
-				case 'f':
-					expected = Types::kFunction;
-					break;
-				}
-
-				if (expected == Types::kVoid)
-				{
-					return true;
-				}
-
-				got = TypeOf(args_[i]);
-				if (got != expected)
-				{
-					Error(expected, got, i);
-					return false;
-				}
-			}
-
-			return true;
-		}
-
 		//-----------------------------------------------------------------------------------------------
 		void JSWrapper::Error(Types expected, Types got, int arg)
 		{
@@ -210,6 +184,12 @@ namespace snuffbox
 				std::to_string(arg + 1).c_str());
 		}
 
+		//-----------------------------------------------------------------------------------------------
+		JSWrapper::Types JSWrapper::ArgumentType(int arg) const
+		{
+			return TypeOf(args_[arg]);
+		}
+
 		//-----------------------------------------------------------------------------------------------
 		void JSWrapper::set_error_checks(bool value)
 		{
@@ -37,6 +37,9 @@ namespace snuffbox
 
 			typedef v8::Local<v8::Object> Object;
 
+			template <Types T, Types... Rest>
+			friend struct JSSignature;
+
 		public:
 
 			/**
@@ -130,6 +133,24 @@ namespace snuffbox
 			*/
 			static v8::Local<v8::Object> CreateObject();
 
+			/**
+			* @brief Creates an ArrayBuffer that is backed by native memory, without copying it
+			* @param[in] data (void*) The native memory to expose
+			* @param[in] size (size_t) The size of the native memory in bytes
+			* @param[in] owner (const v8::Local<v8::Object>&) The object owning the memory, kept alive for as long as the buffer is
+			* @remarks The buffer is externalized; the owner is responsible for neutering it before the memory is freed
+			* @return (v8::Local<v8::ArrayBuffer>) The created ArrayBuffer
+			*/
+			static v8::Local<v8::ArrayBuffer> CreateArrayBuffer(void* data, size_t size, const v8::Local<v8::Object>& owner);
+
+			/**
+			* @brief Retrieves the native memory of an ArrayBuffer or typed array argument, without copying it
+			* @param[in] arg (int) The argument to retrieve the memory of
+			* @param[out] size (size_t*) The size of the memory in bytes
+			* @return (unsigned char*) The memory, nullptr if the argument was not a buffer
+			*/
+			unsigned char* GetBuffer(int arg, size_t* size);
+
 			/**
 			* @brief Sets the private __ptr field of an object to a C++ pointer
 			* @param[in] obj (const v8::Local<v8::Object>&) The object to assign the pointer to
@@ -162,13 +183,20 @@ namespace snuffbox
 			void Error(Types expected, Types got, int arg);
 
 			/**
-			* @brief Checks the argument scope if the format is as it should be
-			* @param[in] format (const char*) The format to check
+			* @brief Checks the argument scope against a statically declared signature
 			* @param[in] force (bool) Should this check be enforced, even in Release mode? Default = true
-			* @remarks e.g. B = Boolean, N = Number, concat the values like so; 'BN' in order of arguments
-			* @return (bool) Was the format check completed succesfully?
+			* @remarks e.g. Check<JSWrapper::kString, JSWrapper::kNumber>() for a (string, number) signature
+			* @return (bool) Was the signature check completed succesfully?
+			*/
+			template <Types... T>
+			bool Check(bool force = true);
+
+			/**
+			* @brief Retrieves the type of an argument, used to resolve overloaded signatures with a single switch
+			* @param[in] arg (int) The argument to retrieve the type of
+			* @return (snuffbox::engine::JSWrapper::Types) The type of the argument
 			*/
-			bool Check(const char* format, bool force = true);
+			Types ArgumentType(int arg) const;
 
 			/**
 			* @brief Disables error checking in snuffbox::engine::JSWrapper::Check
@@ -188,6 +216,135 @@ namespace snuffbox
 			JSStateWrapper::IsolateLock lock_; //!< The isolate lock for the wrapper
 		};
 
+		/**
+		* @struct snuffbox::engine::JSTypeCheck
+		* @brief Compiles a single type of a signature down to a direct V8 type test
+		* @author Daniel Konings
+		*/
+		template <JSWrapper::Types T>
+		struct JSTypeCheck
+		{
+			/**
+			* @brief Checks if a value is of the type T
+			* @param[in] value (const v8::Local<v8::Value>&) The value to check
+			* @return (bool) Is the value of the type T?
+			*/
+			static bool Is(const v8::Local<v8::Value>& value);
+		};
+
+		//-------------------------------------------------------------------------------------------
+		template <>
+		inline bool JSTypeCheck<JSWrapper::kNumber>::Is(const v8::Local<v8::Value>& value)
+		{
+			return value->IsNumber();
+		}
+
+		//-------------------------------------------------------------------------------------------
+		template <>
+		inline bool JSTypeCheck<JSWrapper::kBoolean>::Is(const v8::Local<v8::Value>& value)
+		{
+			return value->IsBoolean();
+		}
+
+		//-------------------------------------------------------------------------------------------
+		template <>
+		inline bool JSTypeCheck<JSWrapper::kString>::Is(const v8::Local<v8::Value>& value)
+		{
+			return value->IsString();
+		}
+
+		//-------------------------------------------------------------------------------------------
+		template <>
+		inline bool JSTypeCheck<JSWrapper::kObject>::Is(const v8::Local<v8::Value>& value)
+		{
+			return value->IsObject() == true && value->IsArray() == false && value->IsFunction() == false;
+		}
+
+		//-------------------------------------------------------------------------------------------
+		template <>
+		inline bool JSTypeCheck<JSWrapper::kArray>::Is(const v8::Local<v8::Value>& value)
+		{
+			return value->IsArray();
+		}
+
+		//-------------------------------------------------------------------------------------------
+		template <>
+		inline bool JSTypeCheck<JSWrapper::kFunction>::Is(const v8::Local<v8::Value>& value)
+		{
+			return value->IsFunction();
+		}
+
+		//-------------------------------------------------------------------------------------------
+		template <>
+		inline bool JSTypeCheck<JSWrapper::kNull>::Is(const v8::Local<v8::Value>& value)
+		{
+			return value->IsNull();
+		}
+
+		//-------------------------------------------------------------------------------------------
+		template <>
+		inline bool JSTypeCheck<JSWrapper::kUndefined>::Is(const v8::Local<v8::Value>& value)
+		{
+			return value->IsUndefined();
+		}
+
+		/**
+		* @struct snuffbox::engine::JSSignature
+		* @brief Unrolls a statically declared signature into a sequence of argument type tests
+		* @author Daniel Konings
+		*/
+		template <JSWrapper::Types T, JSWrapper::Types... Rest>
+		struct JSSignature
+		{
+			/**
+			* @brief Checks the argument at 'arg' and recurses into the remaining signature
+			* @param[in] wrapper (snuffbox::engine::JSWrapper&) The wrapper containing the arguments
+			* @param[in] arg (int) The current argument
+			* @return (bool) Did the arguments match the signature?
+			*/
+			static bool Check(JSWrapper& wrapper, int arg)
+			{
+				const v8::Local<v8::Value> value = wrapper.args_[arg];
+				if (JSTypeCheck<T>::Is(value) == false)
+				{
+					wrapper.Error(T, JSWrapper::TypeOf(value), arg);
+					return false;
+				}
+
+				return JSSignature<Rest...>::Check(wrapper, arg + 1);
+			}
+		};
+
+		/**
+		* @struct snuffbox::engine::JSSignature
+		* @brief Terminates the signature, a signature ending in void accepts any remaining arguments
+		* @author Daniel Konings
+		*/
+		template <>
+		struct JSSignature<JSWrapper::kVoid>
+		{
+			/**
+			* @return (bool) Always true
+			*/
+			static bool Check(JSWrapper&, int)
+			{
+				return true;
+			}
+		};
+
+		//-------------------------------------------------------------------------------------------
+		template <JSWrapper::Types... T>
+		inline bool JSWrapper::Check(bool force)
+		{
+#ifdef SNUFF_RELEASE
+			if (force == false)
+			{
+				return true;
+			}
+#endif
+			return JSSignature<T..., kVoid>::Check(*this, 0);
+		}
+
 		//-------------------------------------------------------------------------------------------
 		template <>
 		inline bool JSWrapper::GetValue<bool>(int arg, const bool& def)
@@ -383,6 +540,22 @@ namespace snuffbox
             return str.ToLocalChecked();
 		}
 
+		//-------------------------------------------------------------------------------------------
+		template <>
+		inline v8::Local<v8::Value> JSWrapper::CastValue<Vector<engine::String>>(const Vector<engine::String>& val)
+		{
+			v8::Isolate* isolate = JSStateWrapper::Instance()->isolate();
+			v8::Local<v8::Context> ctx = isolate->GetCurrentContext();
+			v8::Local<v8::Array> arr = v8::Array::New(isolate, static_cast<int>(val.size()));
+
+			for (size_t i = 0; i < val.size(); ++i)
+			{
+				arr->Set(ctx, static_cast<uint32_t>(i), CreateString(val.at(i)));
+			}
+
+			return arr;
+		}
+
 		//-------------------------------------------------------------------------------------------
 		template <typename T>
 		inline void JSWrapper::ReturnValue(const T& val)
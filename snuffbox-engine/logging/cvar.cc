@@ -110,28 +110,29 @@ namespace snuffbox
 			CVarService& cvar = Services::Get<CVarService>();
 			LogService& log = Services::Get<LogService>();
 
-			if (wrapper.Check("S") == false)
+			if (wrapper.Check<JSWrapper::kString>() == false)
 			{
 				return;
 			}
 
 			String key = wrapper.GetValue<String>(0, "");
 
-			wrapper.set_error_checks(false);
-			if (wrapper.Check("SS") == true)
+			switch (wrapper.ArgumentType(1))
 			{
+			case JSWrapper::kString:
 				cvar.Set<CVarString>(key, wrapper.GetValue<String>(1, ""));
 				return;
-			}
-			else if (wrapper.Check("SB") == true)
-			{
+
+			case JSWrapper::kBoolean:
 				cvar.Set<CVarBoolean>(key, wrapper.GetValue<bool>(1, true));
 				return;
-			}
-			else if (wrapper.Check("SN") == true)
-			{
+
+			case JSWrapper::kNumber:
 				cvar.Set<CVarNumber>(key, wrapper.GetValue<float>(1, 0.0f));
 				return;
+
+			default:
+				break;
 			}
 
 			log.Log(console::LogSeverity::kError, "Could not find an appropriate CVar type for argument 2");
@@ -142,7 +143,7 @@ namespace snuffbox
 		{
 			JSWrapper wrapper(args);
 
-			if (wrapper.Check("S") == true)
+			if (wrapper.Check<JSWrapper::kString>() == true)
 			{
 				String name = wrapper.GetValue<String>(0, "");
 				CVarService& cvar = Services::Get<CVarService>();
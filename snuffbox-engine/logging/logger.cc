@@ -184,7 +184,7 @@ namespace snuffbox
 		JS_FUNCTION_IMPL(Logger, debug, JS_BODY(
 		{
 			JSWrapper wrapper(args);
-			if (wrapper.Check("S") == true)
+			if (wrapper.Check<JSWrapper::kString>() == true)
 			{
 				Services::Get<LogService>().Log(console::LogSeverity::kDebug, wrapper.GetValue<String>(0, ""));
 			}
@@ -194,7 +194,7 @@ namespace snuffbox
 		JS_FUNCTION_IMPL(Logger, info, JS_BODY(
 		{
 			JSWrapper wrapper(args);
-			if (wrapper.Check("S") == true)
+			if (wrapper.Check<JSWrapper::kString>() == true)
 			{
 				Services::Get<LogService>().Log(console::LogSeverity::kInfo, wrapper.GetValue<String>(0, ""));
 			}
@@ -204,7 +204,7 @@ namespace snuffbox
 		JS_FUNCTION_IMPL(Logger, success, JS_BODY(
 		{
 			JSWrapper wrapper(args);
-			if (wrapper.Check("S") == true)
+			if (wrapper.Check<JSWrapper::kString>() == true)
 			{
 				Services::Get<LogService>().Log(console::LogSeverity::kSuccess, wrapper.GetValue<String>(0, ""));
 			}
@@ -214,7 +214,7 @@ namespace snuffbox
 		JS_FUNCTION_IMPL(Logger, warning, JS_BODY(
 		{
 			JSWrapper wrapper(args);
-			if (wrapper.Check("S") == true)
+			if (wrapper.Check<JSWrapper::kString>() == true)
 			{
 				Services::Get<LogService>().Log(console::LogSeverity::kWarning, wrapper.GetValue<String>(0, ""));
 			}
@@ -224,7 +224,7 @@ namespace snuffbox
 		JS_FUNCTION_IMPL(Logger, error, JS_BODY(
 		{
 			JSWrapper wrapper(args);
-			if (wrapper.Check("S") == true)
+			if (wrapper.Check<JSWrapper::kString>() == true)
 			{
 				Services::Get<LogService>().Log(console::LogSeverity::kError, wrapper.GetValue<String>(0, ""));
 			}
@@ -234,7 +234,7 @@ namespace snuffbox
 		JS_FUNCTION_IMPL(Logger, fatal, JS_BODY(
 		{
 			JSWrapper wrapper(args);
-			if (wrapper.Check("S") == true)
+			if (wrapper.Check<JSWrapper::kString>() == true)
 			{
 				Services::Get<LogService>().Log(console::LogSeverity::kFatal, wrapper.GetValue<String>(0, ""));
 			}
@@ -244,7 +244,7 @@ namespace snuffbox
 		JS_FUNCTION_IMPL(Logger, rgb, JS_BODY(
 		{
 			JSWrapper wrapper(args);
-			if (wrapper.Check("S") == true)
+			if (wrapper.Check<JSWrapper::kString>() == true)
 			{
 				console::LogColour col;
 
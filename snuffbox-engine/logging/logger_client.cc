@@ -9,6 +9,7 @@
 #endif
 
 #include "../services/window_service.h"
+#include "../services/profiler_service.h"
 
 namespace snuffbox
 {
@@ -81,6 +82,10 @@ namespace snuffbox
 					"set <name> <value> - Sets a CVar by name",
 					"get <name> - Outputs a CVar by name",
 					"show_all - Outputs all currently registered CVars",
+					"heap_stats - Outputs the JavaScript heap statistics",
+					"gc_pauses - Outputs the most recent JavaScript garbage collection pauses",
+					"profile <frames> [file] - Profiles the scripts over a number of frames and writes collapsed stacks",
+					"profile_stop - Stops the running profile early and writes its results",
 					"clear - Clears the console window",
 					"quit - Closes the window and shuts down the application",
 					"exit - Closes the console",
@@ -103,6 +108,27 @@ namespace snuffbox
 				Services::Get<CVarService>().LogAll();
 				return;
 			}
+			else if (strcmp(message, "heap_stats") == 0)
+			{
+				LogHeapStats();
+				return;
+			}
+			else if (strcmp(message, "gc_pauses") == 0)
+			{
+				LogGCPauses();
+				return;
+			}
+			else if (strcmp(message, "profile_stop") == 0)
+			{
+				if (Services::Get<ProfilerService>().IsProfiling() == false)
+				{
+					QueueLog(console::LogSeverity::kWarning, "There is no profile running");
+					return;
+				}
+
+				Services::Get<ProfilerService>().Stop();
+				return;
+			}
 			else if (strcmp(message, "quit") == 0)
 			{
 				Services::Get<WindowService>().Close();
@@ -140,12 +166,79 @@ namespace snuffbox
 #endif
 		}
 
+		//-----------------------------------------------------------------------------------------------
+		void LoggerClient::LogHeapStats()
+		{
+#ifndef SNUFF_JAVASCRIPT
+			QueueLog(console::LogSeverity::kWarning, "JavaScript is disabled, there are no heap statistics");
+#else
+			JSStateWrapper* js = JSStateWrapper::Instance();
+
+			JSStateWrapper::HeapStats stats = js->GetHeapStats();
+			Vector<JSStateWrapper::HeapSpaceStats> spaces = js->GetHeapSpaceStats();
+
+			const float kb = 1.0f / 1024.0f;
+
+			QueueLog(console::LogSeverity::kInfo, "\n\nJavaScript heap:\n\tUsed: {0}kb\n\tTotal: {1}kb\n\tPhysical: {2}kb\n\tAvailable: {3}kb\n\tLimit: {4}kb\n\tMalloced: {5}kb (peak {6}kb)",
+				stats.used_heap_size * kb,
+				stats.total_heap_size * kb,
+				stats.total_physical_size * kb,
+				stats.total_available_size * kb,
+				stats.heap_size_limit * kb,
+				stats.malloced_memory * kb,
+				stats.peak_malloced_memory * kb);
+
+			QueueLog(console::LogSeverity::kInfo, "ArrayBuffers: {0}kb in {1} allocation(s) (peak {2}kb)",
+				stats.array_buffer_size * kb,
+				static_cast<unsigned int>(stats.array_buffer_count),
+				stats.array_buffer_peak * kb);
+
+			QueueLog(console::LogSeverity::kInfo, "Garbage collections: {0} taking {1}ms in total", stats.gc_count, stats.gc_time);
+
+			for (size_t i = 0; i < spaces.size(); ++i)
+			{
+				const JSStateWrapper::HeapSpaceStats& space = spaces.at(i);
+
+				QueueLog(console::LogSeverity::kInfo, "\t{0}: {1}kb used of {2}kb, {3}kb available",
+					space.name,
+					space.used_size * kb,
+					space.size * kb,
+					space.available_size * kb);
+			}
+#endif
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void LoggerClient::LogGCPauses()
+		{
+#ifndef SNUFF_JAVASCRIPT
+			QueueLog(console::LogSeverity::kWarning, "JavaScript is disabled, there are no garbage collection pauses");
+#else
+			Vector<JSStateWrapper::GCPause> pauses = JSStateWrapper::Instance()->GetGCPauses(static_cast<unsigned int>(-1));
+
+			if (pauses.empty() == true)
+			{
+				QueueLog(console::LogSeverity::kInfo, "No garbage collections have occurred yet");
+				return;
+			}
+
+			QueueLog(console::LogSeverity::kInfo, "\n\nMost recent garbage collection pauses:");
+
+			for (size_t i = 0; i < pauses.size(); ++i)
+			{
+				const JSStateWrapper::GCPause& pause = pauses.at(i);
+				QueueLog(console::LogSeverity::kInfo, "\t{0}s: {1} took {2}ms", pause.time, JSStateWrapper::GCTypeToString(pause.type), pause.duration);
+			}
+#endif
+		}
+
 		//-----------------------------------------------------------------------------------------------
 		bool LoggerClient::ParseCommand(const char* command)
 		{
 			String commands[] = {
 				"set",
-				"get"
+				"get",
+				"profile"
 			};
 
 			int num_commands = sizeof(commands) / sizeof(String);
@@ -288,6 +381,39 @@ namespace snuffbox
 
 				QueueLog(console::LogSeverity::kDebug, "CVar '{0}' is undefined", args);
 			}
+			else if (command == "profile")
+			{
+				String frames = "";
+				String path = "";
+				bool split = false;
+
+				for (int i = 0; i < strlen(args); ++i)
+				{
+					if (std::isspace(args[i]) != 0 && split == false)
+					{
+						split = true;
+						continue;
+					}
+
+					if (split == false)
+					{
+						frames += args[i];
+						continue;
+					}
+
+					path += args[i];
+				}
+
+				int count = atoi(frames.c_str());
+
+				if (count <= 0)
+				{
+					QueueLog(console::LogSeverity::kError, "Invalid syntax for command 'profile', usage: profile <frames> [file]");
+					return true;
+				}
+
+				Services::Get<ProfilerService>().Profile(static_cast<unsigned int>(count), path);
+			}
 
 			return true;
 		}
@@ -60,6 +60,16 @@ namespace snuffbox
 			*/
 			void OnJSCommand(const char* message);
 
+			/**
+			* @brief Logs the JavaScript heap statistics and the heap space breakdown
+			*/
+			void LogHeapStats();
+
+			/**
+			* @brief Logs the most recent JavaScript garbage collection pauses
+			*/
+			void LogGCPauses();
+
 			/**
 			* @brief Parses a specified command
 			* @param[in] command (const char*) The command to parse
@@ -22,16 +22,40 @@ namespace snuffbox
 			return ContentPtr<ContentBase>();
 		}
 
+		//-----------------------------------------------------------------------------------------------
+		ContentHandle ContentService::LoadContentAsync(const String& path, ContentBase::Types type, const ContentRequest::Callback& callback)
+		{
+			return ContentHandle();
+		}
+
 		//-----------------------------------------------------------------------------------------------
 		void ContentService::UnloadContent(const String& path, ContentBase::Types type, bool quiet)
 		{
 			
 		}
 
+		//-----------------------------------------------------------------------------------------------
+		unsigned int ContentService::Preload(const ContentManifest& manifest, const ContentManifest::Callback& progress)
+		{
+			return 0;
+		}
+
 		//-----------------------------------------------------------------------------------------------
 		void ContentService::UnloadAll()
 		{
 			
 		}
+
+		//-----------------------------------------------------------------------------------------------
+		void ContentService::Watch(const String& path)
+		{
+
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void ContentService::Depend(const String& path, const String& dependency)
+		{
+
+		}
 	}
 }
\ No newline at end of file
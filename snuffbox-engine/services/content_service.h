@@ -4,6 +4,8 @@
 #include "services.h"
 
 #include "../io/content.h"
+#include "../io/content_request.h"
+#include "../io/content_manifest.h"
 #include "../core/eastl.h"
 
 namespace snuffbox
@@ -44,6 +46,7 @@ namespace snuffbox
 			* @param[in] path (const String&) The path to retrieve the content from
 			* @param[in] quiet (bool) Should this call be quiet and not log anything?
 			* @return (snuffbox::engine::ContentPtr<T>) A pointer to the retrieved content, or nullptr if it doesn't exist
+			* @remarks Content that was evicted to stay within its budget is loaded again asynchronously and is null until it has loaded
 			*/
 			template <typename T>
 			ContentPtr<T> Get(const String& path, bool quiet = false);
@@ -57,6 +60,16 @@ namespace snuffbox
 			template <typename T>
 			ContentPtr<T> Load(const String& path, bool quiet = false);
 
+			/**
+			* @brief Starts loading a piece of content of type T from a path on the thread pool
+			* @param[in] path (const String&) The path to load the content from
+			* @param[in] callback (const snuffbox::engine::ContentRequest::Callback&) The callback to call on the main thread once the load is done, default = nullptr
+			* @return (snuffbox::engine::ContentHandle) The handle of the request, or nullptr for the null-service
+			* @remarks Loading content that is already loaded or already being loaded returns a request for the same content
+			*/
+			template <typename T>
+			ContentHandle LoadAsync(const String& path, const ContentRequest::Callback& callback = nullptr);
+
 			/**
 			* @brief Unloads a piece of content of type T from a path
 			* @param[in] path (const String&) The path to the already loaded content
@@ -65,11 +78,34 @@ namespace snuffbox
 			template <typename T>
 			void Unload(const String& path, bool quiet = false);
 
+			/**
+			* @brief Starts loading every entry of a manifest on the thread pool as a single batch
+			* @param[in] manifest (const snuffbox::engine::ContentManifest&) The manifest to preload
+			* @param[in] progress (const snuffbox::engine::ContentManifest::Callback&) The callback to call on the main thread every time an entry is done, default = nullptr
+			* @return (unsigned int) The number of entries that are being preloaded, 0 for the null-service
+			* @remarks The entries are read in the order they are laid out on disk, not the order they were added in
+			*/
+			virtual unsigned int Preload(const ContentManifest& manifest, const ContentManifest::Callback& progress = nullptr);
+
 			/**
 			* @brief Unload all content
 			*/
 			virtual void UnloadAll();
 
+			/**
+			* @brief Watches a file that is loaded outside of the content service, so that changes to it are reloaded
+			* @param[in] path (const String&) The path to the file to watch
+			*/
+			virtual void Watch(const String& path);
+
+			/**
+			* @brief Records that a file depends on another file, so that it is reloaded together with the file it depends on
+			* @param[in] path (const String&) The path to the dependent file
+			* @param[in] dependency (const String&) The path to the file it depends on
+			* @remarks Dependencies are followed transitively when reloading, this should only be called from the main thread
+			*/
+			virtual void Depend(const String& path, const String& dependency);
+
 		protected:
 
 			/**
@@ -84,6 +120,12 @@ namespace snuffbox
 			*/
 			virtual ContentPtr<ContentBase> LoadContent(const String& path, ContentBase::Types type, bool quiet);
 
+			/**
+			* @see snuffbox::ContentService::LoadAsync
+			* @remarks param[in] type will be deduced from template argument T
+			*/
+			virtual ContentHandle LoadContentAsync(const String& path, ContentBase::Types type, const ContentRequest::Callback& callback);
+
 			/**
 			* @see snuffbox::ContentService::Unload
 			* @remarks param[in] type will be deduced from template argument T
@@ -109,6 +151,14 @@ namespace snuffbox
 			return ContentPtr<T>(ptr);
 		}
 
+		//-----------------------------------------------------------------------------------------------
+		template <typename T>
+		inline ContentHandle ContentService::LoadAsync(const String& path, const ContentRequest::Callback& callback)
+		{
+			static_assert(is_content<T>::value, "Attempted to LoadAsync content of a non-content type T");
+			return LoadContentAsync(path, static_cast<ContentBase::Types>(T::CONTENT_ID), callback);
+		}
+
 		//-----------------------------------------------------------------------------------------------
 		template <typename T>
 		inline void ContentService::Unload(const String& path, bool quiet)
@@ -0,0 +1,31 @@
+#include "profiler_service.h"
+
+namespace snuffbox
+{
+	namespace engine
+	{
+		//-----------------------------------------------------------------------------------------------
+		ProfilerService::ProfilerService()
+		{
+
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void ProfilerService::Profile(unsigned int frames, const String& path)
+		{
+
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void ProfilerService::Stop()
+		{
+
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		bool ProfilerService::IsProfiling() const
+		{
+			return false;
+		}
+	}
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "service.h"
+#include "services.h"
+
+#include "../core/eastl.h"
+
+namespace snuffbox
+{
+	namespace engine
+	{
+		/**
+		* @class snuffbox::engine::ProfilerService : public snuffbox::engine::Service<snuffbox::engine::ServiceIDs::kProfilerService>
+		*/
+		class ProfilerService : public Service<ServiceIDs::kProfilerService>
+		{
+
+			friend class Services;
+
+		protected:
+
+			/**
+			* @brief Default constructor, creates a null service
+			*/
+			ProfilerService();
+
+			/**
+			* @brief Delete copy constructor
+			*/
+			ProfilerService(const ProfilerService& other) = delete;
+
+			/**
+			* @brief Delete assignment operator
+			*/
+			ProfilerService operator=(const ProfilerService& other) = delete;
+
+		public:
+
+			/**
+			* @brief Requests a profile of the scripts, which starts at the beginning of the next frame
+			* @param[in] frames (unsigned int) The number of frames to profile
+			* @param[in] path (const String&) The path to write the collapsed stacks to
+			* @remarks This can be called from any thread
+			*/
+			virtual void Profile(unsigned int frames, const String& path);
+
+			/**
+			* @brief Requests the running profile to stop early, the results are still written
+			* @remarks This can be called from any thread
+			*/
+			virtual void Stop();
+
+			/**
+			* @return (bool) Is a profile currently running?
+			*/
+			virtual bool IsProfiling() const;
+		};
+	}
+}
@@ -16,6 +16,7 @@ namespace snuffbox
 			kContentService, //!< The ID for the content service
 			kWindowService, //!< The ID for the window service
 			kInputService, //!< The ID for the input service
+			kProfilerService, //!< The ID for the script profiler service
 			kCount //!< The total number of different services
 		};
 
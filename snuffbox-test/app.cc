@@ -4,16 +4,24 @@
 
 #include <snuffbox-engine/services/log_service.h>
 #include <snuffbox-engine/services/cvar_service.h>
+#include <snuffbox-engine/services/content_service.h>
 
 #include <snuffbox-engine/io/file.h>
+#include <snuffbox-engine/io/script.h>
 #include <snuffbox-compilers/compilers/script_compiler.h>
 
+#include <string>
+#include <stdio.h>
+
 namespace snuffbox
 {
 	namespace test
 	{
 		//-----------------------------------------------------------------------------------------------
-		App::App()
+		App::App() :
+			preload_count_(0),
+			preload_frames_(0),
+			preload_timer_("Preload benchmark", false)
 		{
 			
 		}
@@ -21,13 +29,21 @@ namespace snuffbox
 		//-----------------------------------------------------------------------------------------------
 		void App::OnInit()
 		{
+			engine::CVarNumber* preload = engine::Services::Get<engine::CVarService>().Get<engine::CVarNumber>("preload_benchmark");
 
+			if (preload != nullptr && preload->value() >= 1.0f)
+			{
+				StartPreloadBenchmark(static_cast<unsigned int>(preload->value()));
+			}
 		}
 
 		//-----------------------------------------------------------------------------------------------
 		void App::OnUpdate(float dt)
 		{
-
+			if (preload_count_ > 0)
+			{
+				++preload_frames_;
+			}
 		}
 
 		//-----------------------------------------------------------------------------------------------
@@ -35,5 +51,101 @@ namespace snuffbox
 		{
 
 		}
+
+		//-----------------------------------------------------------------------------------------------
+		void App::StartPreloadBenchmark(unsigned int count)
+		{
+			engine::LogService& log = engine::Services::Get<engine::LogService>();
+			engine::ContentService& content = engine::Services::Get<engine::ContentService>();
+
+			engine::CVarString* src = engine::Services::Get<engine::CVarService>().Get<engine::CVarString>("src_directory");
+			engine::String directory = src == nullptr || src->value().size() == 0 ? "" : src->value() + "/";
+
+			compilers::ScriptCompiler compiler(
+				[](size_t size) { return engine::Memory::default_allocator().Malloc(size); },
+				[](void* ptr) { engine::Memory::default_allocator().Free(ptr); });
+
+			for (unsigned int i = 0; i < count; ++i)
+			{
+				std::string source = "var preload_benchmark_" + std::to_string(i) + " = " + std::to_string(i) + ";\n";
+
+				const unsigned char* output;
+				size_t size;
+
+				if (compiler.Compile(reinterpret_cast<const unsigned char*>(source.c_str()), source.size(), &size, &output, nullptr) == false)
+				{
+					log.Log(console::LogSeverity::kError, "Could not compile the preload benchmark scripts\n\t{0}", compiler.GetError());
+					return;
+				}
+
+				engine::File* file = engine::File::Open(directory + PreloadBenchmarkPath(i), engine::File::AccessFlags::kWrite | engine::File::AccessFlags::kBinary);
+				bool written = file->Write(output, size);
+				engine::File::Close(file);
+
+				if (written == false)
+				{
+					log.Log(console::LogSeverity::kError, "Could not write the preload benchmark scripts to '{0}'", directory);
+					return;
+				}
+			}
+
+			unsigned int loaded = 0;
+
+			engine::Timer serial("Serial load");
+			for (unsigned int i = 0; i < count; ++i)
+			{
+				loaded += content.Load<engine::Script>(PreloadBenchmarkPath(i), true).Get() != nullptr ? 1 : 0;
+			}
+			float serial_ms = serial.Stop();
+
+			log.Log(console::LogSeverity::kInfo, "Loaded {0} of {1} scripts one at a time in {2}ms", loaded, count, serial_ms);
+
+			engine::ContentManifest manifest;
+			for (unsigned int i = 0; i < count; ++i)
+			{
+				content.Unload<engine::Script>(PreloadBenchmarkPath(i), true);
+				manifest.Add(PreloadBenchmarkPath(i), engine::ContentBase::Types::kScript);
+			}
+
+			preload_count_ = count;
+			preload_frames_ = 0;
+			preload_timer_.Start();
+
+			content.Preload(manifest, [this](const engine::ContentManifest::Progress& progress)
+			{
+				if (progress.loaded + progress.failed == progress.total)
+				{
+					FinishPreloadBenchmark(progress);
+				}
+			});
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		void App::FinishPreloadBenchmark(const engine::ContentManifest::Progress& progress)
+		{
+			float preload_ms = preload_timer_.Stop();
+
+			engine::Services::Get<engine::LogService>().Log(console::LogSeverity::kInfo, "Preloaded {0} of {1} scripts in {2}ms, over {3} frame(s)",
+				progress.loaded, progress.total, preload_ms, preload_frames_);
+
+			engine::ContentService& content = engine::Services::Get<engine::ContentService>();
+
+			engine::CVarString* src = engine::Services::Get<engine::CVarService>().Get<engine::CVarString>("src_directory");
+			engine::String directory = src == nullptr || src->value().size() == 0 ? "" : src->value() + "/";
+
+			for (unsigned int i = 0; i < preload_count_; ++i)
+			{
+				content.Unload<engine::Script>(PreloadBenchmarkPath(i), true);
+				remove((directory + PreloadBenchmarkPath(i)).c_str());
+			}
+
+			preload_count_ = 0;
+		}
+
+		//-----------------------------------------------------------------------------------------------
+		engine::String App::PreloadBenchmarkPath(unsigned int index)
+		{
+			return engine::String("preload_benchmark_") + std::to_string(index).c_str() + ".js";
+		}
 	}
 }
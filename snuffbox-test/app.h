@@ -1,6 +1,8 @@
 #pragma once
 
 #include <snuffbox-engine/application/application.h>
+#include <snuffbox-engine/core/timer.h>
+#include <snuffbox-engine/io/content_manifest.h>
 #include <snuffbox-logging/logging_stream.h>
 
 namespace snuffbox
@@ -37,6 +39,32 @@ namespace snuffbox
 			* @see snuffbox::engine::Application::OnShutdown
 			*/
 			void OnShutdown() override;
+
+			/**
+			* @brief Writes small compiled scripts to the source directory and times loading them one at a time, then preloads them as a manifest
+			* @param[in] count (unsigned int) The number of scripts
+			* @remarks Started by the 'preload_benchmark' CVar, the preload finishes over the next frames within the 'load_budget'
+			*/
+			void StartPreloadBenchmark(unsigned int count);
+
+			/**
+			* @brief Logs how long the preload took and removes the generated scripts again
+			* @param[in] progress (const snuffbox::engine::ContentManifest::Progress&) The final progress of the preload
+			*/
+			void FinishPreloadBenchmark(const engine::ContentManifest::Progress& progress);
+
+			/**
+			* @brief Retrieves the path of a generated benchmark script
+			* @param[in] index (unsigned int) The index of the script
+			* @return (snuffbox::engine::String) The path, relative to the source directory
+			*/
+			static engine::String PreloadBenchmarkPath(unsigned int index);
+
+		private:
+
+			unsigned int preload_count_; //!< The number of scripts in the preload benchmark, 0 if it is not running
+			unsigned int preload_frames_; //!< The number of frames the preload has taken so far
+			engine::Timer preload_timer_; //!< Times the preload, from the call to Preload until the last script is loaded
 		};
 	}
 